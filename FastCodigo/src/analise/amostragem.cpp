@@ -0,0 +1,85 @@
+#include "../model/viab/amostragem.h"
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace model::viab {
+
+long long TotalCaminhos::saturado() const {
+    constexpr long long maximo = std::numeric_limits<long long>::max();
+    if (excede_128 || exato > static_cast<Contagem128>(maximo)) return maximo;
+    return static_cast<long long>(exato);
+}
+
+double TotalCaminhos::aproximado() const {
+    return excede_128 ? std::pow(10.0, log10) : static_cast<double>(exato);
+}
+
+std::string TotalCaminhos::decimal() const {
+    if (!excede_128) return texto();
+    std::ostringstream o;
+    o.precision(6);
+    o << aproximado();
+    return o.str();
+}
+
+std::string TotalCaminhos::texto() const {
+    if (excede_128) {
+        std::ostringstream o;
+        o << "~1e" << static_cast<long long>(std::floor(log10));
+        return o.str();
+    }
+    std::string s;
+    Contagem128 v = exato;
+    do {
+        s.insert(s.begin(), static_cast<char>('0' + static_cast<int>(v % 10)));
+        v /= 10;
+    } while (v > 0);
+    return s;
+}
+
+TotalCaminhos contar_caminhos(const std::vector<Fase>& fases) {
+    TotalCaminhos t;
+    const Contagem128 maximo = ~static_cast<Contagem128>(0);
+    for (auto& f : fases) {
+        const auto op = static_cast<Contagem128>(f.durMax - f.durMin + 1);
+        t.log10 += std::log10(static_cast<double>(f.durMax - f.durMin + 1));
+        if (t.excede_128) continue;
+        if (t.exato > maximo / op) {
+            t.excede_128 = true;
+            continue;
+        }
+        t.exato *= op;
+    }
+    return t;
+}
+
+TotalCaminhos caminhos_exatos(Contagem128 total) {
+    TotalCaminhos t;
+    t.exato = total;
+    t.log10 = total > 0 ? std::log10(static_cast<double>(total)) : 0.0;
+    return t;
+}
+
+long long escalar_caminhos(double proporcao, const TotalCaminhos& total) {
+    constexpr long long maximo = std::numeric_limits<long long>::max();
+    if (proporcao <= 0.0) return 0;
+    // Acima de 128 bits o produto só existe em log-espaço
+    if (total.excede_128 && std::log10(proporcao) + total.log10 >= 19.0) return maximo;
+    const double viaveis = total.excede_128
+        ? std::pow(10.0, std::log10(proporcao) + total.log10)
+        : proporcao * static_cast<double>(total.exato);
+    if (viaveis >= static_cast<double>(maximo)) return maximo;
+    return static_cast<long long>(viaveis);
+}
+
+SorteadorDuracoes::SorteadorDuracoes(const std::vector<Fase>& fases) {
+    for (auto& f : fases) {
+        const auto faixa = static_cast<std::uint32_t>(f.durMax - f.durMin + 1);
+        base_.push_back(f.durMin);
+        faixa_.push_back(faixa);
+        limiar_.push_back(static_cast<std::uint32_t>(-faixa) % faixa);   // 2^32 mod faixa
+    }
+}
+
+} // namespace model::viab
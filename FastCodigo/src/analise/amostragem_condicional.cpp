@@ -0,0 +1,113 @@
+#include "../model/viab/amostragem_condicional.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace model::viab {
+
+std::vector<std::vector<int>> dias_completaveis(const std::vector<TabelaFase>& tabelas,
+                                                const std::vector<Fase>& fases, int n) {
+    const size_t P = fases.size();
+    std::vector<std::vector<int>> completaveis(P + 1, std::vector<int>(n + 2, 0));
+    for (int b = 0; b <= n; ++b) completaveis[P][b + 1] = b + 1;
+    for (size_t i = P; i-- > 0;) {
+        const Fase& f = fases[i];
+        const auto& seguinte = completaveis[i + 1];
+        auto& atual = completaveis[i];
+        for (int a = 0; a <= n; ++a) {
+            const int lo = a + f.durMin;
+            const int hi = std::min({a + f.durMax, tabelas[i].proximo_inviavel[a], n});
+            const bool ok = lo <= hi && seguinte[hi + 1] - seguinte[lo] > 0;
+            atual[a + 1] = atual[a] + ok;
+        }
+    }
+    return completaveis;
+}
+
+ResultadoCondicional amostrar_dia_condicional(const std::vector<TabelaFase>& tabelas,
+                                              const std::vector<Fase>& fases,
+                                              const std::vector<std::vector<int>>& completaveis,
+                                              int n, int inicio, long long amostras,
+                                              std::uint64_t semente) {
+    const PlanoAnalise plano = planejar_analise(fases);
+    ResultadoCondicional out;
+    out.base.total_caminhos = plano.caminhos;
+    if (completaveis[0][inicio + 1] - completaveis[0][inicio] == 0) return out;
+
+    const int P = static_cast<int>(fases.size());
+    std::mt19937_64 gen(semente);
+    double soma_w = 0.0, soma_w2 = 0.0, soma_rend = 0.0, soma_ideal = 0.0, soma_esb = 0.0, soma_red = 0.0;
+    for (long long s = 0; s < amostras; ++s) {
+        double w = 1.0, pen = 0.0;
+        bool ideal = true, esb = false, red = false;
+        int pos = inicio;
+        for (int i = 0; i < P; ++i) {
+            const Fase& f = fases[i];
+            const TabelaFase& t = tabelas[i];
+            const auto& seguinte = completaveis[i + 1];
+            const int lo = pos + f.durMin;
+            const int hi = std::min({pos + f.durMax, t.proximo_inviavel[pos], n});
+            // pos é completável, então há k >= 1 términos válidos em [lo, hi]
+            const int k = seguinte[hi + 1] - seguinte[lo];
+            w *= static_cast<double>(k) / (f.durMax - f.durMin + 1);
+            // r-ésimo término válido: primeiro b com seguinte[b + 1] - seguinte[lo] > r
+            const int r = static_cast<int>(std::uniform_int_distribution<int>(0, k - 1)(gen));
+            const int fim = static_cast<int>(
+                std::upper_bound(seguinte.begin() + lo + 1, seguinte.begin() + hi + 2, seguinte[lo] + r) -
+                seguinte.begin()) - 1;
+            pen += t.penalidade[fim] - t.penalidade[pos];
+            ideal = ideal && t.nao_ideais[fim] == t.nao_ideais[pos];
+            esb = esb || t.esbranq[fim] != t.esbranq[pos];
+            red = red || t.reducao[fim] != t.reducao[pos];
+            pos = fim;
+        }
+        soma_w += w;
+        soma_w2 += w * w;
+        soma_rend += w * std::max(0.0, 1.0 - pen / (pos - inicio));
+        soma_ideal += ideal ? w : 0.0;
+        soma_esb += esb ? w : 0.0;
+        soma_red += red ? w : 0.0;
+    }
+
+    const double N = static_cast<double>(amostras);
+    const double p = soma_w / N;
+    auto& b = out.base;
+    b.prob_viabilidade     = p;
+    b.caminhos_viaveis     = escalar_caminhos(p, plano.caminhos);
+    b.rendimento_medio     = soma_rend / soma_w;
+    b.prob_optimo          = soma_ideal / N;
+    b.prob_esbranquiamento = soma_esb / soma_w;
+    b.prob_reducao_moagem  = soma_red / soma_w;
+    out.erro_padrao = std::sqrt(std::max(0.0, soma_w2 / N - p * p) / (N - 1.0));
+    out.amostras_efetivas = soma_w * soma_w / soma_w2;
+    return out;
+}
+
+std::vector<ResultadoCondicional> rodar_analise_condicional(const std::vector<Dia>& dias,
+                                                            const std::vector<Fase>& fases,
+                                                            long long amostras,
+                                                            std::uint64_t semente) {
+    if (amostras < 2)
+        throw std::invalid_argument("Amostras condicionais devem ser >= 2: " + std::to_string(amostras));
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+    const int n = static_cast<int>(dias.size());
+    std::vector<ResultadoCondicional> resultados(n);
+    if (n == 0 || fases.empty()) return resultados;
+
+    const PlanoAnalise plano = planejar_analise(fases);
+    const auto tabelas = construir_tabelas(dias, fases);
+    const auto completaveis = dias_completaveis(tabelas, fases, n);
+    paralelo_para(0, n - plano.dias_min + 1, [&](int d) {
+        resultados[d] = amostrar_dia_condicional(tabelas, fases, completaveis, n, d, amostras,
+                                                 semente_dia(semente, static_cast<std::uint64_t>(d)));
+        resultados[d].base.data_str = dias[d].data_str;
+    });
+    return resultados;
+}
+
+} // namespace model::viab
@@ -0,0 +1,138 @@
+#include "../model/viab/analise_gdd.h"
+#include "../model/viab/enumeracao.h"
+#include "../model/viab/pool_trabalho.h"
+#include "../model/viab/tabela_fases.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace model::viab {
+
+double graus_dia(const Dia& dia, double tBase) {
+    return std::max(0.0, (dia.tmax + dia.tmin) / 2.0 - tBase);
+}
+
+std::vector<double> acumular_graus_dia(const std::vector<Dia>& dias, double tBase) {
+    std::vector<double> acumulado(dias.size() + 1, 0.0);
+    for (size_t d = 0; d < dias.size(); ++d)
+        acumulado[d + 1] = acumulado[d] + graus_dia(dias[d], tBase);
+    return acumulado;
+}
+
+std::pair<int, int> faixa_graus_dia(const std::vector<double>& acumulado, int inicio,
+                                    const Fase& fase) {
+    const int n = static_cast<int>(acumulado.size()) - 1;
+    const double base = acumulado[inicio];
+    // Primeiro fim e > inicio com acumulado[e] - base >= alvo (busca binária: acumulado é monótono)
+    auto primeiro_fim = [&](double alvo) {
+        auto it = std::lower_bound(acumulado.begin() + inicio + 1, acumulado.end(), base + alvo);
+        return static_cast<int>(it - acumulado.begin());
+    };
+    const int fim_min = primeiro_fim(fase.gddAlvo - fase.gddTolerancia);
+    if (fim_min > n) return {1, 0};
+    const int fim_max = std::min(primeiro_fim(fase.gddAlvo + fase.gddTolerancia), n);
+    return {fim_min - inicio, fim_max - inicio};
+}
+
+namespace {
+
+struct EstadoGdd {
+    bool viavel = true;
+    bool ideal = true;
+    bool esb = false;
+    bool red = false;
+    double penalidade = 0.0;
+};
+
+} // namespace
+
+std::vector<ResultadoData> rodar_analise_gdd(const std::vector<Dia>& dias,
+                                             const std::vector<Fase>& fases) {
+    std::vector<ResultadoData> resultados;
+    const int n = static_cast<int>(dias.size());
+    const int P = static_cast<int>(fases.size());
+    if (n == 0 || P == 0) return resultados;
+    for (auto& f : fases) {
+        if (f.gddAlvo <= 0.0 && f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+        if (f.gddTolerancia < 0.0 || f.gddTolerancia > f.gddAlvo)
+            throw std::invalid_argument("Tolerância de GDD inválida em fase: " + f.nome);
+    }
+
+    if (std::none_of(fases.begin(), fases.end(), [](const Fase& f) { return f.gddAlvo > 0.0; }))
+        throw std::invalid_argument("Nenhuma fase com alvo de graus-dia ('gdd') no JSON");
+
+    const auto tabelas = construir_tabelas(dias, fases);
+    std::vector<std::vector<double>> acumulados(P);
+    for (int i = 0; i < P; ++i)
+        if (fases[i].gddAlvo > 0.0) acumulados[i] = acumular_graus_dia(dias, fases[i].tBase);
+
+    // Caminhos abaixo de cada fase: faixas fixas das fases seguintes (fase por GDD = um caminho)
+    std::vector<long long> cauda(P, 1);
+    for (int i = P - 2; i >= 0; --i)
+        cauda[i] = cauda[i + 1] *
+                   (fases[i + 1].gddAlvo > 0.0 ? 1 : fases[i + 1].durMax - fases[i + 1].durMin + 1);
+
+    std::cout << "Iniciando análise por graus-dia de " << n << " dias" << std::endl;
+    auto inicio_analise = std::chrono::high_resolution_clock::now();
+
+    resultados.resize(n);
+    paralelo_para(0, n, [&](int dia0) {
+        long long total = 0, viaveis = 0, optimos = 0, esb = 0, red = 0;
+        double soma_rend = 0.0;
+
+        // Durações que passam do fim da série são inviáveis e entram no total, com
+        // os caminhos das fases seguintes, como em avaliar_sequencia; alvo de GDD
+        // não atingido conta como uma duração
+        auto faixa = [&](int i, int a) {
+            if (fases[i].gddAlvo > 0.0) {
+                const auto f = faixa_graus_dia(acumulados[i], a, fases[i]);
+                if (f.first > f.second) total += cauda[i];
+                return f;
+            }
+            const int cortadas = fases[i].durMax - std::max(fases[i].durMin - 1, n - a);
+            if (cortadas > 0) total += cortadas * cauda[i];
+            return std::make_pair(fases[i].durMin, std::min(fases[i].durMax, n - a));
+        };
+        // Sem poda: todos os caminhos da banda entram no total
+        auto estender = [&](int i, int a, int b, const EstadoGdd& ant, EstadoGdd& novo) {
+            const auto& t = tabelas[i];
+            novo.viavel = ant.viavel && t.inviaveis[b] == t.inviaveis[a];
+            novo.ideal = ant.ideal && t.nao_ideais[b] == t.nao_ideais[a];
+            novo.esb = ant.esb || t.esbranq[b] != t.esbranq[a];
+            novo.red = ant.red || t.reducao[b] != t.reducao[a];
+            novo.penalidade = ant.penalidade + (t.penalidade[b] - t.penalidade[a]);
+            return true;
+        };
+        auto folha = [&](const int* limites, const EstadoGdd& e) {
+            total++;
+            if (!e.viavel) return;
+            viaveis++;
+            soma_rend += std::max(0.0, 1.0 - e.penalidade / (limites[P] - limites[0]));
+            optimos += e.ideal;
+            esb += e.esb;
+            red += e.red;
+        };
+        enumerar_caminhos_faixas(P, n, dia0, EstadoGdd{}, faixa, estender, folha);
+
+        auto& out = resultados[dia0];
+        out.data_str         = dias[dia0].data_str;
+        out.total_caminhos   = caminhos_exatos(total);
+        out.caminhos_viaveis = viaveis;
+        if (viaveis > 0) {
+            out.prob_viabilidade     = static_cast<double>(viaveis) / total;
+            out.rendimento_medio     = soma_rend / viaveis;
+            out.prob_optimo          = static_cast<double>(optimos) / total;
+            out.prob_esbranquiamento = static_cast<double>(esb) / viaveis;
+            out.prob_reducao_moagem  = static_cast<double>(red) / viaveis;
+        }
+    });
+
+    auto fim_analise = std::chrono::high_resolution_clock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(fim_analise - inicio_analise).count();
+    std::cout << "Análise por graus-dia concluída em " << ms << " ms." << std::endl;
+    return resultados;
+}
+
+} // namespace model::viab
@@ -0,0 +1,228 @@
+#include "../model/viab/analise_horaria.h"
+#include "../model/viab/enumeracao.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include "../model/viab/tabela_fases.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace model::viab {
+
+SerieHoraria montar_serie_horaria(const std::vector<RegistroHorario>& registros) {
+    const AnalysisConfig cfg;
+    const size_t n = registros.size();
+
+    // Âncoras (hora absoluta, temperatura) em ordem cronológica
+    std::vector<std::pair<long, double>> ancoras;
+    for (size_t k = 0; k < n; ++k) {
+        const auto& r = registros[k];
+        std::vector<std::pair<int, double>> dia(r.leituras);
+        if (r.tmax_diaria) dia.emplace_back(cfg.HORA_TMAX_UTC, *r.tmax_diaria);
+        if (r.tmin_diaria) dia.emplace_back(cfg.HORA_TMIN_UTC, *r.tmin_diaria);
+        std::stable_sort(dia.begin(), dia.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [hora, temp] : dia) {
+            long t = static_cast<long>(k) * 24 + hora;
+            // Extremo diário prevalece sobre a leitura da mesma hora
+            if (!ancoras.empty() && ancoras.back().first == t)
+                ancoras.back().second = temp;
+            else
+                ancoras.emplace_back(t, temp);
+        }
+    }
+    if (ancoras.empty())
+        throw std::runtime_error("Nenhuma temperatura válida nos dados horários");
+
+    SerieHoraria serie;
+    serie.temperaturas.resize(n * 24);
+    size_t j = 0;
+    for (long t = 0; t < static_cast<long>(n * 24); ++t) {
+        while (j + 1 < ancoras.size() && ancoras[j + 1].first <= t) ++j;
+        double temp;
+        if (t <= ancoras.front().first) {
+            temp = ancoras.front().second;
+        } else if (j + 1 >= ancoras.size()) {
+            temp = ancoras.back().second;
+        } else {
+            const auto& [t0, v0] = ancoras[j];
+            const auto& [t1, v1] = ancoras[j + 1];
+            temp = v0 + (v1 - v0) * static_cast<double>(t - t0) / static_cast<double>(t1 - t0);
+        }
+        serie.temperaturas[t] = temp;
+    }
+
+    serie.dias.reserve(n);
+    for (size_t k = 0; k < n; ++k) {
+        auto ini = serie.temperaturas.begin() + static_cast<long>(k * 24);
+        auto [mn, mx] = std::minmax_element(ini, ini + 24);
+        serie.dias.push_back(Dia{registros[k].data_str, registros[k].mes, *mx, *mn});
+    }
+    return serie;
+}
+
+std::vector<TabelaGrausHora> construir_tabelas_graus_hora(const SerieHoraria& serie,
+                                                           const std::vector<Fase>& fases) {
+    const size_t n = serie.dias.size();
+    std::vector<TabelaGrausHora> tabelas(fases.size());
+    for (size_t f = 0; f < fases.size(); ++f) {
+        auto& t = tabelas[f];
+        t.calor.assign(n + 1, 0.0);
+        t.frio.assign(n + 1, 0.0);
+        double calor = 0.0, frio = 0.0;
+        for (size_t d = 0; d < n; ++d) {
+            for (size_t h = d * 24; h < (d + 1) * 24; ++h) {
+                double temp = serie.temperaturas[h];
+                calor += std::max(0.0, temp - fases[f].maxT);
+                frio  += std::max(0.0, fases[f].minT - temp);
+            }
+            t.calor[d + 1] = calor;
+            t.frio[d + 1] = frio;
+        }
+    }
+    return tabelas;
+}
+
+namespace {
+
+struct EstadoHorario {
+    double penalidade = 0.0;
+    bool ideal = true;
+    bool esb = false;
+    bool red = false;
+};
+
+// Acumuladores de um dia inicial
+struct ContagemHoraria {
+    long long amostras = 0;
+    long long viaveis = 0;
+    long long optimos = 0;
+    long long esb = 0;
+    long long red = 0;
+    double soma_rend = 0.0;
+    std::vector<double> soma_calor;
+    std::vector<double> soma_frio;
+};
+
+} // namespace
+
+std::vector<ResultadoHorario> rodar_analise_horaria(const SerieHoraria& serie,
+                                                    const std::vector<Fase>& fases,
+                                                    std::uint64_t semente) {
+    std::vector<ResultadoHorario> resultados;
+    const auto& dias = serie.dias;
+    const int n = static_cast<int>(dias.size());
+    const int P = static_cast<int>(fases.size());
+    if (n == 0 || P == 0) return resultados;
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+
+    // Ideal, penalidades e riscos independem de [minT, maxT] neste modo:
+    // a viabilidade vem dos graus-hora
+    std::vector<Fase> sem_limites(fases);
+    for (auto& f : sem_limites) {
+        f.minT = std::numeric_limits<double>::lowest();
+        f.maxT = std::numeric_limits<double>::max();
+    }
+    const auto tabelas = construir_tabelas(dias, sem_limites);
+    const auto graus_hora = construir_tabelas_graus_hora(serie, fases);
+
+    auto janela_viavel = [&](int i, int a, int b) {
+        const auto& g = graus_hora[i];
+        return (g.calor[b] - g.calor[a]) + (g.frio[b] - g.frio[a]) <= fases[i].toleranciaGH;
+    };
+    auto estender = [&](int i, int a, int b, const EstadoHorario& ant, EstadoHorario& novo) {
+        if (!janela_viavel(i, a, b)) return false;
+        const auto& t = tabelas[i];
+        novo.penalidade = ant.penalidade + (t.penalidade[b] - t.penalidade[a]);
+        novo.ideal = ant.ideal && t.nao_ideais[b] == t.nao_ideais[a];
+        novo.esb = ant.esb || t.esbranq[b] != t.esbranq[a];
+        novo.red = ant.red || t.reducao[b] != t.reducao[a];
+        return true;
+    };
+
+    // Mesma regra de modo do caminho genérico (contagem em 128 bits)
+    const PlanoAnalise plano = planejar_analise(fases);
+    const bool usar_amostragem = plano.usar_amostragem;
+    const long long amostras = plano.amostras;
+    const int dias_min = plano.dias_min;
+    const SorteadorDuracoes sorteador(fases);
+
+    std::cout << "Iniciando análise horária de " << n << " dias ("
+              << serie.temperaturas.size() << " horas) com "
+              << (usar_amostragem ? "amostragem" : "análise completa") << std::endl;
+    auto inicio_analise = std::chrono::high_resolution_clock::now();
+
+    ResultadoHorario vazio;
+    vazio.gh_calor.assign(P, 0.0);
+    vazio.gh_frio.assign(P, 0.0);
+    resultados.assign(n, vazio);
+    paralelo_para(0, n, [&](int dia0) {
+        if (n - dia0 < dias_min) return;
+
+        ContagemHoraria c;
+        c.soma_calor.assign(P, 0.0);
+        c.soma_frio.assign(P, 0.0);
+        auto folha = [&](const int* limites, const EstadoHorario& e) {
+            c.viaveis++;
+            c.soma_rend += std::max(0.0, 1.0 - e.penalidade / (limites[P] - limites[0]));
+            c.optimos += e.ideal;
+            c.esb += e.esb;
+            c.red += e.red;
+            for (int i = 0; i < P; ++i) {
+                const auto& g = graus_hora[i];
+                c.soma_calor[i] += g.calor[limites[i + 1]] - g.calor[limites[i]];
+                c.soma_frio[i]  += g.frio[limites[i + 1]] - g.frio[limites[i]];
+            }
+        };
+
+        if (usar_amostragem) {
+            // Durações uniformes e independentes por fase
+            std::mt19937_64 gen(semente_dia(semente, static_cast<std::uint64_t>(dia0)));
+            std::vector<int> limites(P + 1);
+            for (long long s = 0; s < amostras; ++s) {
+                c.amostras++;
+                EstadoHorario e;
+                limites[0] = dia0;
+                bool ok = true;
+                for (int i = 0; i < P && ok; ++i) {
+                    limites[i + 1] = limites[i] + sorteador.sortear(i, gen);
+                    ok = limites[i + 1] <= n && estender(i, limites[i], limites[i + 1], e, e);
+                }
+                if (ok) folha(limites.data(), e);
+            }
+        } else {
+            c.amostras = plano.total_combinacoes;
+            enumerar_caminhos(fases, n, dia0, EstadoHorario{}, estender, folha);
+        }
+
+        auto& out = resultados[dia0];
+        out.base.data_str = dias[dia0].data_str;
+        out.base.total_caminhos = plano.caminhos;
+        double proporcao = static_cast<double>(c.viaveis) / c.amostras;
+        out.base.caminhos_viaveis = usar_amostragem
+            ? escalar_caminhos(proporcao, plano.caminhos) : c.viaveis;
+        if (c.viaveis > 0) {
+            out.base.prob_viabilidade     = proporcao;
+            out.base.rendimento_medio     = c.soma_rend / c.viaveis;
+            out.base.prob_optimo          = static_cast<double>(c.optimos) / c.amostras;
+            out.base.prob_esbranquiamento = static_cast<double>(c.esb) / c.viaveis;
+            out.base.prob_reducao_moagem  = static_cast<double>(c.red) / c.viaveis;
+            for (int i = 0; i < P; ++i) {
+                out.gh_calor[i] = c.soma_calor[i] / c.viaveis;
+                out.gh_frio[i]  = c.soma_frio[i] / c.viaveis;
+            }
+        }
+    });
+
+    auto fim_analise = std::chrono::high_resolution_clock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(fim_analise - inicio_analise).count();
+    std::cout << "Análise horária concluída em " << ms << " ms." << std::endl;
+    return resultados;
+}
+
+} // namespace model::viab
@@ -1,28 +1,22 @@
 #include "../model/viab/analise_viabilidade.h"
+#include "../model/viab/analysis_config.h"
+#include "../model/viab/amostragem.h"
+#include "../model/viab/duracao_ponderada.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <random>
-#include <omp.h>
 #include <stdexcept>
 #include <limits>
 
 namespace model::viab {
 
-// Constantes e configurações para análise de viabilidade
-struct AnalysisConfig {
-    static constexpr long long LIMITE_COMBINACOES = 100000000;
-    static constexpr double TMAX_PEN_THR = 31.0;  // Limite para penalidade diurna
-    static constexpr double TMIN_PEN_THR = 21.0;  // Limite para penalidade noturna
-    static constexpr double ESBRANQ_THR   = 30.0;  // Limiar de esbranquiamento
-    static constexpr double RED_THR       = 27.0;  // Limiar de redução de moagem
-    static constexpr double PENAL_DIURNA  = 0.06;
-    static constexpr double PENAL_NOTURNA = 0.10;
-};
-
 // Verifica intervalo fechado [lo, hi]
 bool dentro(double x, double lo, double hi) {
     return x >= lo && x <= hi;
@@ -41,21 +35,10 @@ bool proxima_combinacao(std::vector<int>& duracoes, const std::vector<Fase>& fas
     return false;
 }
 
-// Estrutura para resultado diário detalhado
-struct ResultadoDia {
-    bool viavel           = false;
-    bool ideal            = false;
-    double rendimento     = 0.0;
-    bool risco_esbranq    = false;
-    bool risco_reducao    = false;
-    double penalidade_dia = 0.0;
-    double penalidade_noite = 0.0;
-};
-
 // Avalia um único dia para uma fase específica
-static ResultadoDia avaliar_dia(const Dia& dia,
-                                const Fase& fase,
-                                const AnalysisConfig& cfg) {
+ResultadoDia avaliar_dia(const Dia& dia,
+                         const Fase& fase,
+                         const AnalysisConfig& cfg) {
     ResultadoDia res;
     // 1. Viabilidade básica
     res.viavel = dentro(dia.tmax, fase.minT, fase.maxT) &&
@@ -98,7 +81,7 @@ static ResultadoData analisar_caso_simples(const Dia& dia,
                                           const Fase& fase) {
     ResultadoData out;
     out.data_str           = dia.data_str;
-    out.total_caminhos     = 1;
+    out.total_caminhos     = caminhos_exatos(1);
     auto res_dia = avaliar_dia(dia, fase, AnalysisConfig());
     out.caminhos_viaveis    = res_dia.viavel ? 1 : 0;
     out.prob_viabilidade   = res_dia.viavel ? 1.0 : 0.0;
@@ -118,16 +101,17 @@ static ResultadoData analisar_caso_simples(const Dia& dia,
 }
 
 // Avalia sequência completa de dias e fases
-static bool avaliar_sequencia(const std::vector<Dia>& dias,
-                              size_t inicio,
-                              const std::vector<Fase>& fases,
-                              const std::vector<int>& duracoes,
-                              const AnalysisConfig& cfg,
-                              double& penal_dia,
-                              double& penal_noite,
-                              bool& risco_esb,
-                              bool& risco_red,
-                              bool& seq_ideal) {
+bool avaliar_sequencia(const std::vector<Dia>& dias,
+                       size_t inicio,
+                       const std::vector<Fase>& fases,
+                       const std::vector<int>& duracoes,
+                       const AnalysisConfig& cfg,
+                       double& penal_dia,
+                       double& penal_noite,
+                       bool& risco_esb,
+                       bool& risco_red,
+                       bool& seq_ideal,
+                       FalhaCaminho* falha) {
     penal_dia = penal_noite = 0.0;
     risco_esb = risco_red = false;
     seq_ideal = true;
@@ -137,9 +121,18 @@ static bool avaliar_sequencia(const std::vector<Dia>& dias,
         const auto& fase = fases[i];
         for (int d = 0; d < duracoes[i]; ++d) {
             size_t idx = inicio + total_dias;
-            if (idx >= dias.size()) return false;
+            if (idx >= dias.size()) {
+                if (falha) *falha = {i, FalhaCaminho::FimSerie, total_dias};
+                return false;
+            }
             auto res = avaliar_dia(dias[idx], fase, cfg);
-            if (!res.viavel) return false;
+            if (!res.viavel) {
+                if (falha) {
+                    const bool acima = dias[idx].tmax > fase.maxT || dias[idx].tmin > fase.maxT;
+                    *falha = {i, acima ? FalhaCaminho::Maximo : FalhaCaminho::Minimo, total_dias};
+                }
+                return false;
+            }
             seq_ideal &= res.ideal;
             risco_esb |= res.risco_esbranq;
             risco_red |= res.risco_reducao;
@@ -169,7 +162,8 @@ void gerar_combinacao_por_indice(std::vector<int>& comb,
 
 // Função principal: executa análise para cada dia inicial
 std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias,
-                                         const std::vector<Fase>& fases) {
+                                         const std::vector<Fase>& fases,
+                                         std::vector<FalhasDia>* falhas) {
     std::vector<ResultadoData> resultados;
     size_t n = dias.size();
     if (n == 0 || fases.empty()) return resultados;
@@ -177,74 +171,79 @@ std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias,
     for (auto& f : fases)
         if (f.durMin > f.durMax)
             throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+    // Durações não uniformes: DP ponderada em vez de contagem de caminhos
+    if (tem_pesos(fases)) {
+        if (falhas) throw std::invalid_argument("Atribuição de falhas indisponível com durações ponderadas");
+        size_t descartados = 0;
+        auto resultados = rodar_analise_ponderada(dias, fases, 0, &descartados);
+        std::cout << "Pré-filtro: " << descartados << " de " << dias.size()
+                  << " dias iniciais sem caminho viável possível" << std::endl;
+        return resultados;
+    }
     
     // Caso simplificado: Um único dia e uma única fase
-    if (n == 1 && fases.size() == 1) {
+    if (n == 1 && fases.size() == 1 && !falhas) {
         resultados.push_back(analisar_caso_simples(dias[0], fases[0]));
         return resultados;
     }
     
-    // Calcula total de combinações e verifica se precisamos de amostragem
-    bool precisa_amostragem = false;
-    long long total_comb_real = 1;
-    
-    for (auto& f : fases) {
-        long long op = static_cast<long long>(f.durMax - f.durMin + 1);
-        
-        // Verificamos se excede o limite definido - ativa amostragem em vez de lançar erro
-        if (total_comb_real > AnalysisConfig::LIMITE_COMBINACOES / op) {
-            precisa_amostragem = true;
-            break;
-        }
-        
-        // Verificamos se haverá overflow no cálculo - ativa amostragem em vez de lançar erro
-        if (total_comb_real > std::numeric_limits<long long>::max() / op) {
-            precisa_amostragem = true;
-            break;
-        }
-        
-        total_comb_real *= op;
-    }
-    
-    // Se precisamos de amostragem, limita o número de combinações para algo gerenciável
-    if (precisa_amostragem) {
-        // Define um valor grande mas abaixo do limite para total_comb_real
-        total_comb_real = AnalysisConfig::LIMITE_COMBINACOES;
-    }
+    // Total de combinações em 128 bits (ou log10) e decisão de amostragem
+    const TotalCaminhos caminhos = contar_caminhos(fases);
+    const long long total_comb_real = caminhos.saturado();
     
-    // Define tamanho da amostra e modo de amostragem
-    bool usar_amostragem = precisa_amostragem || 
-                          (total_comb_real > AnalysisConfig::LIMITE_COMBINACOES / 10); // Ativamos amostragem quando chega a 10% do limite
+    // Ativamos amostragem quando chega a 10% do limite
+    bool usar_amostragem = caminhos.excede_128 ||
+        caminhos.exato > static_cast<Contagem128>(AnalysisConfig::LIMITE_COMBINACOES / 10);
     long long total_comb = usar_amostragem ? AnalysisConfig::LIMITE_COMBINACOES / 10 : total_comb_real;
     
-    // Inicializa gerador de números aleatórios se for usar amostragem
+    // Pré-filtro: dias sem nenhum caminho viável possível recebem zeros exatos.
+    // Só conta dias que cabem o ciclo mais curto, como os motores de tabelas
+    const int dias_n = static_cast<int>(n);
+    const auto tabelas = construir_tabelas(dias, fases);
+    std::vector<char> possivel(n, 0);
+    size_t descartados = 0;
+    int dias_ciclo = 0;
+    for (auto& f : fases) dias_ciclo += f.durMin;
+    for (int d = 0; d + dias_ciclo <= dias_n; ++d) {
+        possivel[d] = falhas || pode_ser_viavel(tabelas, fases, dias_n, d);
+        descartados += !possivel[d];
+    }
+
+    // Semente base; cada dia inicial deriva a sua (semente_dia), sem sobreposição de sequências
     std::random_device rd;
-    std::mt19937_64 gen(rd());
-    std::uniform_int_distribution<long long> distrib(0, total_comb_real - 1);
+    const std::uint64_t semente = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    const SorteadorDuracoes sorteador(fases);
     
     // Indicador de progresso
     std::cout << "Iniciando análise de " << n << " dias com " 
               << (usar_amostragem ? "amostragem" : "análise completa") << std::endl;
     if (usar_amostragem) {
-        std::cout << "Número total de combinações muito alto: " << total_comb_real 
+        std::cout << "Número total de combinações muito alto: " << caminhos.texto()
                   << " -> Usando " << total_comb << " amostras por dia" << std::endl;
     }
+    std::cout << "Pré-filtro: " << descartados << " de " << n
+              << " dias iniciais sem caminho viável possível" << std::endl;
     
     // Contadores atômicos para progresso
     std::atomic<size_t> dias_concluidos{0};
     auto inicio_analise = std::chrono::high_resolution_clock::now();
     
     resultados.resize(n);
-    #pragma omp parallel for schedule(dynamic)
-    for (size_t dia0 = 0; dia0 < n; ++dia0) {
-        // Inicializa gerador thread-local para paralelismo
-        std::mt19937_64 gen_local = gen;
-        gen_local.discard(dia0 * 1000); // Garante sequências diferentes por thread
-        
+    int alcance = 0;
+    for (auto& f : fases) alcance += f.durMax;
+    if (falhas) {
+        falhas->assign(n, FalhasDia{});
+        for (auto& f : *falhas) {
+            f.abaixo_min.assign(fases.size(), 0);
+            f.acima_max.assign(fases.size(), 0);
+        }
+    }
+    std::mutex progresso;
+    paralelo_para(n, [&](size_t dia0) {
         // pula se não há dias mínimos disponíveis
         int dias_min = 0;
         for (auto& f : fases) dias_min += f.durMin;
-        if (static_cast<int>(n - dia0) < dias_min) continue;
+        if (static_cast<int>(n - dia0) < dias_min) return;
         
         long long viaveis = 0;
         double sum_rend = 0.0;
@@ -253,21 +252,46 @@ std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias,
         
         // Define quantas avaliações serão feitas
         long long amostras_avaliadas = 0;
+
+        // Atribuição de falhas: contadores locais do dia, copiados ao final
+        FalhaCaminho falha;
+        FalhaCaminho* pfalha = falhas ? &falha : nullptr;
+        FalhasDia atrib;
+        std::vector<long long> por_deslocamento;
+        if (falhas) {
+            atrib = (*falhas)[dia0];
+            por_deslocamento.assign(alcance, 0);
+        }
+        auto registrar_falha = [&] {
+            if (!pfalha) return;
+            if (falha.limite == FalhaCaminho::FimSerie) {
+                ++atrib.fim_serie;
+                return;
+            }
+            ++(falha.limite == FalhaCaminho::Maximo ? atrib.acima_max : atrib.abaixo_min)[falha.fase];
+            ++por_deslocamento[falha.deslocamento];
+        };
         
         // Amostragem adaptativa (aleatória para muitos casos, exaustiva para poucos)
-        if (usar_amostragem) {
-            // Modo de amostragem aleatória
-            std::uniform_int_distribution<long long> distrib(0, total_comb_real - 1);
+        if (!possivel[dia0]) {
+            // Reprovado pelo pré-filtro: todas as avaliações seriam inviáveis
+            amostras_avaliadas = usar_amostragem ? total_comb : total_comb_real;
+        } else if (usar_amostragem) {
+            // Modo de amostragem aleatória: durações uniformes e independentes por fase
+            std::mt19937_64 gen_local(semente_dia(semente, dia0));
             for (long long i = 0; i < total_comb; ++i) {
-                long long idx = distrib(gen_local); // Índice aleatório
-                gerar_combinacao_por_indice(comb, fases, idx);
+                for (size_t f = 0; f < fases.size(); ++f)
+                    comb[f] = sorteador.sortear(f, gen_local);
                 double pd, pn;
                 bool r_esb, r_red, seq_id;
                 bool ok = avaliar_sequencia(dias, dia0, fases, comb,
                                           AnalysisConfig(), pd, pn,
-                                          r_esb, r_red, seq_id);
+                                          r_esb, r_red, seq_id, pfalha);
                 amostras_avaliadas++;
-                if (!ok) continue;
+                if (!ok) {
+                    registrar_falha();
+                    continue;
+                }
                 viaveis++;
                 double rend = std::max(0.0, 1.0 - (pd + pn));
                 sum_rend += rend;
@@ -283,9 +307,12 @@ std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias,
                 bool r_esb, r_red, seq_id;
                 bool ok = avaliar_sequencia(dias, dia0, fases, comb,
                                           AnalysisConfig(), pd, pn,
-                                          r_esb, r_red, seq_id);
+                                          r_esb, r_red, seq_id, pfalha);
                 amostras_avaliadas++;
-                if (!ok) continue;
+                if (!ok) {
+                    registrar_falha();
+                    continue;
+                }
                 viaveis++;
                 double rend = std::max(0.0, 1.0 - (pd + pn));
                 sum_rend += rend;
@@ -301,8 +328,8 @@ std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias,
             auto agora = std::chrono::high_resolution_clock::now();
             auto duracao = std::chrono::duration_cast<std::chrono::seconds>(agora - inicio_analise).count();
             
-            #pragma omp critical
             {
+                std::lock_guard<std::mutex> l(progresso);
                 double porcentagem = (100.0 * concluidos) / n;
                 std::cout << "\rProgresso: " << concluidos << "/" << n 
                           << " dias (" << std::fixed << std::setprecision(1) << porcentagem << "%)";
@@ -326,15 +353,25 @@ std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias,
             }
         }
         
+        if (falhas) {
+            for (int k = 0; k < alcance; ++k) {
+                if (por_deslocamento[k] > atrib.falhas_moda) {
+                    atrib.falhas_moda = por_deslocamento[k];
+                    atrib.deslocamento_moda = k;
+                }
+            }
+            (*falhas)[dia0] = std::move(atrib);
+        }
+
         auto& out = resultados[dia0];
         out.data_str        = dias[dia0].data_str;
-        out.total_caminhos  = total_comb_real; // Mostra total real, não amostrado
+        out.total_caminhos  = caminhos; // Mostra total real, não amostrado
         
         // Ajusta os resultados com base no modo de amostragem
         if (usar_amostragem && amostras_avaliadas > 0) {
             // Estimativa de caminhos viáveis baseada na proporção da amostra
             double proporcao_viaveis = static_cast<double>(viaveis) / amostras_avaliadas;
-            out.caminhos_viaveis = static_cast<long long>(proporcao_viaveis * total_comb_real);
+            out.caminhos_viaveis = escalar_caminhos(proporcao_viaveis, caminhos);
             
             if (viaveis > 0) {
                 out.prob_viabilidade    = proporcao_viaveis;
@@ -355,7 +392,7 @@ std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias,
                 out.prob_reducao_moagem  = static_cast<double>(red)     / viaveis;
             }
         }
-    }
+    });
                 
                 // Mostra tempo total ao finalizar
                 auto fim_analise = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,138 @@
+#include "../model/viab/busca_melhores.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include "../model/viab/tabela_fases.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+
+namespace model::viab {
+
+namespace {
+
+struct Candidato {
+    int inicio;
+    double limite;
+    double viabilidade;
+};
+
+// Ordem do heap: o topo é a pior janela retida (menor valor; empate, início mais tardio)
+struct PiorPrimeiro {
+    bool operator()(const MelhorJanela& a, const MelhorJanela& b) const {
+        if (a.rendimento_esperado != b.rendimento_esperado)
+            return a.rendimento_esperado > b.rendimento_esperado;
+        return a.inicio < b.inicio;
+    }
+};
+
+using HeapGrupo = std::priority_queue<MelhorJanela, std::vector<MelhorJanela>, PiorPrimeiro>;
+
+} // namespace
+
+ResultadoMelhores buscar_melhores_janelas(const std::vector<Dia>& dias,
+                                          const std::vector<Fase>& fases,
+                                          const ConsultaMelhores& consulta,
+                                          const std::vector<int>& grupos) {
+    if (consulta.k < 1 || consulta.dias_janela < 1)
+        throw std::invalid_argument("k e dias_janela devem ser >= 1");
+    if (consulta.viabilidade_min < 0.0 || consulta.viabilidade_min > 1.0)
+        throw std::invalid_argument("viabilidade_min deve estar em [0, 1]");
+    if (!grupos.empty() && grupos.size() != dias.size())
+        throw std::invalid_argument("grupos deve ter uma chave por dia");
+
+    ResultadoMelhores resultado;
+    const int n = static_cast<int>(dias.size());
+    const PlanoAnalise plano = planejar_analise(fases);
+    const int ultimo = n - plano.dias_min;   // último dia inicial com ciclo completo
+    if (fases.empty() || ultimo < 0) return resultado;
+    resultado.dias_candidatos = ultimo + 1;
+
+    const auto tabelas = construir_tabelas(dias, fases);
+    auto grupo_de = [&](int d) { return grupos.empty() ? 0 : grupos[d]; };
+
+    // 1) Viabilidade exata (restrição) e limite do rendimento esperado por dia
+    std::vector<double> viabilidade(ultimo + 1), limite(ultimo + 1);
+    paralelo_para(0, ultimo + 1, [&](int d) {
+        const LimitesDia l = limites_dia(tabelas, fases, n, d);
+        viabilidade[d] = l.viabilidade;
+        limite[d] = l.limite_rendimento;
+    });
+
+    // 2) Janelas candidatas (médias deslizantes), em ordem decrescente de limite
+    const int N = consulta.dias_janela;
+    std::vector<double> soma_viab(ultimo + 2, 0.0), soma_lim(ultimo + 2, 0.0);
+    std::partial_sum(viabilidade.begin(), viabilidade.end(), soma_viab.begin() + 1);
+    std::partial_sum(limite.begin(), limite.end(), soma_lim.begin() + 1);
+    std::vector<Candidato> candidatos;
+    for (int s = 0; s + N - 1 <= ultimo; ++s) {
+        if (grupo_de(s) != grupo_de(s + N - 1)) continue;
+        const double media_viab = (soma_viab[s + N] - soma_viab[s]) / N;
+        if (media_viab <= 0.0 || media_viab < consulta.viabilidade_min) continue;
+        candidatos.push_back({s, (soma_lim[s + N] - soma_lim[s]) / N, media_viab});
+    }
+    std::stable_sort(candidatos.begin(), candidatos.end(),
+                     [](const Candidato& a, const Candidato& b) { return a.limite > b.limite; });
+
+    // 3) Branch-and-bound em lotes: avalia por completo só o que ainda pode entrar no top K
+    std::vector<double> valor(ultimo + 1, -1.0);   // rendimento esperado por dia (-1 = pendente)
+    std::map<int, HeapGrupo> heaps;
+    auto pode_entrar = [&](const Candidato& c) {
+        auto it = heaps.find(grupo_de(c.inicio));
+        return it == heaps.end() || static_cast<int>(it->second.size()) < consulta.k ||
+               c.limite > it->second.top().rendimento_esperado;
+    };
+
+    const size_t tamanho_lote = 4 * static_cast<size_t>(pool_trabalho().threads());
+    size_t proximo = 0;
+    while (proximo < candidatos.size()) {
+        std::vector<const Candidato*> lote;
+        for (; proximo < candidatos.size() && lote.size() < tamanho_lote; ++proximo)
+            if (pode_entrar(candidatos[proximo])) lote.push_back(&candidatos[proximo]);
+        if (lote.empty()) break;
+
+        std::vector<int> pendentes;
+        for (auto* c : lote)
+            for (int d = c->inicio; d < c->inicio + N; ++d)
+                if (valor[d] < 0.0) {
+                    valor[d] = 0.0;   // marca para não repetir no lote
+                    pendentes.push_back(d);
+                }
+
+        paralelo_para(pendentes.size(), [&](size_t j) {
+            const int d = pendentes[j];
+            const ContagemDia c = plano.usar_amostragem
+                ? amostrar_dia(tabelas, fases, n, d, plano.amostras, semente_dia(consulta.semente, d))
+                : enumerar_dia(tabelas, fases, n, d);
+            valor[d] = c.amostras > 0 ? c.soma_rend / c.amostras : 0.0;
+        });
+        resultado.dias_avaliados += static_cast<long long>(pendentes.size());
+
+        for (auto* c : lote) {
+            double total = 0.0;
+            for (int d = c->inicio; d < c->inicio + N; ++d) total += valor[d];
+            MelhorJanela j;
+            j.grupo = grupo_de(c->inicio);
+            j.inicio = c->inicio;
+            j.data_inicio = dias[c->inicio].data_str;
+            j.data_fim = dias[c->inicio + N - 1].data_str;
+            j.rendimento_esperado = total / N;
+            j.prob_viabilidade = c->viabilidade;
+            j.limite_superior = c->limite;
+
+            HeapGrupo& heap = heaps[j.grupo];
+            heap.push(j);
+            if (static_cast<int>(heap.size()) > consulta.k) heap.pop();
+        }
+    }
+
+    for (auto& [grupo, heap] : heaps) {
+        std::vector<MelhorJanela> melhores;
+        for (; !heap.empty(); heap.pop()) melhores.push_back(heap.top());
+        resultado.janelas.insert(resultado.janelas.end(), melhores.rbegin(), melhores.rend());
+    }
+    return resultado;
+}
+
+} // namespace model::viab
@@ -0,0 +1,222 @@
+#include "../model/viab/calibracao.h"
+#include "../model/viab/amostragem.h"
+#include "../model/viab/analysis_config.h"
+#include "../model/viab/duracao_ponderada.h"
+#include "../model/viab/enumeracao.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+namespace model::viab {
+
+namespace {
+
+// Somas prefixadas do excesso de Tmax e de Tmin de uma fase (0 em dias ideais ou inviáveis)
+struct TabelaExcesso {
+    std::vector<double> dia;
+    std::vector<double> noite;
+};
+
+std::vector<TabelaExcesso> construir_excessos(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                                              EstatisticasPenalidade& est) {
+    const AnalysisConfig cfg;
+    const size_t n = dias.size();
+    std::vector<TabelaExcesso> tabelas(fases.size());
+    for (size_t f = 0; f < fases.size(); ++f) {
+        auto& t = tabelas[f];
+        t.dia.assign(n + 1, 0.0);
+        t.noite.assign(n + 1, 0.0);
+        for (size_t d = 0; d < n; ++d) {
+            const auto res = avaliar_dia(dias[d], fases[f], cfg);
+            double x_dia = 0.0, x_noite = 0.0;
+            if (res.viavel && !res.ideal) {
+                x_dia = std::max(0.0, dias[d].tmax - cfg.TMAX_PEN_THR);
+                x_noite = std::max(0.0, dias[d].tmin - cfg.TMIN_PEN_THR);
+            }
+            t.dia[d + 1] = t.dia[d] + x_dia;
+            t.noite[d + 1] = t.noite[d] + x_noite;
+            est.max_excesso_dia = std::max(est.max_excesso_dia, x_dia);
+            est.max_excesso_noite = std::max(est.max_excesso_noite, x_noite);
+        }
+    }
+    return tabelas;
+}
+
+struct EstadoExcesso {
+    double dia = 0.0;
+    double noite = 0.0;
+    bool ideal = true;
+    bool esb = false;
+    bool red = false;
+};
+
+// Contagens do dia inicial e histograma denso, compactado ao final
+class AcumuladorDia {
+public:
+    explicit AcumuladorDia(const EstatisticasPenalidade& est)
+        : bins_(est.bins), celulas_(static_cast<size_t>(est.bins) * est.bins),
+          escala_dia_(est.max_excesso_dia > 0.0 ? est.bins / est.max_excesso_dia : 0.0),
+          escala_noite_(est.max_excesso_noite > 0.0 ? est.bins / est.max_excesso_noite : 0.0) {}
+
+    void somar(const EstadoExcesso& e, int dias) {
+        const AnalysisConfig cfg;
+        const double ed = e.dia / dias, en = e.noite / dias;
+        contagem.viaveis++;
+        contagem.soma_rend += std::max(0.0, 1.0 - (cfg.PENAL_DIURNA * ed + cfg.PENAL_NOTURNA * en));
+        contagem.optimos += e.ideal;
+        contagem.esb += e.esb;
+        contagem.red += e.red;
+        const int bd = std::min(bins_ - 1, static_cast<int>(ed * escala_dia_));
+        const int bn = std::min(bins_ - 1, static_cast<int>(en * escala_noite_));
+        auto& c = celulas_[static_cast<size_t>(bd) * bins_ + bn];
+        c.caminhos++;
+        c.soma_dia += ed;
+        c.soma_noite += en;
+    }
+
+    EstatisticasDia compactar() const {
+        EstatisticasDia out;
+        out.amostras = contagem.amostras;
+        out.viaveis = contagem.viaveis;
+        for (size_t i = 0; i < celulas_.size(); ++i) {
+            if (celulas_[i].caminhos == 0) continue;
+            out.celulas.push_back(celulas_[i]);
+            out.celulas.back().indice = static_cast<std::uint32_t>(i);
+        }
+        return out;
+    }
+
+    ContagemDia contagem;
+
+private:
+    int bins_;
+    std::vector<CelulaExcesso> celulas_;
+    double escala_dia_, escala_noite_;
+};
+
+// Rendimento somado das células e quantas foram aproximadas
+double somar_rendimento(const EstatisticasPenalidade& est, const EstatisticasDia& dia,
+                        double a, double b, long long& aproximadas) {
+    const double largura_dia = est.max_excesso_dia / est.bins;
+    const double largura_noite = est.max_excesso_noite / est.bins;
+    double soma = 0.0;
+    for (const auto& c : dia.celulas) {
+        const int bd = static_cast<int>(c.indice / est.bins), bn = static_cast<int>(c.indice % est.bins);
+        const double baixo = a * bd * largura_dia + b * bn * largura_noite;
+        const double alto = a * (bd + 1) * largura_dia + b * (bn + 1) * largura_noite;
+        if (alto <= 1.0) {
+            soma += c.caminhos - a * c.soma_dia - b * c.soma_noite;
+        } else if (baixo < 1.0) {
+            soma += c.caminhos * std::max(0.0, 1.0 - (a * c.soma_dia + b * c.soma_noite) / c.caminhos);
+            ++aproximadas;
+        }
+    }
+    return soma;
+}
+
+} // namespace
+
+std::vector<ResultadoData> rodar_analise_estatisticas(const std::vector<Dia>& dias,
+                                                      const std::vector<Fase>& fases,
+                                                      EstatisticasPenalidade& est,
+                                                      std::uint64_t semente) {
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+    if (tem_pesos(fases))
+        throw std::invalid_argument("Estatísticas de calibração indisponíveis com durações ponderadas");
+    const int n = static_cast<int>(dias.size());
+    est = EstatisticasPenalidade();
+    est.dias.resize(n);
+    std::vector<ResultadoData> resultados(n);
+    if (n == 0 || fases.empty()) return resultados;
+
+    const PlanoAnalise plano = planejar_analise(fases);
+    const auto tabelas = construir_tabelas(dias, fases);
+    const auto excessos = construir_excessos(dias, fases, est);
+    const int P = static_cast<int>(fases.size());
+    const SorteadorDuracoes sorteador(fases);
+
+    // Mesma transição do motor de tabelas, acumulando os excessos em vez da penalidade
+    auto estender = [&](int i, int a, int b, const EstadoExcesso& ant, EstadoExcesso& novo) {
+        const TabelaFase& t = tabelas[i];
+        if (t.proximo_inviavel[a] < b) return false;
+        novo.dia = ant.dia + (excessos[i].dia[b] - excessos[i].dia[a]);
+        novo.noite = ant.noite + (excessos[i].noite[b] - excessos[i].noite[a]);
+        novo.ideal = ant.ideal && t.nao_ideais[b] == t.nao_ideais[a];
+        novo.esb = ant.esb || t.esbranq[b] != t.esbranq[a];
+        novo.red = ant.red || t.reducao[b] != t.reducao[a];
+        return true;
+    };
+
+    paralelo_para(0, n - plano.dias_min + 1, [&](int d) {
+        AcumuladorDia acc(est);
+        acc.contagem.amostras = plano.amostras;
+        if (!pode_ser_viavel(tabelas, fases, n, d)) {
+            // Sem caminho viável possível: contagens nulas, como no pré-filtro do motor
+        } else if (plano.usar_amostragem) {
+            std::mt19937_64 gen(semente_dia(semente, static_cast<std::uint64_t>(d)));
+            for (long long s = 0; s < plano.amostras; ++s) {
+                EstadoExcesso e;
+                int pos = d;
+                bool ok = true;
+                for (int i = 0; i < P && ok; ++i) {
+                    const int fim = pos + sorteador.sortear(i, gen);
+                    ok = fim <= n && estender(i, pos, fim, e, e);
+                    pos = fim;
+                }
+                if (ok) acc.somar(e, pos - d);
+            }
+        } else {
+            enumerar_caminhos(fases, n, d, EstadoExcesso{}, estender,
+                              [&](const int* limites, const EstadoExcesso& e) {
+                                  acc.somar(e, limites[P] - limites[0]);
+                              });
+        }
+        resultados[d] = finalizar_contagem(acc.contagem, plano);
+        resultados[d].data_str = dias[d].data_str;
+        est.dias[d] = acc.compactar();
+    });
+    return resultados;
+}
+
+double rendimento_calibrado(const EstatisticasPenalidade& est, const EstatisticasDia& dia,
+                            double penal_diurna, double penal_noturna) {
+    if (dia.viaveis == 0) return 0.0;
+    long long aproximadas = 0;
+    return somar_rendimento(est, dia, penal_diurna, penal_noturna, aproximadas) / dia.viaveis;
+}
+
+std::vector<ResultadoCalibracao> calibrar_penalidades(const EstatisticasPenalidade& est,
+                                                      const std::vector<double>& penal_diurna,
+                                                      const std::vector<double>& penal_noturna) {
+    for (double c : penal_diurna)
+        if (c < 0.0) throw std::invalid_argument("Coeficiente de penalidade negativo");
+    for (double c : penal_noturna)
+        if (c < 0.0) throw std::invalid_argument("Coeficiente de penalidade negativo");
+
+    std::vector<ResultadoCalibracao> out(penal_diurna.size() * penal_noturna.size());
+    paralelo_para(out.size(), [&](size_t k) {
+        ResultadoCalibracao& r = out[k];
+        r.penal_diurna = penal_diurna[k / penal_noturna.size()];
+        r.penal_noturna = penal_noturna[k % penal_noturna.size()];
+        long long avaliados = 0, com_viavel = 0;
+        for (const auto& dia : est.dias) {
+            if (dia.amostras == 0) continue;
+            ++avaliados;
+            if (dia.viaveis == 0) continue;
+            ++com_viavel;
+            const double rend = somar_rendimento(est, dia, r.penal_diurna, r.penal_noturna,
+                                                 r.celulas_aproximadas) / dia.viaveis;
+            r.rendimento_medio += rend;
+            r.rendimento_esperado += rend * dia.viaveis / dia.amostras;
+        }
+        if (com_viavel > 0) r.rendimento_medio /= com_viavel;
+        if (avaliados > 0) r.rendimento_esperado /= avaliados;
+    });
+    return out;
+}
+
+} // namespace model::viab
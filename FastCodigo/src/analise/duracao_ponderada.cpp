@@ -0,0 +1,251 @@
+#include "../model/viab/duracao_ponderada.h"
+#include "../model/viab/enumeracao.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace model::viab {
+
+std::vector<double> normalizar_pesos(const Fase& fase, std::vector<double> pesos) {
+    const size_t faixa = static_cast<size_t>(fase.durMax - fase.durMin + 1);
+    if (pesos.size() != faixa)
+        throw std::invalid_argument("Fase " + fase.nome + ": esperados " + std::to_string(faixa) +
+                                    " pesos (durMin..durMax), recebidos " + std::to_string(pesos.size()));
+    double soma = 0.0;
+    for (double p : pesos) {
+        if (!(p >= 0.0)) throw std::invalid_argument("Fase " + fase.nome + ": peso negativo");
+        soma += p;
+    }
+    if (!(soma > 0.0)) throw std::invalid_argument("Fase " + fase.nome + ": pesos com soma nula");
+    for (double& p : pesos) p /= soma;
+    return pesos;
+}
+
+std::vector<double> pesos_triangulares(const Fase& fase, double moda) {
+    if (moda < fase.durMin || moda > fase.durMax)
+        throw std::invalid_argument("Fase " + fase.nome + ": moda fora de [durMin, durMax]");
+    std::vector<double> pesos;
+    for (int d = fase.durMin; d <= fase.durMax; ++d) {
+        pesos.push_back(d <= moda ? (d - fase.durMin + 1) / (moda - fase.durMin + 1)
+                                  : (fase.durMax - d + 1) / (fase.durMax - moda + 1));
+    }
+    return normalizar_pesos(fase, pesos);
+}
+
+std::vector<double> pesos_normais(const Fase& fase, double media, double desvio) {
+    if (!(desvio > 0.0)) throw std::invalid_argument("Fase " + fase.nome + ": desvio deve ser > 0");
+    std::vector<double> pesos;
+    for (int d = fase.durMin; d <= fase.durMax; ++d) {
+        const double z = (d - media) / desvio;
+        pesos.push_back(std::exp(-0.5 * z * z));
+    }
+    return normalizar_pesos(fase, pesos);
+}
+
+bool tem_pesos(const std::vector<Fase>& fases) {
+    return std::any_of(fases.begin(), fases.end(), [](const Fase& f) { return !f.pesos.empty(); });
+}
+
+namespace {
+
+// Pesos de cada fase, uniformes quando não informados
+std::vector<std::vector<double>> pesos_efetivos(const std::vector<Fase>& fases) {
+    std::vector<std::vector<double>> pesos;
+    for (auto& f : fases) {
+        const int faixa = f.durMax - f.durMin + 1;
+        pesos.push_back(f.pesos.empty() ? std::vector<double>(faixa, 1.0 / faixa) : f.pesos);
+    }
+    return pesos;
+}
+
+// Caminho parcial do recálculo do rendimento
+struct EstadoPonderado {
+    double penalidade = 0.0;
+    double peso = 1.0;
+};
+
+} // namespace
+
+TerminosDia terminos_dia(const std::vector<TabelaFase>& tabelas, const std::vector<Fase>& fases,
+                         int n, int inicio, std::uint64_t semente) {
+    const PlanoAnalise plano = planejar_analise(fases);
+    const auto pesos = pesos_efetivos(fases);
+
+    int alcance = 0;
+    for (auto& f : fases) alcance += f.durMax;
+    // Por dia de término (inicio + off) da fase atual, sobre os prefixos viáveis
+    const size_t tamanho = static_cast<size_t>(alcance) + 1;
+    std::vector<double> prob(tamanho, 0.0), massa(tamanho, 0.0), ideal(tamanho, 0.0),
+        sem_esb(tamanho, 0.0), sem_red(tamanho, 0.0), caminhos(tamanho, 0.0), excesso(tamanho, 0.0);
+    std::vector<char> alcancado(tamanho, 0);
+    auto prob_n = prob, massa_n = massa, ideal_n = ideal, sem_esb_n = sem_esb, sem_red_n = sem_red,
+         caminhos_n = caminhos, excesso_n = excesso;
+    auto alcancado_n = alcancado;
+    prob[0] = ideal[0] = sem_esb[0] = sem_red[0] = caminhos[0] = 1.0;
+    alcancado[0] = 1;
+
+    int lo = 0, hi = 0;
+    for (size_t i = 0; i < fases.size(); ++i) {
+        const Fase& f = fases[i];
+        const TabelaFase& t = tabelas[i];
+        const int lo_n = lo + f.durMin, hi_n = hi + f.durMax;
+        for (int off = lo_n; off <= hi_n; ++off) {
+            prob_n[off] = massa_n[off] = ideal_n[off] = sem_esb_n[off] = sem_red_n[off] = 0.0;
+            caminhos_n[off] = excesso_n[off] = 0.0;
+            alcancado_n[off] = 0;
+        }
+        for (int off = lo; off <= hi; ++off) {
+            const int a = inicio + off;
+            if (!alcancado[off] || a > n) continue;
+            const int limite = std::min(t.proximo_inviavel[a], n);
+            for (int d = f.durMin; d <= f.durMax && a + d <= limite; ++d) {
+                const int b = a + d, destino = off + d;
+                const double w = pesos[i][d - f.durMin];
+                const double pen = t.penalidade[b] - t.penalidade[a];
+                prob_n[destino] += prob[off] * w;
+                massa_n[destino] += (massa[off] + prob[off] * pen) * w;
+                if (t.nao_ideais[b] == t.nao_ideais[a]) ideal_n[destino] += ideal[off] * w;
+                if (t.esbranq[b] == t.esbranq[a]) sem_esb_n[destino] += sem_esb[off] * w;
+                if (t.reducao[b] == t.reducao[a]) sem_red_n[destino] += sem_red[off] * w;
+                caminhos_n[destino] += caminhos[off];
+                const double exc = excesso[off] + pen - d;
+                excesso_n[destino] = alcancado_n[destino] ? std::max(excesso_n[destino], exc) : exc;
+                alcancado_n[destino] = 1;
+            }
+        }
+        std::swap(prob, prob_n);
+        std::swap(massa, massa_n);
+        std::swap(ideal, ideal_n);
+        std::swap(sem_esb, sem_esb_n);
+        std::swap(sem_red, sem_red_n);
+        std::swap(caminhos, caminhos_n);
+        std::swap(excesso, excesso_n);
+        std::swap(alcancado, alcancado_n);
+        lo = lo_n;
+        hi = hi_n;
+    }
+
+    TerminosDia out;
+    out.lo = lo;
+    out.hi = hi;
+    out.rendimento.assign(tamanho, 0.0);
+    bool corte = false;   // algum caminho viável com pen > T (rendimento truncado em 0)
+    for (int off = lo; off <= hi; ++off) {
+        if (!alcancado[off]) {
+            prob[off] = ideal[off] = sem_esb[off] = sem_red[off] = caminhos[off] = 0.0;
+            continue;
+        }
+        out.rendimento[off] = prob[off] - massa[off] / off;
+        corte = corte || excesso[off] > 0.0;
+    }
+
+    if (corte) {
+        const int P = static_cast<int>(fases.size());
+        std::fill(out.rendimento.begin(), out.rendimento.end(), 0.0);
+        if (!plano.usar_amostragem) {
+            enumerar_caminhos(
+                fases, n, inicio, EstadoPonderado{},
+                [&](int i, int a, int b, const EstadoPonderado& ant, EstadoPonderado& novo) {
+                    const TabelaFase& t = tabelas[i];
+                    if (t.proximo_inviavel[a] < b) return false;
+                    novo.penalidade = ant.penalidade + (t.penalidade[b] - t.penalidade[a]);
+                    novo.peso = ant.peso * pesos[i][b - a - fases[i].durMin];
+                    return true;
+                },
+                [&](const int* limites, const EstadoPonderado& e) {
+                    const int T = limites[P] - limites[0];
+                    out.rendimento[T] += e.peso * std::max(0.0, 1.0 - e.penalidade / T);
+                });
+        } else {
+            // Durações sorteadas da própria distribuição: a média estima E[rendimento · viável]
+            std::vector<std::discrete_distribution<int>> sorteio;
+            for (auto& p : pesos) sorteio.emplace_back(p.begin(), p.end());
+            std::mt19937_64 gen(semente_dia(semente, static_cast<std::uint64_t>(inicio)));
+            const double fracao = 1.0 / static_cast<double>(plano.amostras);
+            for (long long s = 0; s < plano.amostras; ++s) {
+                double pen = 0.0;
+                int pos = inicio;
+                bool ok = true;
+                for (int i = 0; i < P && ok; ++i) {
+                    const int fim = pos + fases[i].durMin + sorteio[i](gen);
+                    ok = fim <= n && tabelas[i].proximo_inviavel[pos] >= fim;
+                    if (ok) pen += tabelas[i].penalidade[fim] - tabelas[i].penalidade[pos];
+                    pos = fim;
+                }
+                if (ok) out.rendimento[pos - inicio] += fracao * std::max(0.0, 1.0 - pen / (pos - inicio));
+            }
+        }
+    }
+
+    out.prob = std::move(prob);
+    out.ideal = std::move(ideal);
+    out.sem_esb = std::move(sem_esb);
+    out.sem_red = std::move(sem_red);
+    out.caminhos = std::move(caminhos);
+    return out;
+}
+
+ResultadoData analisar_dia_ponderado(const std::vector<TabelaFase>& tabelas,
+                                     const std::vector<Fase>& fases, int n, int inicio,
+                                     std::uint64_t semente) {
+    const TerminosDia t = terminos_dia(tabelas, fases, n, inicio, semente);
+    ResultadoData out;
+    out.total_caminhos = planejar_analise(fases).caminhos;
+
+    double viavel = 0.0, soma_rend = 0.0, optimo = 0.0, nao_esb = 0.0, nao_red = 0.0, total = 0.0;
+    for (int off = t.lo; off <= t.hi; ++off) {
+        viavel += t.prob[off];
+        soma_rend += t.rendimento[off];
+        optimo += t.ideal[off];
+        nao_esb += t.sem_esb[off];
+        nao_red += t.sem_red[off];
+        total += t.caminhos[off];
+    }
+    out.caminhos_viaveis = total >= static_cast<double>(std::numeric_limits<long long>::max())
+        ? std::numeric_limits<long long>::max() : std::llround(total);
+    if (!(viavel > 0.0)) return out;
+
+    out.prob_viabilidade     = viavel;
+    out.rendimento_medio     = soma_rend / viavel;
+    out.prob_optimo          = optimo;
+    out.prob_esbranquiamento = std::max(0.0, 1.0 - nao_esb / viavel);
+    out.prob_reducao_moagem  = std::max(0.0, 1.0 - nao_red / viavel);
+    return out;
+}
+
+std::vector<ResultadoData> rodar_analise_ponderada(const std::vector<Dia>& dias,
+                                                   const std::vector<Fase>& fases,
+                                                   std::uint64_t semente,
+                                                   size_t* descartados) {
+    for (auto& f : fases) {
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+        if (!f.pesos.empty() && f.pesos.size() != static_cast<size_t>(f.durMax - f.durMin + 1))
+            throw std::invalid_argument("Pesos incompatíveis com [durMin, durMax] em fase: " + f.nome);
+    }
+    const int n = static_cast<int>(dias.size());
+    std::vector<ResultadoData> resultados(n);
+    if (n == 0 || fases.empty()) return resultados;
+
+    const PlanoAnalise plano = planejar_analise(fases);
+    const auto tabelas = construir_tabelas(dias, fases);
+    std::atomic<size_t> podados{0};
+    paralelo_para(0, n - plano.dias_min + 1, [&](int d) {
+        if (pode_ser_viavel(tabelas, fases, n, d)) {
+            resultados[d] = analisar_dia_ponderado(tabelas, fases, n, d, semente);
+        } else {
+            resultados[d].total_caminhos = plano.caminhos;
+            ++podados;
+        }
+        resultados[d].data_str = dias[d].data_str;
+    });
+    if (descartados) *descartados = podados;
+    return resultados;
+}
+
+} // namespace model::viab
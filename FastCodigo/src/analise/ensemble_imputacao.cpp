@@ -0,0 +1,242 @@
+#include "../model/viab/ensemble_imputacao.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include "../model/viab/tabela_fases.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace model::viab {
+
+const std::array<const char*, NUM_SAIDAS_ENSEMBLE> NOMES_SAIDAS_ENSEMBLE = {
+    "probabilidade_viabilidade", "rendimento_medio", "prob_esbranquiamento",
+    "prob_reducao_moagem", "prob_optimo"};
+
+namespace {
+
+std::array<double, NUM_SAIDAS_ENSEMBLE> saidas(const ResultadoData& r) {
+    return {r.prob_viabilidade, r.rendimento_medio, r.prob_esbranquiamento,
+            r.prob_reducao_moagem, r.prob_optimo};
+}
+
+// Média e soma dos quadrados dos desvios (Welford) de um dia afetado
+struct AcumuladorDia {
+    int n = 0;
+    std::array<double, NUM_SAIDAS_ENSEMBLE> media{}, m2{};
+    double media_viaveis = 0.0;
+
+    void adicionar(const ResultadoData& r) {
+        ++n;
+        const auto x = saidas(r);
+        for (int k = 0; k < NUM_SAIDAS_ENSEMBLE; ++k) {
+            const double delta = x[k] - media[k];
+            media[k] += delta / n;
+            m2[k] += delta * (x[k] - media[k]);
+        }
+        media_viaveis += (static_cast<double>(r.caminhos_viaveis) - media_viaveis) / n;
+    }
+};
+
+// Trecho [inicio, fim] das tabelas lido pelos dias iniciais afetados (uniões de [d, d + alcance])
+struct Trecho {
+    int inicio;
+    int fim;
+};
+
+/**
+ * Copia da base para `tabelas`, nos trechos, os prefixos da realização cujos
+ * dias de lacuna são `preenchidos` (um por lacuna, na ordem da série). Fora de
+ * cada trecho os prefixos ficam os da base: diferem da realização por uma
+ * constante (as lacunas anteriores), que se cancela nas diferenças t[b] - t[a]
+ * das janelas do trecho; proximo_inviavel >= fim equivale a "nenhum no trecho".
+ */
+void corrigir_trechos(std::vector<TabelaFase>& tabelas, const std::vector<TabelaFase>& base,
+                      const std::vector<Fase>& fases, const std::vector<Trecho>& trechos,
+                      const std::vector<char>& lacuna, const std::vector<int>& lacunas_ate,
+                      const std::vector<Dia>& preenchidos) {
+    const AnalysisConfig cfg;
+    for (size_t f = 0; f < fases.size(); ++f) {
+        TabelaFase& t = tabelas[f];
+        const TabelaFase& b = base[f];
+        for (const Trecho& tr : trechos) {
+            int inv = 0, nid = 0, esb = 0, red = 0;   // desvios acumulados em relação à base
+            double pen = 0.0;
+            for (int p = tr.inicio; p < tr.fim; ++p) {
+                if (lacuna[p]) {
+                    const auto res = avaliar_dia(preenchidos[lacunas_ate[p]], fases[f], cfg);
+                    inv += !res.viavel - (b.inviaveis[p + 1] - b.inviaveis[p]);
+                    nid += !res.ideal - (b.nao_ideais[p + 1] - b.nao_ideais[p]);
+                    esb += res.risco_esbranq - (b.esbranq[p + 1] - b.esbranq[p]);
+                    red += res.risco_reducao - (b.reducao[p + 1] - b.reducao[p]);
+                    pen += res.penalidade_dia + res.penalidade_noite - (b.penalidade[p + 1] - b.penalidade[p]);
+                }
+                t.inviaveis[p + 1]  = b.inviaveis[p + 1] + inv;
+                t.nao_ideais[p + 1] = b.nao_ideais[p + 1] + nid;
+                t.esbranq[p + 1]    = b.esbranq[p + 1] + esb;
+                t.reducao[p + 1]    = b.reducao[p + 1] + red;
+                t.penalidade[p + 1] = b.penalidade[p + 1] + pen;
+            }
+            for (int p = tr.fim; p-- > tr.inicio;) {
+                const bool inviavel = t.inviaveis[p + 1] != t.inviaveis[p];
+                t.proximo_inviavel[p] = inviavel ? p : t.proximo_inviavel[p + 1];
+            }
+        }
+    }
+}
+
+// Desfaz corrigir_trechos()
+void restaurar_trechos(std::vector<TabelaFase>& tabelas, const std::vector<TabelaFase>& base,
+                       const std::vector<Trecho>& trechos) {
+    for (size_t f = 0; f < tabelas.size(); ++f) {
+        TabelaFase& t = tabelas[f];
+        const TabelaFase& b = base[f];
+        for (const Trecho& tr : trechos) {
+            const int a = tr.inicio, z = tr.fim + 1;
+            std::copy(b.inviaveis.begin() + a, b.inviaveis.begin() + z, t.inviaveis.begin() + a);
+            std::copy(b.nao_ideais.begin() + a, b.nao_ideais.begin() + z, t.nao_ideais.begin() + a);
+            std::copy(b.penalidade.begin() + a, b.penalidade.begin() + z, t.penalidade.begin() + a);
+            std::copy(b.esbranq.begin() + a, b.esbranq.begin() + z, t.esbranq.begin() + a);
+            std::copy(b.reducao.begin() + a, b.reducao.begin() + z, t.reducao.begin() + a);
+            std::copy(b.proximo_inviavel.begin() + a, b.proximo_inviavel.begin() + z,
+                      t.proximo_inviavel.begin() + a);
+        }
+    }
+}
+
+} // namespace
+
+void imputar_dia(Dia& dia, const LeiturasDia& leituras, const std::vector<Fase>& fases,
+                 std::uint64_t semente, int realizacao, int indice_dia) {
+    double lo = std::numeric_limits<double>::max();
+    double hi = std::numeric_limits<double>::lowest();
+    for (auto& f : fases) {
+        lo = std::min(lo, f.optMinT);
+        hi = std::max(hi, f.optMaxT);
+    }
+    std::mt19937_64 gen(semente_dia(semente_dia(semente, static_cast<std::uint64_t>(realizacao)),
+                                    static_cast<std::uint64_t>(indice_dia)));
+    std::uniform_real_distribution<double> leitura(lo, hi);
+    // Os extremos observados são leituras do dia; sorteiam-se só as ausentes
+    double tmax = std::numeric_limits<double>::lowest();
+    double tmin = std::numeric_limits<double>::max();
+    auto incluir = [&](double t) {
+        tmax = std::max(tmax, t);
+        tmin = std::min(tmin, t);
+    };
+    if (leituras.tmax_observada) incluir(dia.tmax);
+    if (leituras.tmin_observada) incluir(dia.tmin);
+    // Sem nenhum extremo observado há ao menos uma leitura a sortear
+    const bool vazio = !leituras.tmax_observada && !leituras.tmin_observada;
+    const int sorteios = vazio ? std::max(1, leituras.ausentes) : leituras.ausentes;
+    for (int h = 0; h < sorteios; ++h) incluir(leitura(gen));
+    dia.tmax = tmax;
+    dia.tmin = tmin;
+}
+
+std::vector<ResultadoEnsemble> rodar_ensemble_imputacao(const SerieComLacunas& serie,
+                                                        const std::vector<Fase>& fases,
+                                                        int realizacoes,
+                                                        std::uint64_t semente) {
+    if (realizacoes < 1)
+        throw std::invalid_argument("O ensemble exige ao menos uma realização");
+    if (serie.lacuna.size() != serie.dias.size())
+        throw std::invalid_argument("Máscara de lacunas com tamanho diferente da série");
+    if (!serie.leituras.empty() && serie.leituras.size() != serie.dias.size())
+        throw std::invalid_argument("Leituras com tamanho diferente da série");
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+
+    const int n = static_cast<int>(serie.dias.size());
+    std::vector<ResultadoEnsemble> resultados(n);
+    if (n == 0 || fases.empty()) return resultados;
+
+    const PlanoAnalise plano = planejar_analise(fases);
+    int alcance = 0;
+    for (auto& f : fases) alcance += f.durMax;
+
+    // Dias iniciais afetados: alguma lacuna em [d, d + alcance)
+    std::vector<int> lacunas_ate(n + 1, 0);
+    for (int d = 0; d < n; ++d) lacunas_ate[d + 1] = lacunas_ate[d] + (serie.lacuna[d] != 0);
+    std::vector<int> afetados;
+    for (int d = 0; d + plano.dias_min <= n; ++d) {
+        resultados[d].afetado = lacunas_ate[std::min(n, d + alcance)] - lacunas_ate[d] > 0;
+        if (resultados[d].afetado) afetados.push_back(d);
+    }
+
+    // Dias de lacuna na ordem da série (índice lacunas_ate[d]) e trechos lidos pelos afetados
+    std::vector<int> dias_lacuna;
+    for (int d = 0; d < n; ++d)
+        if (serie.lacuna[d]) dias_lacuna.push_back(d);
+    std::vector<Trecho> trechos;
+    for (int d : afetados) {
+        const int fim = std::min(n, d + alcance);
+        if (!trechos.empty() && d <= trechos.back().fim) trechos.back().fim = fim;
+        else trechos.push_back({d, fim});
+    }
+    auto preencher = [&](int r, std::vector<Dia>& preenchidos) {
+        const LeiturasDia sem_leituras;
+        for (size_t j = 0; j < dias_lacuna.size(); ++j) {
+            const int d = dias_lacuna[j];
+            preenchidos[j] = serie.dias[d];
+            imputar_dia(preenchidos[j], serie.leituras.empty() ? sem_leituras : serie.leituras[d],
+                        fases, semente, r, d);
+        }
+    };
+    auto avaliar = [&](const std::vector<TabelaFase>& tabelas, int d) {
+        ContagemDia c;
+        c.amostras = plano.amostras;   // zeros exatos se o pré-filtro reprovar o dia
+        if (pode_ser_viavel(tabelas, fases, n, d)) c = plano.usar_amostragem
+            ? amostrar_dia(tabelas, fases, n, d, plano.amostras, semente_dia(semente, d))
+            : enumerar_dia(tabelas, fases, n, d);
+        ResultadoData r = finalizar_contagem(c, plano);
+        r.data_str = serie.dias[d].data_str;
+        return r;
+    };
+
+    std::cout << "Iniciando ensemble de " << realizacoes << " realizações: "
+              << lacunas_ate[n] << " dias com lacuna, " << afetados.size()
+              << " dias iniciais reavaliados por realização" << std::endl;
+
+    // Realização 0: todos os dias iniciais (os não afetados ficam prontos aqui)
+    std::vector<Dia> preenchidos(dias_lacuna.size());
+    preencher(0, preenchidos);
+    std::vector<AcumuladorDia> acumuladores(afetados.size());
+    std::vector<TabelaFase> base;
+    {
+        std::vector<Dia> dias = serie.dias;
+        for (size_t j = 0; j < dias_lacuna.size(); ++j) dias[dias_lacuna[j]] = preenchidos[j];
+        base = construir_tabelas(dias, fases);
+        paralelo_para(0, n - plano.dias_min + 1, [&](int d) { resultados[d].media = avaliar(base, d); });
+        for (size_t j = 0; j < afetados.size(); ++j)
+            acumuladores[j].adicionar(resultados[afetados[j]].media);
+    }
+
+    // Demais realizações: só os dias iniciais que alcançam lacunas, sobre a base corrigida nos trechos
+    std::vector<TabelaFase> tabelas = base;
+    for (int r = 1; r < realizacoes && !afetados.empty(); ++r) {
+        preencher(r, preenchidos);
+        corrigir_trechos(tabelas, base, fases, trechos, serie.lacuna, lacunas_ate, preenchidos);
+        paralelo_para(afetados.size(), [&](size_t j) { acumuladores[j].adicionar(avaliar(tabelas, afetados[j])); });
+        restaurar_trechos(tabelas, base, trechos);
+    }
+
+    for (size_t j = 0; j < afetados.size(); ++j) {
+        const AcumuladorDia& a = acumuladores[j];
+        ResultadoEnsemble& out = resultados[afetados[j]];
+        out.media.prob_viabilidade     = a.media[0];
+        out.media.rendimento_medio     = a.media[1];
+        out.media.prob_esbranquiamento = a.media[2];
+        out.media.prob_reducao_moagem  = a.media[3];
+        out.media.prob_optimo          = a.media[4];
+        out.media.caminhos_viaveis     = std::llround(a.media_viaveis);
+        if (a.n > 1)
+            for (int k = 0; k < NUM_SAIDAS_ENSEMBLE; ++k) out.desvio[k] = std::sqrt(a.m2[k] / (a.n - 1));
+    }
+    return resultados;
+}
+
+} // namespace model::viab
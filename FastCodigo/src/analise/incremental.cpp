@@ -0,0 +1,56 @@
+#include "../model/viab/incremental.h"
+#include <algorithm>
+#include <string>
+
+namespace model::viab {
+
+std::uint64_t hash_fase(const Fase& fase) {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    auto bytes = [&](const void* p, size_t n) {
+        const auto* b = static_cast<const unsigned char*>(p);
+        for (size_t i = 0; i < n; ++i) {
+            h ^= b[i];
+            h *= 0x100000001b3ULL;
+        }
+    };
+    bytes(fase.nome.data(), fase.nome.size());
+    const double limites[4] = {fase.minT, fase.maxT, fase.optMinT, fase.optMaxT};
+    const int duracoes[2] = {fase.durMin, fase.durMax};
+    bytes(limites, sizeof(limites));
+    bytes(duracoes, sizeof(duracoes));
+    return h;
+}
+
+std::vector<char> dias_alterados(const TabelaFase& a, const TabelaFase& b) {
+    const size_t n = std::min(a.inviaveis.size(), b.inviaveis.size()) - 1;
+    auto delta = [](const auto& v, size_t d) { return v[d + 1] - v[d]; };
+    std::vector<char> alterado(n, 0);
+    for (size_t d = 0; d < n; ++d) {
+        alterado[d] = delta(a.inviaveis, d) != delta(b.inviaveis, d) ||
+                      delta(a.nao_ideais, d) != delta(b.nao_ideais, d) ||
+                      delta(a.penalidade, d) != delta(b.penalidade, d) ||
+                      delta(a.esbranq, d) != delta(b.esbranq, d) ||
+                      delta(a.reducao, d) != delta(b.reducao, d);
+    }
+    return alterado;
+}
+
+std::vector<char> inicios_afetados(const std::vector<Fase>& fases, size_t fase,
+                                   const std::vector<char>& alterados) {
+    const int n = static_cast<int>(alterados.size());
+    int antes = 0, ate = 0;   // Σ durMin antes da fase; Σ durMax até ela
+    for (size_t j = 0; j < fases.size(); ++j) {
+        if (j < fase) antes += fases[j].durMin;
+        if (j <= fase) ate += fases[j].durMax;
+    }
+    std::vector<int> contagem(n + 1, 0);
+    for (int d = 0; d < n; ++d) contagem[d + 1] = contagem[d] + (alterados[d] != 0);
+    std::vector<char> afetado(n, 0);
+    for (int d = 0; d < n; ++d) {
+        const int a = std::min(n, d + antes), b = std::min(n, d + ate);
+        afetado[d] = contagem[b] - contagem[a] > 0;
+    }
+    return afetado;
+}
+
+} // namespace model::viab
@@ -0,0 +1,45 @@
+#include "../model/viab/kernel_especializado.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace model::viab {
+
+bool cultivar_embutida(const std::string& nome) {
+#ifdef RICEGUARD_CATALOGOS_EMBUTIDOS
+    return nome == catalogo::ArrozPadrao::nome;
+#else
+    (void)nome;
+    return false;
+#endif
+}
+
+std::vector<Fase> fases_cultivar(const std::string& nome) {
+#ifdef RICEGUARD_CATALOGOS_EMBUTIDOS
+    if (nome == catalogo::ArrozPadrao::nome)
+        return fases_do_catalogo<catalogo::ArrozPadrao>();
+#endif
+    throw std::invalid_argument("Cultivar sem catálogo embutido: " + nome);
+}
+
+std::vector<ResultadoData> rodar_analise_cultivar(const std::vector<Dia>& dias,
+                                                  const std::string& nome) {
+    if (!cultivar_embutida(nome))
+        throw std::invalid_argument("Cultivar sem catálogo embutido: " + nome);
+
+    std::cout << "Iniciando análise de " << dias.size()
+              << " dias com kernel especializado (cultivar " << nome << ")" << std::endl;
+    auto inicio = std::chrono::high_resolution_clock::now();
+
+    std::vector<ResultadoData> resultados;
+#ifdef RICEGUARD_CATALOGOS_EMBUTIDOS
+    resultados = rodar_analise_fixa<catalogo::ArrozPadrao>(dias);
+#endif
+
+    auto fim = std::chrono::high_resolution_clock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(fim - inicio).count();
+    std::cout << "Análise concluída em " << ms << " ms." << std::endl;
+    return resultados;
+}
+
+} // namespace model::viab
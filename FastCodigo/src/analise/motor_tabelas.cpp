@@ -0,0 +1,278 @@
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/enumeracao.h"
+#include "../model/viab/pool_trabalho.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+
+namespace model::viab {
+
+PlanoAnalise planejar_analise(const std::vector<Fase>& fases) {
+    PlanoAnalise plano;
+    plano.caminhos = contar_caminhos(fases);
+    plano.total_combinacoes = plano.caminhos.saturado();
+    plano.usar_amostragem = plano.caminhos.excede_128 ||
+        plano.caminhos.exato > static_cast<Contagem128>(AnalysisConfig::LIMITE_COMBINACOES / 10);
+    plano.amostras = plano.usar_amostragem ? AnalysisConfig::LIMITE_COMBINACOES / 10
+                                           : plano.total_combinacoes;
+    for (auto& f : fases) plano.dias_min += f.durMin;
+    return plano;
+}
+
+namespace {
+
+template <typename Real>
+struct EstadoCaminho {
+    Real penalidade = Real(0);
+    bool ideal = true;
+    bool esb = false;
+    bool red = false;
+};
+
+// Estende o caminho com a janela [a, b) da fase i; false se houver dia inviável
+template <typename Real>
+inline bool estender_janela(const TabelaFaseT<Real>& t, int a, int b,
+                            const EstadoCaminho<Real>& ant, EstadoCaminho<Real>& novo) {
+    if (t.proximo_inviavel[a] < b) return false;
+    novo.penalidade = ant.penalidade + penalidade_janela(t, a, b);
+    novo.ideal = ant.ideal && t.nao_ideais[b] == t.nao_ideais[a];
+    novo.esb = ant.esb || t.esbranq[b] != t.esbranq[a];
+    novo.red = ant.red || t.reducao[b] != t.reducao[a];
+    return true;
+}
+
+template <typename Real>
+inline void somar_folha(ContagemDia& c, const EstadoCaminho<Real>& e, int dias) {
+    c.viaveis++;
+    c.soma_rend += std::max(Real(0), Real(1) - e.penalidade / static_cast<Real>(dias));
+    c.optimos += e.ideal;
+    c.esb += e.esb;
+    c.red += e.red;
+}
+
+} // namespace
+
+template <typename Real>
+ContagemDia enumerar_dia(const std::vector<TabelaFaseT<Real>>& tabelas,
+                         const std::vector<Fase>& fases, int n, int inicio) {
+    ContagemDia c;
+    const int P = static_cast<int>(fases.size());
+    enumerar_caminhos(
+        fases, n, inicio, EstadoCaminho<Real>{},
+        [&](int i, int a, int b, const EstadoCaminho<Real>& ant, EstadoCaminho<Real>& novo) {
+            return estender_janela(tabelas[i], a, b, ant, novo);
+        },
+        [&](const int* limites, const EstadoCaminho<Real>& e) {
+            somar_folha(c, e, limites[P] - limites[0]);
+        });
+    long long total = 1;
+    for (auto& f : fases) total *= f.durMax - f.durMin + 1;
+    c.amostras = total;
+    return c;
+}
+
+template <typename Real>
+ContagemDia amostrar_dia(const std::vector<TabelaFaseT<Real>>& tabelas,
+                         const std::vector<Fase>& fases, int n, int inicio,
+                         long long amostras, std::uint64_t semente) {
+    ContagemDia c;
+    const int P = static_cast<int>(fases.size());
+    std::mt19937_64 gen(semente);
+    const SorteadorDuracoes sorteador(fases);
+
+    for (long long s = 0; s < amostras; ++s) {
+        EstadoCaminho<Real> e;
+        int pos = inicio;
+        bool ok = true;
+        for (int i = 0; i < P && ok; ++i) {
+            int fim = pos + sorteador.sortear(i, gen);
+            ok = fim <= n && estender_janela(tabelas[i], pos, fim, e, e);
+            pos = fim;
+        }
+        if (ok) somar_folha(c, e, pos - inicio);
+    }
+    c.amostras = amostras;
+    return c;
+}
+
+template ContagemDia enumerar_dia<float>(const std::vector<TabelaFaseT<float>>&,
+                                         const std::vector<Fase>&, int, int);
+template ContagemDia enumerar_dia<double>(const std::vector<TabelaFaseT<double>>&,
+                                          const std::vector<Fase>&, int, int);
+template ContagemDia amostrar_dia<float>(const std::vector<TabelaFaseT<float>>&,
+                                         const std::vector<Fase>&, int, int, long long, std::uint64_t);
+template ContagemDia amostrar_dia<double>(const std::vector<TabelaFaseT<double>>&,
+                                          const std::vector<Fase>&, int, int, long long, std::uint64_t);
+
+LimitesDia limites_dia(const std::vector<TabelaFase>& tabelas,
+                       const std::vector<Fase>& fases, int n, int inicio) {
+    int alcance = 0;
+    for (auto& f : fases) alcance += f.durMax;
+    // Por dia de término (inicio + off) da fase atual, sobre os prefixos viáveis:
+    // probabilidade, massa de penalidade (prob · pen) e maior penalidade
+    std::vector<double> prob(alcance + 1, 0.0), massa(alcance + 1, 0.0), maxima(alcance + 1, 0.0);
+    std::vector<double> prob_n(alcance + 1), massa_n(alcance + 1), maxima_n(alcance + 1);
+    prob[0] = 1.0;
+    int lo = 0, hi = 0;
+    for (size_t i = 0; i < fases.size(); ++i) {
+        const Fase& f = fases[i];
+        const TabelaFase& t = tabelas[i];
+        const double peso = 1.0 / (f.durMax - f.durMin + 1);
+        const int lo_n = lo + f.durMin, hi_n = hi + f.durMax;
+        std::fill(prob_n.begin() + lo_n, prob_n.begin() + hi_n + 1, 0.0);
+        std::fill(massa_n.begin() + lo_n, massa_n.begin() + hi_n + 1, 0.0);
+        std::fill(maxima_n.begin() + lo_n, maxima_n.begin() + hi_n + 1, 0.0);
+        for (int off = lo; off <= hi; ++off) {
+            const int a = inicio + off;
+            if (prob[off] == 0.0 || a > n) continue;
+            const int limite = t.proximo_inviavel[a];   // <= n
+            const double p = prob[off] * peso;
+            const double m = massa[off] * peso;
+            for (int d = f.durMin; d <= f.durMax && a + d <= limite; ++d) {
+                const double pen = t.penalidade[a + d] - t.penalidade[a];
+                prob_n[off + d] += p;
+                massa_n[off + d] += m + p * pen;
+                maxima_n[off + d] = std::max(maxima_n[off + d], maxima[off] + pen);
+            }
+        }
+        std::swap(prob, prob_n);
+        std::swap(massa, massa_n);
+        std::swap(maxima, maxima_n);
+        lo = lo_n;
+        hi = hi_n;
+    }
+
+    LimitesDia out;
+    double massa_total = 0.0, pen_max = 0.0;
+    for (int off = lo; off <= hi; ++off) {
+        out.viabilidade += prob[off];
+        massa_total += massa[off];
+        pen_max = std::max(pen_max, maxima[off]);
+    }
+    const double escala = std::max(static_cast<double>(alcance), pen_max);   // Tmax · X
+    out.limite_rendimento = std::max(0.0, out.viabilidade - massa_total / escala);
+    return out;
+}
+
+double probabilidade_viavel(const std::vector<TabelaFase>& tabelas,
+                            const std::vector<Fase>& fases, int n, int inicio) {
+    return limites_dia(tabelas, fases, n, inicio).viabilidade;
+}
+
+template <typename Real>
+bool pode_ser_viavel(const std::vector<TabelaFaseT<Real>>& tabelas,
+                     const std::vector<Fase>& fases, int n, int inicio) {
+    int lo = inicio, hi = inicio;
+    for (size_t i = 0; i < fases.size(); ++i) {
+        const Fase& f = fases[i];
+        const auto& proximo = tabelas[i].proximo_inviavel;
+        int lo_n = n + 1, hi_n = -1;
+        for (int a = lo; a <= hi && a + f.durMin <= n; ++a) {
+            const int fim_max = std::min({a + f.durMax, proximo[a], n});
+            if (a + f.durMin > fim_max) continue;
+            lo_n = std::min(lo_n, a + f.durMin);
+            hi_n = std::max(hi_n, fim_max);
+        }
+        if (hi_n < 0) return false;
+        lo = lo_n;
+        hi = hi_n;
+    }
+    return true;
+}
+
+template bool pode_ser_viavel<float>(const std::vector<TabelaFaseT<float>>&,
+                                     const std::vector<Fase>&, int, int);
+template bool pode_ser_viavel<double>(const std::vector<TabelaFaseT<double>>&,
+                                      const std::vector<Fase>&, int, int);
+
+std::uint64_t semente_dia(std::uint64_t semente, std::uint64_t dia) {
+    std::uint64_t z = semente + (dia + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+template <typename Real>
+size_t avaliar_dias(const std::vector<TabelaFaseT<Real>>& tabelas, const std::vector<Fase>& fases,
+                    int n, const std::vector<int>& inicios, std::uint64_t semente,
+                    const std::function<void(size_t, const ContagemDia&)>& concluir) {
+    const PlanoAnalise plano = planejar_analise(fases);
+    std::atomic<size_t> descartados{0};
+    paralelo_para(inicios.size(), [&](size_t j) {
+        const int d = inicios[j];
+        if (!pode_ser_viavel(tabelas, fases, n, d)) {
+            ContagemDia zero;
+            zero.amostras = plano.amostras;
+            concluir(j, zero);
+            ++descartados;
+            return;
+        }
+        concluir(j, plano.usar_amostragem
+            ? amostrar_dia(tabelas, fases, n, d, plano.amostras, semente_dia(semente, d))
+            : enumerar_dia(tabelas, fases, n, d));
+    });
+    return descartados;
+}
+
+template size_t avaliar_dias<float>(const std::vector<TabelaFaseT<float>>&, const std::vector<Fase>&,
+                                    int, const std::vector<int>&, std::uint64_t,
+                                    const std::function<void(size_t, const ContagemDia&)>&);
+template size_t avaliar_dias<double>(const std::vector<TabelaFaseT<double>>&, const std::vector<Fase>&,
+                                     int, const std::vector<int>&, std::uint64_t,
+                                     const std::function<void(size_t, const ContagemDia&)>&);
+
+size_t avaliar_dias(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                    const std::vector<int>& inicios, std::uint64_t semente,
+                    const std::function<void(size_t, const ContagemDia&)>& concluir,
+                    Precisao precisao) {
+    if (inicios.empty()) return 0;
+    const int n = static_cast<int>(dias.size());
+    if (precisao == Precisao::Simples)
+        return avaliar_dias(construir_tabelas_em<float>(dias, fases), fases, n, inicios, semente, concluir);
+    return avaliar_dias(construir_tabelas_em<double>(dias, fases), fases, n, inicios, semente, concluir);
+}
+
+ResultadoData finalizar_contagem(const ContagemDia& c, const PlanoAnalise& plano) {
+    ResultadoData out;
+    out.total_caminhos = plano.caminhos;
+    if (c.amostras == 0) return out;
+    if (plano.usar_amostragem) {
+        double proporcao = static_cast<double>(c.viaveis) / c.amostras;
+        out.caminhos_viaveis = escalar_caminhos(proporcao, plano.caminhos);
+    } else {
+        out.caminhos_viaveis = c.viaveis;
+    }
+    if (c.viaveis > 0) {
+        out.prob_viabilidade     = static_cast<double>(c.viaveis) / c.amostras;
+        out.rendimento_medio     = c.soma_rend / c.viaveis;
+        out.prob_optimo          = static_cast<double>(c.optimos) / c.amostras;
+        out.prob_esbranquiamento = static_cast<double>(c.esb) / c.viaveis;
+        out.prob_reducao_moagem  = static_cast<double>(c.red) / c.viaveis;
+    }
+    return out;
+}
+
+std::vector<ResultadoData> rodar_analise_tabelas(const std::vector<Dia>& dias,
+                                                 const std::vector<Fase>& fases,
+                                                 Precisao precisao, std::uint64_t semente,
+                                                 size_t* descartados) {
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+    const int n = static_cast<int>(dias.size());
+    std::vector<ResultadoData> resultados(n);
+    if (n == 0 || fases.empty()) return resultados;
+
+    const PlanoAnalise plano = planejar_analise(fases);
+    std::vector<int> inicios;
+    for (int d = 0; d + plano.dias_min <= n; ++d) inicios.push_back(d);
+    const size_t podados = avaliar_dias(dias, fases, inicios, semente, [&](size_t j, const ContagemDia& c) {
+        resultados[inicios[j]] = finalizar_contagem(c, plano);
+        resultados[inicios[j]].data_str = dias[inicios[j]].data_str;
+    }, precisao);
+    if (descartados) *descartados = podados;
+    return resultados;
+}
+
+} // namespace model::viab
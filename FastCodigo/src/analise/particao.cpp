@@ -0,0 +1,123 @@
+#include "../model/viab/particao.h"
+#include <stdexcept>
+
+namespace model::viab {
+
+namespace {
+
+// FNV-1a 64 incremental
+struct Fnv {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+
+    void bytes(const void* p, size_t n) {
+        const auto* b = static_cast<const unsigned char*>(p);
+        for (size_t i = 0; i < n; ++i) {
+            h ^= b[i];
+            h *= 0x100000001b3ULL;
+        }
+    }
+    template <typename T>
+    void valor(const T& v) { bytes(&v, sizeof(T)); }
+    void texto(const std::string& s) {
+        valor(s.size());
+        bytes(s.data(), s.size());
+    }
+};
+
+} // namespace
+
+bool pertence_a_fatia(int dia, int indice, int total) {
+    return dia % total == indice;
+}
+
+std::uint64_t impressao_execucao(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                                 std::uint64_t semente) {
+    Fnv fnv;
+    fnv.valor(semente);
+    // Constantes do modelo: mudam o resultado sem mudar série nem fases
+    fnv.valor(AnalysisConfig::LIMITE_COMBINACOES);
+    fnv.valor(AnalysisConfig::TMAX_PEN_THR);
+    fnv.valor(AnalysisConfig::TMIN_PEN_THR);
+    fnv.valor(AnalysisConfig::ESBRANQ_THR);
+    fnv.valor(AnalysisConfig::RED_THR);
+    fnv.valor(AnalysisConfig::PENAL_DIURNA);
+    fnv.valor(AnalysisConfig::PENAL_NOTURNA);
+    for (auto& f : fases) {
+        fnv.texto(f.nome);
+        fnv.valor(f.minT);
+        fnv.valor(f.maxT);
+        fnv.valor(f.optMinT);
+        fnv.valor(f.optMaxT);
+        fnv.valor(f.durMin);
+        fnv.valor(f.durMax);
+        for (double p : f.pesos) fnv.valor(p);
+    }
+    for (auto& d : dias) {
+        fnv.texto(d.data_str);
+        fnv.valor(d.tmax);
+        fnv.valor(d.tmin);
+    }
+    return fnv.h;
+}
+
+ResultadoParcial rodar_fatia(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                             int indice, int total, std::uint64_t semente) {
+    if (total < 1 || indice < 0 || indice >= total)
+        throw std::invalid_argument("Fatia inválida: " + std::to_string(indice) + "/" + std::to_string(total));
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+
+    ResultadoParcial p;
+    p.indice = indice;
+    p.total = total;
+    p.semente = semente;
+    p.impressao = impressao_execucao(dias, fases, semente);
+    p.fases = fases;
+    for (auto& d : dias) {
+        p.datas.push_back(d.data_str);
+        p.meses.push_back(d.mes);
+    }
+
+    const int n = static_cast<int>(dias.size());
+    if (n == 0 || fases.empty()) return p;
+    const PlanoAnalise plano = planejar_analise(fases);
+    for (int d = 0; d + plano.dias_min <= n; ++d)
+        if (pertence_a_fatia(d, indice, total)) p.dias_iniciais.push_back(d);
+    p.contagens.resize(p.dias_iniciais.size());
+    avaliar_dias(dias, fases, p.dias_iniciais, semente,
+                 [&](size_t j, const ContagemDia& c) { p.contagens[j] = c; });
+    return p;
+}
+
+ResultadoCombinado combinar_parciais(const std::vector<ResultadoParcial>& parciais) {
+    if (parciais.empty()) throw std::invalid_argument("Nenhuma fatia para combinar");
+    const ResultadoParcial& ref = parciais.front();
+    std::vector<char> vista(ref.total, 0);
+    for (auto& p : parciais) {
+        if (p.impressao != ref.impressao || p.total != ref.total || p.datas != ref.datas)
+            throw std::invalid_argument("Fatias de execuções diferentes");
+        if (p.indice < 0 || p.indice >= p.total || vista[p.indice])
+            throw std::invalid_argument("Fatia repetida ou inválida: " + std::to_string(p.indice));
+        vista[p.indice] = 1;
+    }
+    for (int i = 0; i < ref.total; ++i)
+        if (!vista[i])
+            throw std::invalid_argument("Fatia ausente: " + std::to_string(i) + "/" + std::to_string(ref.total));
+
+    ResultadoCombinado out;
+    const size_t n = ref.datas.size();
+    for (size_t d = 0; d < n; ++d) out.dias.push_back({ref.datas[d], ref.meses[d], 0.0, 0.0});
+    out.resultados.resize(n);
+    const PlanoAnalise plano = planejar_analise(ref.fases);
+    for (auto& p : parciais) {
+        for (size_t j = 0; j < p.dias_iniciais.size(); ++j) {
+            const int d = p.dias_iniciais[j];
+            out.resultados[d] = finalizar_contagem(p.contagens[j], plano);
+            out.resultados[d].data_str = ref.datas[d];
+        }
+    }
+    return out;
+}
+
+} // namespace model::viab
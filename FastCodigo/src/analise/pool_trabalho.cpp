@@ -0,0 +1,172 @@
+#include "../model/viab/pool_trabalho.h"
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <omp.h>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace model::viab {
+
+namespace {
+
+// Iterações de espera ativa antes de dormir na variável de condição
+constexpr int GIROS_ESPERA = 2000;
+
+// Verdadeiro dentro de um trabalhador ou de um chamador com tarefa em curso
+thread_local bool em_tarefa = false;
+
+template <typename Pronto>
+void girar(Pronto pronto) {
+    for (int i = 0; i < GIROS_ESPERA && !pronto(); ++i) std::this_thread::yield();
+}
+
+// Espera por prazo no relógio estável: não depende da versão de condition_variable::wait
+// da libstdc++ carregada em tempo de execução (a biblioteca é embutida em outros processos)
+template <typename Pronto>
+void esperar(std::condition_variable& cv, std::unique_lock<std::mutex>& l, Pronto pronto) {
+    while (!pronto()) cv.wait_until(l, std::chrono::steady_clock::now() + std::chrono::seconds(1));
+}
+
+#if defined(__linux__)
+std::vector<int> cpus_permitidas() {
+    std::vector<int> cpus;
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    if (sched_getaffinity(0, sizeof(conjunto), &conjunto) != 0) return cpus;
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+        if (CPU_ISSET(c, &conjunto)) cpus.push_back(c);
+    return cpus;
+}
+
+// Trabalhador k de um pool com `threads` threads (o chamador é a thread 0)
+void fixar(std::thread& t, Afinidade afinidade, int k, int threads, const std::vector<int>& cpus) {
+    if (afinidade == Afinidade::Nenhuma || cpus.empty()) return;
+    const size_t m = cpus.size();
+    const size_t posicao = afinidade == Afinidade::Compacta
+        ? static_cast<size_t>(k) % m
+        : static_cast<size_t>(k) * m / static_cast<size_t>(threads) % m;
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpus[posicao], &conjunto);
+    pthread_setaffinity_np(t.native_handle(), sizeof(conjunto), &conjunto);   // falha = sem fixação
+}
+#endif
+
+std::mutex mutex_global;
+std::unique_ptr<PoolTrabalho> pool_global;
+
+} // namespace
+
+Afinidade afinidade_de_texto(const std::string& texto) {
+    if (texto == "nenhuma") return Afinidade::Nenhuma;
+    if (texto == "compacta") return Afinidade::Compacta;
+    if (texto == "espalhada") return Afinidade::Espalhada;
+    throw std::invalid_argument("Afinidade inválida: " + texto + " (use nenhuma, compacta ou espalhada)");
+}
+
+PoolTrabalho::PoolTrabalho(const ConfiguracaoPool& configuracao) : configuracao_(configuracao) {
+    if (configuracao_.threads <= 0) configuracao_.threads = omp_get_max_threads();
+    const int threads = configuracao_.threads;
+#if defined(__linux__)
+    const auto cpus = cpus_permitidas();
+#endif
+    trabalhadores_.reserve(threads - 1);
+    for (int k = 1; k < threads; ++k) {
+        trabalhadores_.emplace_back(&PoolTrabalho::trabalhar, this, k);
+#if defined(__linux__)
+        fixar(trabalhadores_.back(), configuracao_.afinidade, k, threads, cpus);
+#endif
+    }
+}
+
+PoolTrabalho::~PoolTrabalho() {
+    {
+        std::lock_guard<std::mutex> l(m_);
+        parar_ = true;
+    }
+    cv_tarefa_.notify_all();
+    for (auto& t : trabalhadores_) t.join();
+}
+
+void PoolTrabalho::executar() {
+    for (;;) {
+        const std::size_t i = proximo_.fetch_add(1);
+        if (i >= total_) return;
+        try {
+            (*corpo_)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> l(m_erro_);
+            if (!erro_) erro_ = std::current_exception();
+            proximo_ = total_;
+        }
+    }
+}
+
+void PoolTrabalho::trabalhar(int) {
+    em_tarefa = true;   // laços aninhados num trabalhador rodam em série
+    std::uint64_t visto = 0;
+    for (;;) {
+        girar([&] { return parar_ || geracao_ != visto; });
+        {
+            std::unique_lock<std::mutex> l(m_);
+            esperar(cv_tarefa_, l, [&] { return parar_ || geracao_ != visto; });
+        }
+        if (parar_) return;
+        visto = geracao_;
+        executar();
+        if (pendentes_.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> l(m_);
+            cv_fim_.notify_one();
+        }
+    }
+}
+
+void PoolTrabalho::para_cada(std::size_t n, const std::function<void(std::size_t)>& corpo) {
+    if (n == 0) return;
+    std::unique_lock<std::mutex> envio(envio_, std::defer_lock);
+    if (trabalhadores_.empty() || n == 1 || em_tarefa || !envio.try_lock()) {
+        for (std::size_t i = 0; i < n; ++i) corpo(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> l(m_);
+        corpo_ = &corpo;
+        total_ = n;
+        proximo_ = 0;
+        erro_ = nullptr;
+        pendentes_ = static_cast<int>(trabalhadores_.size());
+        ++geracao_;
+    }
+    cv_tarefa_.notify_all();
+
+    em_tarefa = true;
+    executar();
+    em_tarefa = false;
+
+    girar([&] { return pendentes_ == 0; });
+    {
+        std::unique_lock<std::mutex> l(m_);
+        esperar(cv_fim_, l, [&] { return pendentes_ == 0; });
+        corpo_ = nullptr;
+    }
+    if (erro_) std::rethrow_exception(std::exchange(erro_, nullptr));
+}
+
+PoolTrabalho& pool_trabalho() {
+    std::lock_guard<std::mutex> l(mutex_global);
+    if (!pool_global) pool_global = std::make_unique<PoolTrabalho>();
+    return *pool_global;
+}
+
+void configurar_pool(const ConfiguracaoPool& configuracao) {
+    std::lock_guard<std::mutex> l(mutex_global);
+    pool_global.reset();
+    pool_global = std::make_unique<PoolTrabalho>(configuracao);
+}
+
+} // namespace model::viab
@@ -0,0 +1,45 @@
+#include "../model/viab/precisao.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace model::viab {
+
+ValidacaoPrecisao comparar_precisao(const std::vector<ResultadoData>& referencia,
+                                    const std::vector<ResultadoData>& avaliado) {
+    if (referencia.size() != avaliado.size())
+        throw std::invalid_argument("Resultados de séries com tamanhos diferentes");
+
+    struct Campo {
+        const char* nome;
+        double (*valor)(const ResultadoData&);
+    };
+    static const Campo CAMPOS[] = {
+        {"probabilidade_viabilidade", [](const ResultadoData& r) { return r.prob_viabilidade; }},
+        {"rendimento_medio",          [](const ResultadoData& r) { return r.rendimento_medio; }},
+        {"prob_esbranquiamento",      [](const ResultadoData& r) { return r.prob_esbranquiamento; }},
+        {"prob_reducao_moagem",       [](const ResultadoData& r) { return r.prob_reducao_moagem; }},
+        {"prob_optimo",               [](const ResultadoData& r) { return r.prob_optimo; }},
+        {"total_caminhos",  [](const ResultadoData& r) { return r.total_caminhos.aproximado(); }},
+        {"caminhos_viaveis", [](const ResultadoData& r) { return static_cast<double>(r.caminhos_viaveis); }},
+    };
+
+    ValidacaoPrecisao v;
+    for (auto& c : CAMPOS) v.campos.push_back({c.nome, 0.0, -1});
+    for (size_t d = 0; d < referencia.size(); ++d) {
+        if (referencia[d].data_str != avaliado[d].data_str)
+            throw std::invalid_argument("Datas diferentes na posição " + std::to_string(d));
+        bool diverge = false;
+        for (size_t k = 0; k < v.campos.size(); ++k) {
+            const double desvio = std::fabs(CAMPOS[k].valor(referencia[d]) - CAMPOS[k].valor(avaliado[d]));
+            if (desvio > 0.0) diverge = true;
+            if (desvio > v.campos[k].desvio_max) {
+                v.campos[k].desvio_max = desvio;
+                v.campos[k].dia = static_cast<int>(d);
+            }
+        }
+        v.dias_divergentes += diverge;
+    }
+    return v;
+}
+
+} // namespace model::viab
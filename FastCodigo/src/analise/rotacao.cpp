@@ -0,0 +1,69 @@
+#include "../model/viab/rotacao.h"
+#include "../model/viab/duracao_ponderada.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace model::viab {
+
+std::vector<ResultadoRotacao> rodar_analise_rotacao(const std::vector<Dia>& dias,
+                                                    const std::vector<Fase>& primeira,
+                                                    const std::vector<Fase>& segunda,
+                                                    IntervaloRotacao intervalo,
+                                                    std::uint64_t semente) {
+    if (intervalo.minimo < 0 || intervalo.maximo < intervalo.minimo)
+        throw std::invalid_argument("Intervalo de rotação inválido: " + std::to_string(intervalo.minimo) +
+                                    "-" + std::to_string(intervalo.maximo));
+    for (auto* fases : {&primeira, &segunda})
+        for (auto& f : *fases)
+            if (f.durMin > f.durMax)
+                throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+    const int n = static_cast<int>(dias.size());
+    std::vector<ResultadoRotacao> resultados(n);
+    for (int d = 0; d < n; ++d) resultados[d].data_str = dias[d].data_str;
+    if (n == 0 || primeira.empty() || segunda.empty()) return resultados;
+
+    // Segunda safra por dia de semeadura, em somas prefixadas de P, P · rendimento e s · P
+    const auto unica = rodar_analise_ponderada(dias, segunda, semente);
+    std::vector<double> prob_b(n + 1, 0.0), rend_b(n + 1, 0.0), dia_b(n + 1, 0.0);
+    for (int s = 0; s < n; ++s) {
+        const double p = unica[s].prob_viabilidade;
+        prob_b[s + 1] = prob_b[s] + p;
+        rend_b[s + 1] = rend_b[s] + p * unica[s].rendimento_medio;
+        dia_b[s + 1] = dia_b[s] + p * s;
+    }
+    const double por_intervalo = 1.0 / (intervalo.maximo - intervalo.minimo + 1);
+
+    const PlanoAnalise plano = planejar_analise(primeira);
+    const auto tabelas = construir_tabelas(dias, primeira);
+    paralelo_para(0, n - plano.dias_min + 1, [&](int d) {
+        if (!pode_ser_viavel(tabelas, primeira, n, d)) return;
+        const TerminosDia t = terminos_dia(tabelas, primeira, n, d, semente);
+        double prob_a = 0.0, conjunta = 0.0, soma_a = 0.0, soma_b = 0.0, soma_dias = 0.0;
+        for (int off = t.lo; off <= t.hi; ++off) {
+            if (t.prob[off] == 0.0) continue;
+            prob_a += t.prob[off];
+            const int lo = d + off + intervalo.minimo;
+            if (lo >= n) continue;
+            const int hi = std::min(d + off + intervalo.maximo, n - 1);
+            const double pb = (prob_b[hi + 1] - prob_b[lo]) * por_intervalo;
+            conjunta += t.prob[off] * pb;
+            soma_a += t.rendimento[off] * pb;
+            soma_b += t.prob[off] * (rend_b[hi + 1] - rend_b[lo]) * por_intervalo;
+            soma_dias += t.prob[off] * ((dia_b[hi + 1] - dia_b[lo]) * por_intervalo - d * pb);
+        }
+        auto& out = resultados[d];
+        out.prob_viabilidade_primeira = prob_a;
+        out.prob_viabilidade_conjunta = conjunta;
+        if (conjunta > 0.0) {
+            out.rendimento_primeira = soma_a / conjunta;
+            out.rendimento_segunda  = soma_b / conjunta;
+            out.rendimento_conjunto = (soma_a + soma_b) / conjunta;
+            out.dias_ate_segunda    = soma_dias / conjunta;
+        }
+    });
+    return resultados;
+}
+
+} // namespace model::viab
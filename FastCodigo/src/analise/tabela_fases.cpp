@@ -0,0 +1,74 @@
+#include "../model/viab/tabela_fases.h"
+#include "../model/viab/analise_viabilidade.h"
+
+namespace model::viab {
+
+namespace {
+
+// `dia_em(d)` devolve o Dia d (por referência ou valor)
+template <typename Real, typename ObterDia>
+std::vector<TabelaFaseT<Real>> construir(size_t n, const std::vector<Fase>& fases, ObterDia&& dia_em) {
+    const AnalysisConfig cfg;
+    std::vector<TabelaFaseT<Real>> tabelas(fases.size());
+
+    for (size_t f = 0; f < fases.size(); ++f) {
+        auto& t = tabelas[f];
+        t.inviaveis.assign(n + 1, 0);
+        t.nao_ideais.assign(n + 1, 0);
+        t.penalidade.assign(n + 1, Real(0));
+        t.esbranq.assign(n + 1, 0);
+        t.reducao.assign(n + 1, 0);
+        t.proximo_inviavel.assign(n + 1, static_cast<int>(n));
+
+        // Em float, prefixo relativo à base do bloco (ver TabelaFaseT)
+        constexpr bool em_blocos = std::is_same_v<Real, float>;
+        if (em_blocos) t.base_penalidade.assign(n / DIAS_BLOCO_PENALIDADE + 1, 0.0);
+        double penalidade = 0.0;
+        for (size_t d = 0; d < n; ++d) {
+            auto res = avaliar_dia(dia_em(d), fases[f], cfg);
+            penalidade += res.penalidade_dia + res.penalidade_noite;
+            double base = 0.0;
+            if (em_blocos) {
+                const size_t bloco = (d + 1) / DIAS_BLOCO_PENALIDADE;
+                if ((d + 1) % DIAS_BLOCO_PENALIDADE == 0) t.base_penalidade[bloco] = penalidade;
+                base = t.base_penalidade[bloco];
+            }
+            t.inviaveis[d + 1]  = t.inviaveis[d]  + !res.viavel;
+            t.nao_ideais[d + 1] = t.nao_ideais[d] + !res.ideal;
+            t.penalidade[d + 1] = static_cast<Real>(penalidade - base);
+            t.esbranq[d + 1]    = t.esbranq[d]    + res.risco_esbranq;
+            t.reducao[d + 1]    = t.reducao[d]    + res.risco_reducao;
+        }
+        // Varredura reversa: próximo dia inviável a partir de cada posição
+        for (size_t d = n; d-- > 0;) {
+            bool inviavel = t.inviaveis[d + 1] != t.inviaveis[d];
+            t.proximo_inviavel[d] = inviavel ? static_cast<int>(d) : t.proximo_inviavel[d + 1];
+        }
+    }
+    return tabelas;
+}
+
+} // namespace
+
+std::vector<TabelaFase> construir_tabelas(const std::vector<Dia>& dias,
+                                          const std::vector<Fase>& fases) {
+    return construir<double>(dias.size(), fases, [&](size_t d) -> const Dia& { return dias[d]; });
+}
+
+std::vector<TabelaFase> construir_tabelas(const double* tmax, const double* tmin, size_t n,
+                                          const std::vector<Fase>& fases) {
+    return construir<double>(n, fases, [&](size_t d) { return Dia{std::string(), 0, tmax[d], tmin[d]}; });
+}
+
+template <typename Real>
+std::vector<TabelaFaseT<Real>> construir_tabelas_em(const std::vector<Dia>& dias,
+                                                   const std::vector<Fase>& fases) {
+    return construir<Real>(dias.size(), fases, [&](size_t d) -> const Dia& { return dias[d]; });
+}
+
+template std::vector<TabelaFaseT<float>> construir_tabelas_em<float>(const std::vector<Dia>&,
+                                                                     const std::vector<Fase>&);
+template std::vector<TabelaFaseT<double>> construir_tabelas_em<double>(const std::vector<Dia>&,
+                                                                       const std::vector<Fase>&);
+
+} // namespace model::viab
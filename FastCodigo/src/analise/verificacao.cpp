@@ -0,0 +1,199 @@
+#include "../model/viab/verificacao.h"
+#include "../model/viab/amostragem.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace model::viab {
+
+ReferenciaDia referencia_dia(const std::vector<Dia>& dias, const std::vector<Fase>& fases, int inicio,
+                             long long limite_exato, long long amostras, std::uint64_t semente) {
+    const size_t P = fases.size();
+    // Probabilidade de cada duração, por fase
+    std::vector<std::vector<double>> prob(P);
+    for (size_t i = 0; i < P; ++i) {
+        const Fase& f = fases[i];
+        const int faixa = f.durMax - f.durMin + 1;
+        if (f.pesos.empty()) {
+            prob[i].assign(faixa, 1.0 / faixa);
+        } else {
+            double soma = 0.0;
+            for (double p : f.pesos) soma += p;
+            for (double p : f.pesos) prob[i].push_back(p / soma);
+        }
+    }
+
+    const TotalCaminhos caminhos = contar_caminhos(fases);
+    ReferenciaDia out;
+    ResultadoData& r = out.resultado;
+    r.data_str = dias[inicio].data_str;
+    r.total_caminhos = caminhos;
+
+    double viavel = 0.0, soma_rend = 0.0, soma_rend2 = 0.0, ideal = 0.0, esb = 0.0, red = 0.0;
+    long long contagem = 0;
+    std::vector<int> comb(P);
+    auto avaliar = [&](double w) {
+        double pd, pn;
+        bool r_esb, r_red, seq_ideal;
+        if (!avaliar_sequencia(dias, static_cast<size_t>(inicio), fases, comb, AnalysisConfig(),
+                               pd, pn, r_esb, r_red, seq_ideal))
+            return;
+        const double rend = std::max(0.0, 1.0 - (pd + pn));
+        ++contagem;
+        viavel += w;
+        soma_rend += w * rend;
+        soma_rend2 += w * rend * rend;
+        ideal += seq_ideal ? w : 0.0;
+        esb += r_esb ? w : 0.0;
+        red += r_red ? w : 0.0;
+    };
+
+    out.exata = !caminhos.excede_128 && caminhos.exato <= static_cast<Contagem128>(limite_exato);
+    if (out.exata) {
+        out.avaliados = caminhos.saturado();
+        for (long long idx = 0; idx < out.avaliados; ++idx) {
+            gerar_combinacao_por_indice(comb, fases, idx);
+            double w = 1.0;
+            for (size_t i = 0; i < P; ++i) w *= prob[i][comb[i] - fases[i].durMin];
+            avaliar(w);
+        }
+        r.caminhos_viaveis = contagem;
+    } else {
+        std::mt19937_64 gen(semente);
+        std::vector<std::discrete_distribution<int>> sorteio;
+        for (auto& p : prob) sorteio.emplace_back(p.begin(), p.end());
+        out.avaliados = amostras;
+        for (long long s = 0; s < amostras; ++s) {
+            for (size_t i = 0; i < P; ++i) comb[i] = fases[i].durMin + sorteio[i](gen);
+            avaliar(1.0 / amostras);
+        }
+        r.caminhos_viaveis = escalar_caminhos(viavel, caminhos);
+    }
+
+    if (viavel > 0.0) {
+        r.prob_viabilidade     = viavel;
+        r.rendimento_medio     = soma_rend / viavel;
+        r.prob_optimo          = ideal;
+        r.prob_esbranquiamento = esb / viavel;
+        r.prob_reducao_moagem  = red / viavel;
+        out.desvio_rendimento  = std::sqrt(std::max(0.0, soma_rend2 / viavel - r.rendimento_medio * r.rendimento_medio));
+    }
+    return out;
+}
+
+namespace {
+
+// Variância de uma média de N observações com variância unitária v (0 = estimativa exata)
+double variancia_media(double v, double N) {
+    return N > 0.0 ? v / N : 0.0;
+}
+
+VerificacaoDia comparar_dia(const ResultadoData& p, const ReferenciaDia& ref,
+                            const ConfiguracaoVerificacao& cfg) {
+    const ResultadoData& r = ref.resultado;
+    const double n_prod = cfg.producao_amostrada ? static_cast<double>(cfg.amostras_producao) : 0.0;
+    const double n_ref = ref.exata ? 0.0 : static_cast<double>(ref.avaliados);
+
+    VerificacaoDia v;
+    v.data_str = r.data_str;
+    v.exata = ref.exata;
+    v.avaliados = ref.avaliados;
+    auto comparar = [&](const char* campo, double x_prod, double x_ref, double var_prod, double var_ref) {
+        ComparacaoCampo c{campo, x_prod, x_ref, std::sqrt(var_prod + var_ref), true};
+        const double diferenca = std::fabs(x_prod - x_ref);
+        c.concorda = diferenca <= cfg.tolerancia || (c.erro_padrao > 0.0 && diferenca <= cfg.z_limite * c.erro_padrao);
+        v.campos.push_back(c);
+    };
+    // Variância de Bernoulli comum aos dois lados: a maior entre as proporções de
+    // [x_prod, x_ref], para que p = 0 amostrado contra p > 0 raro não zere o erro padrão
+    auto bernoulli = [](double x_prod, double x_ref) {
+        const double x = std::clamp(0.5, std::min(x_prod, x_ref), std::max(x_prod, x_ref));
+        return x * (1.0 - x);
+    };
+    // Proporção sobre todos os caminhos
+    auto proporcao = [&](const char* campo, double x_prod, double x_ref) {
+        const double vu = bernoulli(x_prod, x_ref);
+        comparar(campo, x_prod, x_ref, variancia_media(vu, n_prod), variancia_media(vu, n_ref));
+    };
+    // Média sobre os caminhos viáveis, com variância unitária vu
+    auto condicional = [&](const char* campo, double x_prod, double x_ref, double vu) {
+        comparar(campo, x_prod, x_ref, variancia_media(vu, p.prob_viabilidade * n_prod),
+                 variancia_media(vu, r.prob_viabilidade * n_ref));
+    };
+    const double var_rend = ref.desvio_rendimento * ref.desvio_rendimento;
+
+    proporcao("probabilidade_viabilidade", p.prob_viabilidade, r.prob_viabilidade);
+    // Sem caminho viável de um lado amostrado, as médias condicionais não são comparáveis
+    if ((p.prob_viabilidade > 0.0 && r.prob_viabilidade > 0.0) || (n_prod == 0.0 && n_ref == 0.0)) {
+        condicional("rendimento_medio", p.rendimento_medio, r.rendimento_medio, var_rend);
+        condicional("prob_esbranquiamento", p.prob_esbranquiamento, r.prob_esbranquiamento,
+                    bernoulli(p.prob_esbranquiamento, r.prob_esbranquiamento));
+        condicional("prob_reducao_moagem", p.prob_reducao_moagem, r.prob_reducao_moagem,
+                    bernoulli(p.prob_reducao_moagem, r.prob_reducao_moagem));
+    }
+    proporcao("prob_optimo", p.prob_optimo, r.prob_optimo);
+    comparar("total_caminhos", p.total_caminhos.aproximado(), r.total_caminhos.aproximado(), 0, 0);
+    if (n_prod == 0.0 && n_ref == 0.0)
+        comparar("caminhos_viaveis", static_cast<double>(p.caminhos_viaveis),
+                 static_cast<double>(r.caminhos_viaveis), 0, 0);
+    return v;
+}
+
+} // namespace
+
+std::vector<VerificacaoDia> verificar_resultados(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                                                 const std::vector<ResultadoData>& producao,
+                                                 const ConfiguracaoVerificacao& cfg) {
+    if (producao.size() != dias.size())
+        throw std::invalid_argument("Verificação exige um resultado de produção por dia da série");
+    std::vector<VerificacaoDia> out;
+    if (cfg.dias <= 0 || fases.empty()) return out;
+
+    // Dias iniciais com ciclo completo; metade da amostra sai dos viáveis na produção
+    const int n = static_cast<int>(dias.size());
+    int dias_min = 0;
+    for (auto& f : fases) dias_min += f.durMin;
+    std::vector<int> todos, viaveis;
+    for (int d = 0; d + dias_min <= n; ++d) {
+        todos.push_back(d);
+        if (producao[d].prob_viabilidade > 0.0) viaveis.push_back(d);
+    }
+    std::mt19937_64 gen(cfg.semente);
+    std::vector<char> escolhido(n, 0);
+    std::vector<int> dias_verificados;
+    auto sortear = [&](std::vector<int>& candidatos, size_t k) {
+        for (size_t i = 0; i < candidatos.size() && dias_verificados.size() < k; ++i) {
+            std::swap(candidatos[i], candidatos[std::uniform_int_distribution<size_t>(i, candidatos.size() - 1)(gen)]);
+            if (escolhido[candidatos[i]]) continue;
+            escolhido[candidatos[i]] = 1;
+            dias_verificados.push_back(candidatos[i]);
+        }
+    };
+    const size_t k = static_cast<size_t>(cfg.dias);
+    sortear(viaveis, (k + 1) / 2);
+    sortear(todos, k);
+    std::sort(dias_verificados.begin(), dias_verificados.end());
+
+    // Referência lenta: um dia inicial por tarefa do pool
+    out.resize(dias_verificados.size());
+    paralelo_para(dias_verificados.size(), [&](size_t j) {
+        const int d = dias_verificados[j];
+        const ReferenciaDia ref = referencia_dia(dias, fases, d, cfg.limite_exato, cfg.amostras,
+                                                 semente_dia(~cfg.semente, static_cast<std::uint64_t>(d)));
+        out[j] = comparar_dia(producao[d], ref, cfg);
+        out[j].dia = d;
+    });
+    return out;
+}
+
+int contar_discordancias(const std::vector<VerificacaoDia>& verificacao) {
+    int total = 0;
+    for (auto& v : verificacao)
+        for (auto& c : v.campos) total += !c.concorda;
+    return total;
+}
+
+} // namespace model::viab
@@ -0,0 +1,149 @@
+#include "../model/viab/analise_viabilidade.h"
+#include "../model/viab/kernel_especializado.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include "../model/viab/tabela_fases.h"
+#include "../model/io/csv_reader.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace model;
+
+// Série sintética determinística (ciclo anual + oscilação curta), formato DD/MM/AAAA
+static std::vector<viab::Dia> gerar_serie(int n) {
+    std::vector<viab::Dia> dias;
+    dias.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        double sazonal = 2.5 * std::cos(2.0 * M_PI * i / 365.0);
+        double ruido = 1.5 * std::sin(i * 0.7);
+        viab::Dia d;
+        int mes = (i / 30) % 12 + 1;
+        d.data_str = std::to_string(i % 28 + 1) + "/" + std::to_string(mes) + "/2023";
+        d.mes = mes;
+        d.tmax = 27.0 + sazonal + ruido;
+        d.tmin = 23.0 + sazonal / 2 - ruido / 3;
+        dias.push_back(d);
+    }
+    return dias;
+}
+
+template <typename F>
+static double medir_ms(F&& f) {
+    auto ini = std::chrono::high_resolution_clock::now();
+    f();
+    auto fim = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(fim - ini).count();
+}
+
+/**
+ * Muitas análises pequenas em sequência (uso embutido, grade célula a célula):
+ * a mesma avaliação por dia com uma região OpenMP por chamada e com o pool
+ * persistente. Retorna {ms OpenMP, ms pool} e confere se os resultados coincidem.
+ */
+static std::pair<double, double> medir_analises_pequenas(const std::vector<viab::Dia>& base,
+                                                         const std::vector<viab::Fase>& fases,
+                                                         int analises, bool& iguais) {
+    const viab::PlanoAnalise plano = viab::planejar_analise(fases);
+    const int n = std::min(static_cast<int>(base.size()), plano.dias_min + 8);
+    std::vector<std::vector<viab::TabelaFase>> tabelas;
+    for (int a = 0; a < analises; ++a) {
+        const int desloc = a % std::max(1, static_cast<int>(base.size()) - n + 1);
+        tabelas.push_back(viab::construir_tabelas(
+            std::vector<viab::Dia>(base.begin() + desloc, base.begin() + desloc + n), fases));
+    }
+    std::vector<int> inicios;
+    for (int d = 0; d + plano.dias_min <= n; ++d) inicios.push_back(d);
+
+    std::vector<double> omp(analises * inicios.size()), pool(omp.size());
+    auto avaliar = [&](const std::vector<viab::TabelaFase>& t, int d) {
+        const viab::ContagemDia c = plano.usar_amostragem
+            ? viab::amostrar_dia(t, fases, n, d, plano.amostras, viab::semente_dia(0, d))
+            : viab::enumerar_dia(t, fases, n, d);
+        return c.amostras > 0 ? c.soma_rend / c.amostras : 0.0;
+    };
+    const double t_omp = medir_ms([&] {
+        for (int a = 0; a < analises; ++a) {
+            const int k = static_cast<int>(inicios.size());
+            #pragma omp parallel for schedule(dynamic)
+            for (int j = 0; j < k; ++j) omp[a * k + j] = avaliar(tabelas[a], inicios[j]);
+        }
+    });
+    const double t_pool = medir_ms([&] {
+        for (int a = 0; a < analises; ++a) {
+            const size_t k = inicios.size();
+            viab::paralelo_para(k, [&](size_t j) { pool[a * k + j] = avaliar(tabelas[a], inicios[j]); });
+        }
+    });
+    iguais = omp == pool;
+    return {t_omp, t_pool};
+}
+
+/**
+ * Compara o caminho genérico (rodar_analise), o motor de tabelas em tempo de
+ * execução (rodar_analise_tabelas) e o kernel especializado da cultivar
+ * "default" sobre a mesma série; kernel × tabelas isola o ganho da
+ * especialização em compilação do ganho das somas prefixadas. Mede também a
+ * latência de muitas análises pequenas (região OpenMP por chamada × pool
+ * persistente).
+ *
+ * Uso: bench_analise [arquivo_entrada.csv | -] [num_dias] [num_analises_pequenas]
+ */
+int main(int argc, char** argv) {
+    if (!viab::cultivar_embutida("default")) {
+        std::cerr << "Compilado sem RICEGUARD_CATALOGOS_EMBUTIDOS.\n";
+        return 1;
+    }
+    std::vector<viab::Dia> dias;
+    int num_dias = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (argc > 1 && std::string(argv[1]) != "-") {
+        dias = io::ler_dados(argv[1]);
+        if (num_dias > 0 && static_cast<size_t>(num_dias) < dias.size())
+            dias.resize(num_dias);
+    } else {
+        dias = gerar_serie(num_dias);
+    }
+
+    const auto fases = viab::fases_cultivar("default");
+    std::vector<viab::ResultadoData> generico, tabelas, especializado;
+    double t_gen = medir_ms([&] { generico = viab::rodar_analise(dias, fases); });
+    double t_tab = medir_ms([&] { tabelas = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla); });
+    double t_esp = medir_ms([&] { especializado = viab::rodar_analise_cultivar(dias, "default"); });
+
+    double max_dif = 0.0;
+    long long dif_contagem = 0, dias_viaveis = 0;
+    for (size_t i = 0; i < dias.size(); ++i) {
+        dias_viaveis += especializado[i].caminhos_viaveis > 0;
+        max_dif = std::max(max_dif, std::abs(generico[i].rendimento_medio - especializado[i].rendimento_medio));
+        max_dif = std::max(max_dif, std::abs(generico[i].prob_viabilidade - especializado[i].prob_viabilidade));
+        max_dif = std::max(max_dif, std::abs(tabelas[i].rendimento_medio - especializado[i].rendimento_medio));
+        dif_contagem += generico[i].caminhos_viaveis != especializado[i].caminhos_viaveis;
+        dif_contagem += tabelas[i].caminhos_viaveis != especializado[i].caminhos_viaveis;
+    }
+
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "\nDias: " << dias.size() << " (" << dias_viaveis << " com caminhos viáveis)\n"
+              << "Genérico:      " << t_gen << " ms\n"
+              << "Tabelas:       " << t_tab << " ms\n"
+              << "Especializado: " << t_esp << " ms\n"
+              << "Speedup (kernel × genérico): " << t_gen / t_esp << "x\n"
+              << "Speedup (kernel × tabelas):  " << t_tab / t_esp << "x\n"
+              << "Maior diferença (prob/rendimento): " << max_dif << "\n"
+              << "Dias com contagem divergente: " << dif_contagem << "\n";
+
+    const int analises = argc > 3 ? std::atoi(argv[3]) : 200;
+    bool iguais = true;
+    viab::pool_trabalho();   // criação das threads fora da medição, como num processo de longa duração
+    const auto [t_omp, t_pool] = medir_analises_pequenas(dias, fases, analises, iguais);
+    std::cout << "\nAnálises pequenas: " << analises << " (" << viab::pool_trabalho().threads() << " threads)\n"
+              << "Região OpenMP por chamada: " << t_omp / analises << " ms/análise\n"
+              << "Pool persistente:          " << t_pool / analises << " ms/análise\n"
+              << "Speedup:                   " << t_omp / t_pool << "x\n"
+              << "Resultados iguais: " << (iguais ? "sim" : "não") << "\n";
+    return dif_contagem == 0 && iguais ? 0 : 1;
+}
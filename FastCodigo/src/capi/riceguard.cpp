@@ -0,0 +1,173 @@
+#include "riceguard.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/pool_trabalho.h"
+#include "../model/summary/graficos.h"
+#include <climits>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+thread_local std::string ultimo_erro;
+
+int32_t falhar(int32_t codigo, const std::string& mensagem) {
+    ultimo_erro = mensagem;
+    return codigo;
+}
+
+// Datas AAAAMMDD válidas e consecutivas
+bool datas_consecutivas(const int32_t* datas, int64_t n, std::string& erro) {
+    using model::summary::Data;
+    using model::summary::dias_no_mes;
+    Data anterior{};
+    for (int64_t i = 0; i < n; ++i) {
+        Data d{datas[i] / 10000, datas[i] / 100 % 100, datas[i] % 100};
+        if (d.mes < 1 || d.mes > 12 || d.dia < 1 || d.dia > dias_no_mes(d.ano, d.mes)) {
+            erro = "Data inválida na posição " + std::to_string(i) + ": " + std::to_string(datas[i]);
+            return false;
+        }
+        if (i > 0) {
+            Data esperado = anterior;
+            if (++esperado.dia > dias_no_mes(esperado.ano, esperado.mes)) {
+                esperado.dia = 1;
+                if (++esperado.mes > 12) {
+                    esperado.mes = 1;
+                    ++esperado.ano;
+                }
+            }
+            if (d.ano != esperado.ano || d.mes != esperado.mes || d.dia != esperado.dia) {
+                erro = "Datas não consecutivas na posição " + std::to_string(i);
+                return false;
+            }
+        }
+        anterior = d;
+    }
+    return true;
+}
+
+static_assert(RG_NUM_METRICAS == model::summary::NUM_METRICAS, "Métricas da ABI desalinhadas");
+static_assert(RG_PONTOS_MAX_GRAFICO == model::summary::PONTOS_MAX_GRAFICO, "Pontos da ABI desalinhados");
+
+// Séries dos gráficos (mesmo cálculo do grafico_*.csv) nos buffers da ABI
+void preencher_graficos(const std::vector<model::viab::ResultadoData>& resultados, rg_graficos& saida) {
+    using namespace model::summary;
+    const auto series = gerar_series_grafico(resultados);
+    for (int mes = 0; mes < 12; ++mes) {
+        rg_mes_grafico& m = saida.mensal[mes];
+        m.dias = static_cast<int32_t>(series.mensal[mes][0].n);
+        for (int k = 0; k < NUM_METRICAS; ++k) {
+            const auto f = faixa_mensal(series.mensal[mes][k]);
+            m.media[k] = f.media;
+            m.inferior[k] = f.inferior;
+            m.superior[k] = f.superior;
+        }
+    }
+    saida.num_pontos = static_cast<int32_t>(series.evolucao.size());
+    for (size_t i = 0; i < series.evolucao.size(); ++i) {
+        const auto& p = series.evolucao[i];
+        rg_ponto_evolucao& e = saida.evolucao[i];
+        e.data = p.data.ano * 10000 + p.data.mes * 100 + p.data.dia;
+        for (int k = 0; k < 2; ++k) {
+            e.media[k] = p.media[k];
+            e.inferior[k] = p.inferior[k];
+            e.superior[k] = p.superior[k];
+        }
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+int32_t rg_versao_abi(void) {
+    return RG_ABI_VERSAO;
+}
+
+int32_t rg_configurar_threads(int32_t threads, int32_t afinidade) {
+    using model::viab::Afinidade;
+    if (afinidade < RG_AFINIDADE_NENHUMA || afinidade > RG_AFINIDADE_ESPALHADA)
+        return falhar(RG_ERRO_ARGUMENTO, "Afinidade inválida: " + std::to_string(afinidade));
+    try {
+        const Afinidade tipos[] = {Afinidade::Nenhuma, Afinidade::Compacta, Afinidade::Espalhada};
+        model::viab::configurar_pool({threads, tipos[afinidade]});
+        return RG_OK;
+    } catch (const std::exception& e) {
+        return falhar(RG_ERRO_INTERNO, e.what());
+    }
+}
+
+const char* rg_ultimo_erro(void) {
+    return ultimo_erro.c_str();
+}
+
+int32_t rg_analisar(const double* tmax, const double* tmin, int64_t n,
+                    const rg_fase* fases, int32_t num_fases, uint64_t semente,
+                    rg_resultados* saida, const int32_t* datas, rg_graficos* graficos) {
+    using namespace model::viab;
+    ultimo_erro.clear();
+    if (n < 0 || num_fases <= 0 || !fases || !saida || (n > 0 && (!tmax || !tmin)))
+        return falhar(RG_ERRO_ARGUMENTO, "Argumentos nulos ou tamanhos inválidos");
+    if (n > INT_MAX)
+        return falhar(RG_ERRO_ARGUMENTO, "Série com mais de " + std::to_string(INT_MAX) + " dias");
+    if (graficos && n > 0 && !datas)
+        return falhar(RG_ERRO_ARGUMENTO, "Séries de gráfico exigem as datas");
+
+    try {
+        std::string erro;
+        if (graficos && !datas_consecutivas(datas, n, erro))
+            return falhar(RG_ERRO_DATAS, erro);
+
+        std::vector<Fase> vfases;
+        vfases.reserve(num_fases);
+        for (int32_t i = 0; i < num_fases; ++i) {
+            const rg_fase& f = fases[i];
+            if (f.dur_min < 0)
+                return falhar(RG_ERRO_ARGUMENTO, "DurMin negativa em fase " + std::to_string(i));
+            if (f.dur_min > f.dur_max)
+                return falhar(RG_ERRO_ARGUMENTO, "DurMin > DurMax em fase " + std::to_string(i));
+            vfases.emplace_back(f.nome ? f.nome : "", f.min_t, f.max_t, f.opt_min_t, f.opt_max_t,
+                                f.dur_min, f.dur_max);
+        }
+
+        const int ni = static_cast<int>(n);
+        const auto plano = planejar_analise(vfases);
+        const auto tabelas = construir_tabelas(tmax, tmin, static_cast<size_t>(n), vfases);
+        std::vector<ResultadoData> resultados(graficos ? n : 0);   // com data_str, só para os gráficos
+
+        paralelo_para(0, ni, [&](int dia0) {
+            ResultadoData r;
+            if (ni - dia0 >= plano.dias_min) {
+                ContagemDia c;
+                c.amostras = plano.amostras;   // zeros exatos se o pré-filtro reprovar o dia
+                if (pode_ser_viavel(tabelas, vfases, ni, dia0)) c = plano.usar_amostragem
+                    ? amostrar_dia(tabelas, vfases, ni, dia0, plano.amostras, semente_dia(semente, dia0))
+                    : enumerar_dia(tabelas, vfases, ni, dia0);
+                r = finalizar_contagem(c, plano);
+                if (graficos) {
+                    char texto[16];
+                    std::snprintf(texto, sizeof(texto), "%02d/%02d/%04d", datas[dia0] % 100,
+                                  datas[dia0] / 100 % 100, datas[dia0] / 10000);
+                    resultados[dia0] = r;
+                    resultados[dia0].data_str = texto;
+                }
+            }
+            if (saida->prob_viabilidade)     saida->prob_viabilidade[dia0]     = r.prob_viabilidade;
+            if (saida->rendimento_medio)     saida->rendimento_medio[dia0]     = r.rendimento_medio;
+            if (saida->prob_esbranquiamento) saida->prob_esbranquiamento[dia0] = r.prob_esbranquiamento;
+            if (saida->prob_reducao_moagem)  saida->prob_reducao_moagem[dia0]  = r.prob_reducao_moagem;
+            if (saida->prob_optimo)          saida->prob_optimo[dia0]          = r.prob_optimo;
+            if (saida->total_caminhos)       saida->total_caminhos[dia0]       = r.total_caminhos.saturado();
+            if (saida->caminhos_viaveis)     saida->caminhos_viaveis[dia0]     = r.caminhos_viaveis;
+        });
+        if (graficos) preencher_graficos(resultados, *graficos);
+        return RG_OK;
+    } catch (const std::exception& e) {
+        return falhar(RG_ERRO_INTERNO, e.what());
+    } catch (...) {
+        return falhar(RG_ERRO_INTERNO, "Erro desconhecido");
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,124 @@
+#ifndef RICEGUARD_H
+#define RICEGUARD_H
+
+/*
+ * libriceguard: ABI C estável do motor de viabilidade.
+ *
+ * Sem E/S de arquivo e sem cópias das séries: o chamador fornece colunas
+ * contíguas de Tmax/Tmin (e, para as séries de gráfico, datas) e buffers de
+ * saída com `n` posições cada. Utilizável via ctypes/cffi sem camada de binding.
+ *
+ * Todas as funções são reentrantes; a mensagem de erro é por thread.
+ */
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define RG_API __declspec(dllexport)
+#else
+#define RG_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RG_ABI_VERSAO 2
+
+/* Códigos de retorno */
+#define RG_OK                 0
+#define RG_ERRO_ARGUMENTO    -1
+#define RG_ERRO_DATAS        -2
+#define RG_ERRO_INTERNO      -3
+
+/* Fixação das threads de trabalho em CPUs (rg_configurar_threads) */
+#define RG_AFINIDADE_NENHUMA   0
+#define RG_AFINIDADE_COMPACTA  1
+#define RG_AFINIDADE_ESPALHADA 2
+
+/* Fase fenológica (mesmos campos do JSON de fases) */
+typedef struct rg_fase {
+    const char* nome;       /* "Maturação" habilita os riscos de qualidade */
+    double min_t;
+    double max_t;
+    double opt_min_t;
+    double opt_max_t;
+    int32_t dur_min;
+    int32_t dur_max;
+} rg_fase;
+
+/*
+ * Colunas de saída fornecidas pelo chamador, cada uma com `n` posições.
+ * Ponteiros nulos são ignorados. Dias iniciais sem dias suficientes para o
+ * ciclo mais curto recebem zeros (como as linhas vazias do CSV detalhado).
+ */
+typedef struct rg_resultados {
+    double* prob_viabilidade;
+    double* rendimento_medio;
+    double* prob_esbranquiamento;
+    double* prob_reducao_moagem;
+    double* prob_optimo;
+    int64_t* total_caminhos;        /* satura em INT64_MAX acima de 2^63 */
+    int64_t* caminhos_viaveis;
+} rg_resultados;
+
+/* Séries compactas dos gráficos, como grafico_mensal.csv / grafico_evolucao.csv */
+#define RG_NUM_METRICAS       5     /* viabilidade, rendimento, esbranquiamento, redução, ótimo */
+#define RG_PONTOS_MAX_GRAFICO 730
+
+typedef struct rg_mes_grafico {
+    int32_t dias;                        /* dias iniciais avaliados no mês (0 = mês ausente) */
+    double media[RG_NUM_METRICAS];
+    double inferior[RG_NUM_METRICAS];    /* faixa de 95% */
+    double superior[RG_NUM_METRICAS];
+} rg_mes_grafico;
+
+typedef struct rg_ponto_evolucao {
+    int32_t data;                        /* AAAAMMDD */
+    double media[2];                     /* média móvel de viabilidade e rendimento */
+    double inferior[2];
+    double superior[2];
+} rg_ponto_evolucao;
+
+typedef struct rg_graficos {
+    rg_mes_grafico mensal[12];           /* por mês do ano (0 = janeiro) */
+    rg_ponto_evolucao evolucao[RG_PONTOS_MAX_GRAFICO];
+    int32_t num_pontos;                  /* posições preenchidas de `evolucao` */
+} rg_graficos;
+
+/* Versão da ABI com que a biblioteca foi compilada (RG_ABI_VERSAO) */
+RG_API int32_t rg_versao_abi(void);
+
+/*
+ * Executa a análise de viabilidade para cada dia inicial.
+ *
+ * tmax, tmin : temperaturas diárias (°C), n posições (n <= INT32_MAX)
+ * semente    : semente do modo de amostragem (ignorada no modo exaustivo)
+ * datas      : AAAAMMDD por dia, válidas e consecutivas; lidas só com `graficos` (senão NULL)
+ * graficos   : se não NULL, recebe as séries dos gráficos calculadas dos resultados
+ *
+ * Retorna RG_OK ou um código de erro; ver rg_ultimo_erro().
+ */
+RG_API int32_t rg_analisar(const double* tmax, const double* tmin, int64_t n,
+                           const rg_fase* fases, int32_t num_fases, uint64_t semente,
+                           rg_resultados* saida, const int32_t* datas, rg_graficos* graficos);
+
+/*
+ * Recria as threads de trabalho persistentes usadas por rg_analisar.
+ *
+ * threads    : total de threads (<= 0 = OMP_NUM_THREADS / núcleos disponíveis)
+ * afinidade  : RG_AFINIDADE_*
+ *
+ * Opcional: sem chamada, o pool é criado no primeiro rg_analisar e reaproveitado
+ * pelas chamadas seguintes. Não chamar com análises em andamento.
+ */
+RG_API int32_t rg_configurar_threads(int32_t threads, int32_t afinidade);
+
+/* Mensagem do último erro na thread atual ("" se nenhum) */
+RG_API const char* rg_ultimo_erro(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RICEGUARD_H */
@@ -0,0 +1,276 @@
+#include "opcoes.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef RICEGUARD_FASES_PADRAO
+#define RICEGUARD_FASES_PADRAO "config/fases_cultivo_arroz.json"
+#endif
+
+namespace cli {
+
+namespace {
+
+// "ini:fim:passo" (fim incluído) ou lista "a,b,..." de coeficientes não negativos
+std::vector<double> interpretar_grade(const std::string& nome, const std::string& texto) {
+    std::vector<double> grade;
+    if (std::count(texto.begin(), texto.end(), ':') == 2) {
+        const auto p1 = texto.find(':'), p2 = texto.rfind(':');
+        const double ini = std::stod(texto.substr(0, p1));
+        const double fim = std::stod(texto.substr(p1 + 1, p2 - p1 - 1));
+        const double passo = std::stod(texto.substr(p2 + 1));
+        if (passo <= 0.0 || fim < ini)
+            throw std::invalid_argument(nome + " espera ini:fim:passo com ini <= fim e passo > 0: " + texto);
+        const long long pontos = static_cast<long long>((fim - ini) / passo + 1e-9) + 1;
+        if (pontos > 100000) throw std::invalid_argument(nome + " com pontos demais: " + texto);
+        for (long long k = 0; k < pontos; ++k) grade.push_back(ini + k * passo);
+    } else {
+        std::stringstream lista(texto);
+        for (std::string item; std::getline(lista, item, ',');) grade.push_back(std::stod(item));
+    }
+    for (double c : grade)
+        if (!(c >= 0.0)) throw std::invalid_argument(nome + " aceita apenas coeficientes >= 0: " + texto);
+    if (grade.empty()) throw std::invalid_argument(nome + " sem coeficientes");
+    return grade;
+}
+
+} // namespace
+
+Opcoes interpretar_argumentos(const std::vector<std::string>& args) {
+    Opcoes op;
+    op.caminho_fases = RICEGUARD_FASES_PADRAO;
+    std::vector<std::string> posicionais;
+    size_t primeiro = 0;
+    if (!args.empty() && args[0] == "merge") {
+        op.mesclar = true;
+        primeiro = 1;
+    } else if (!args.empty() && args[0] == "calibrar") {
+        op.calibrar = true;
+        primeiro = 1;
+    }
+
+    for (size_t i = primeiro; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg.rfind("--", 0) != 0) {
+            posicionais.push_back(arg);
+            continue;
+        }
+
+        // Separa "--opcao=valor"; sem '=', o valor é o próximo argumento
+        std::string nome = arg, valor;
+        bool tem_valor = false;
+        auto eq = arg.find('=');
+        if (eq != std::string::npos) {
+            nome = arg.substr(0, eq);
+            valor = arg.substr(eq + 1);
+            tem_valor = true;
+        }
+        auto proximo_valor = [&]() -> std::string {
+            if (tem_valor) return valor;
+            if (i + 1 >= args.size())
+                throw std::invalid_argument("Opção sem valor: " + nome);
+            return args[++i];
+        };
+
+        if (nome == "--fases") {
+            op.caminho_fases = proximo_valor();
+        } else if (nome == "--cultivar") {
+            op.cultivar = proximo_valor();
+        } else if (nome == "--agrupamentos") {
+            op.agrupamentos = proximo_valor();
+        } else if (nome == "--janelas") {
+            op.janelas = proximo_valor();
+        } else if (nome == "--modo") {
+            op.modo = proximo_valor();
+            if (op.modo != "diario" && op.modo != "horario" && op.modo != "gdd" && op.modo != "grade")
+                throw std::invalid_argument("Modo inválido: " + op.modo + " (use diario, horario, gdd ou grade)");
+        } else if (nome == "--melhores") {
+            op.melhores = std::stoi(proximo_valor());
+            if (op.melhores < 1) throw std::invalid_argument("--melhores deve ser >= 1");
+        } else if (nome == "--dias-janela") {
+            op.dias_janela = std::stoi(proximo_valor());
+            if (op.dias_janela < 1) throw std::invalid_argument("--dias-janela deve ser >= 1");
+        } else if (nome == "--viabilidade-min") {
+            op.viabilidade_min = std::stod(proximo_valor());
+            if (op.viabilidade_min < 0.0 || op.viabilidade_min > 1.0)
+                throw std::invalid_argument("--viabilidade-min deve estar em [0, 1]");
+        } else if (nome == "--imputacoes") {
+            op.imputacoes = std::stoi(proximo_valor());
+            if (op.imputacoes < 1) throw std::invalid_argument("--imputacoes deve ser >= 1");
+        } else if (nome == "--shard") {
+            const std::string fatia = proximo_valor();
+            const auto barra = fatia.find('/');
+            if (barra == std::string::npos)
+                throw std::invalid_argument("--shard espera i/N: " + fatia);
+            op.fatia_indice = std::stoi(fatia.substr(0, barra));
+            op.fatia_total = std::stoi(fatia.substr(barra + 1));
+            if (op.fatia_total < 1 || op.fatia_indice < 0 || op.fatia_indice >= op.fatia_total)
+                throw std::invalid_argument("--shard fora do intervalo 0 <= i < N: " + fatia);
+        } else if (nome == "--celulas") {
+            std::stringstream lista(proximo_valor());
+            for (std::string item; std::getline(lista, item, ',');) {
+                if (item.empty() || item.find_first_not_of("0123456789") != std::string::npos)
+                    throw std::invalid_argument("Célula inválida em --celulas: '" + item + "'");
+                op.celulas.push_back(std::stoull(item));
+            }
+        } else if (nome == "--estado") {
+            op.estado = proximo_valor();
+        } else if (nome == "--checkpoint") {
+            op.checkpoint = proximo_valor();
+        } else if (nome == "--resume") {
+            if (tem_valor) throw std::invalid_argument("--resume não aceita valor");
+            op.retomar = true;
+        } else if (nome == "--precisao") {
+            op.precisao = proximo_valor();
+            if (op.precisao != "simples" && op.precisao != "dupla")
+                throw std::invalid_argument("Precisão inválida: " + op.precisao + " (use simples ou dupla)");
+        } else if (nome == "--validar-precisao") {
+            if (tem_valor) throw std::invalid_argument("--validar-precisao não aceita valor");
+            op.validar_precisao = true;
+        } else if (nome == "--condicional") {
+            op.condicional = std::stoll(proximo_valor());
+            if (op.condicional < 2) throw std::invalid_argument("--condicional deve ser >= 2");
+        } else if (nome == "--rotacao") {
+            op.rotacao = proximo_valor();
+        } else if (nome == "--intervalo-rotacao") {
+            const std::string intervalo = proximo_valor();
+            const auto traco = intervalo.find('-');
+            op.intervalo_min = std::stoi(intervalo.substr(0, traco));
+            op.intervalo_max = traco == std::string::npos ? op.intervalo_min
+                                                           : std::stoi(intervalo.substr(traco + 1));
+            if (op.intervalo_min < 0 || op.intervalo_max < op.intervalo_min)
+                throw std::invalid_argument("--intervalo-rotacao espera min-max com 0 <= min <= max: " + intervalo);
+        } else if (nome == "--climatologia") {
+            op.climatologia = proximo_valor();
+        } else if (nome == "--anos-janela") {
+            op.anos_janela = std::stoi(proximo_valor());
+            if (op.anos_janela < 1) throw std::invalid_argument("--anos-janela deve ser >= 1");
+        } else if (nome == "--estatisticas") {
+            op.estatisticas = proximo_valor();
+        } else if (nome == "--penal-diurna") {
+            op.penal_diurna = interpretar_grade(nome, proximo_valor());
+        } else if (nome == "--penal-noturna") {
+            op.penal_noturna = interpretar_grade(nome, proximo_valor());
+        } else if (nome == "--verify") {
+            op.verificar = std::stoi(proximo_valor());
+            if (op.verificar < 1) throw std::invalid_argument("--verify deve ser >= 1");
+        } else if (nome == "--threads") {
+            op.threads = std::stoi(proximo_valor());
+            if (op.threads < 1) throw std::invalid_argument("--threads deve ser >= 1");
+        } else if (nome == "--afinidade") {
+            op.afinidade = proximo_valor();
+            if (op.afinidade != "nenhuma" && op.afinidade != "compacta" && op.afinidade != "espalhada")
+                throw std::invalid_argument("Afinidade inválida: " + op.afinidade +
+                                            " (use nenhuma, compacta ou espalhada)");
+        } else if (nome == "--falhas") {
+            if (tem_valor) throw std::invalid_argument("--falhas não aceita valor");
+            op.falhas = true;
+        } else if (nome == "--sem-detalhado") {
+            if (tem_valor) throw std::invalid_argument("--sem-detalhado não aceita valor");
+            op.sem_detalhado = true;
+        } else {
+            throw std::invalid_argument("Opção desconhecida: " + nome);
+        }
+    }
+
+    if (op.melhores > 0 && op.modo != "diario")
+        throw std::invalid_argument("--melhores só está disponível no modo diario");
+    if (op.imputacoes > 0 && (op.modo != "diario" || op.melhores > 0))
+        throw std::invalid_argument("--imputacoes só está disponível na análise completa do modo diario");
+    if (op.fatia_total > 0 && (op.modo != "diario" || op.melhores > 0 || op.imputacoes > 0))
+        throw std::invalid_argument("--shard só está disponível na análise completa do modo diario");
+    if ((op.retomar || !op.checkpoint.empty()) &&
+        (op.modo != "diario" || op.melhores > 0 || op.imputacoes > 0 || op.fatia_total > 0 || op.mesclar))
+        throw std::invalid_argument("--checkpoint/--resume só estão disponíveis na análise completa do modo diario");
+    if ((!op.precisao.empty() || op.validar_precisao) &&
+        (op.modo != "diario" || op.melhores > 0 || op.imputacoes > 0 || op.fatia_total > 0 ||
+         !op.checkpoint.empty() || op.retomar || op.mesclar))
+        throw std::invalid_argument("--precisao/--validar-precisao só estão disponíveis na análise completa do modo diario");
+    if (op.validar_precisao && op.precisao == "dupla")
+        throw std::invalid_argument("--validar-precisao avalia a precisão simples");
+    if (op.validar_precisao) op.precisao = "simples";
+    if (!op.estado.empty() &&
+        (op.modo != "diario" || op.melhores > 0 || op.imputacoes > 0 || op.fatia_total > 0 ||
+         !op.checkpoint.empty() || op.retomar || !op.precisao.empty() || op.validar_precisao || op.mesclar))
+        throw std::invalid_argument("--estado só está disponível na análise completa do modo diario, "
+                                    "sem --checkpoint, --shard ou --precisao");
+    if (op.falhas &&
+        (op.modo != "diario" || !op.cultivar.empty() || op.melhores > 0 || op.imputacoes > 0 ||
+         op.fatia_total > 0 || !op.checkpoint.empty() || op.retomar || !op.precisao.empty() ||
+         !op.estado.empty() || op.mesclar))
+        throw std::invalid_argument("--falhas só está disponível na análise completa do modo diario "
+                                    "(caminho genérico, sem outros modos)");
+    if (op.condicional > 0 &&
+        (op.modo != "diario" || !op.cultivar.empty() || op.melhores > 0 || op.imputacoes > 0 ||
+         op.fatia_total > 0 || !op.checkpoint.empty() || op.retomar || !op.precisao.empty() ||
+         !op.estado.empty() || op.falhas || op.mesclar))
+        throw std::invalid_argument("--condicional só está disponível na análise completa do modo diario "
+                                    "(caminho genérico, sem outros modos)");
+    if ((op.intervalo_min > 0 || op.intervalo_max > 0) && op.rotacao.empty())
+        throw std::invalid_argument("--intervalo-rotacao exige --rotacao");
+    if (!op.rotacao.empty() &&
+        (op.modo != "diario" || op.melhores > 0 || op.imputacoes > 0 || op.fatia_total > 0 ||
+         !op.checkpoint.empty() || op.retomar || !op.precisao.empty() || !op.estado.empty() ||
+         op.falhas || op.condicional > 0 || op.mesclar))
+        throw std::invalid_argument("--rotacao só está disponível no modo diario, sem outros modos");
+    if (!op.climatologia.empty() &&
+        (op.modo == "grade" || op.melhores > 0 || op.fatia_total > 0 || !op.rotacao.empty() || op.mesclar))
+        throw std::invalid_argument("--climatologia exige uma análise completa (sem --modo grade, --melhores, "
+                                    "--shard, --rotacao ou merge)");
+    if (op.verificar > 0 &&
+        (op.modo != "diario" || op.melhores > 0 || op.imputacoes > 0 || op.fatia_total > 0 ||
+         !op.rotacao.empty() || op.mesclar))
+        throw std::invalid_argument("--verify só está disponível na análise completa do modo diario "
+                                    "(sem --melhores, --imputacoes, --shard, --rotacao ou merge)");
+    if (!op.estatisticas.empty() &&
+        (op.modo != "diario" || op.melhores > 0 || op.imputacoes > 0 || op.fatia_total > 0 ||
+         !op.checkpoint.empty() || op.retomar || !op.precisao.empty() || !op.estado.empty() ||
+         op.falhas || op.condicional > 0 || !op.rotacao.empty() || op.mesclar || op.calibrar))
+        throw std::invalid_argument("--estatisticas só está disponível na análise completa do modo diario "
+                                    "(sem outros modos)");
+    if ((!op.penal_diurna.empty() || !op.penal_noturna.empty()) && !op.calibrar)
+        throw std::invalid_argument("--penal-diurna/--penal-noturna só valem no subcomando calibrar");
+    if (!op.celulas.empty() && op.modo != "grade")
+        throw std::invalid_argument("--celulas só está disponível no modo grade");
+    if (op.modo == "grade" && (op.melhores > 0 || op.imputacoes > 0 || op.fatia_total > 0 ||
+                               !op.checkpoint.empty() || op.retomar || !op.agrupamentos.empty()))
+        throw std::invalid_argument("O modo grade não combina com --melhores, --imputacoes, --shard, "
+                                    "--checkpoint/--resume nem --agrupamentos");
+    if (op.mesclar) {
+        if (posicionais.size() < 2)
+            throw std::invalid_argument("Esperados merge <pasta_saida> <parcial.bin>...");
+        op.pasta_saida = posicionais[0];
+        op.parciais.assign(posicionais.begin() + 1, posicionais.end());
+        return op;
+    }
+    if (op.calibrar) {
+        if (posicionais.size() != 2)
+            throw std::invalid_argument("Esperados calibrar <pasta_saida> <estatisticas.bin>");
+        op.pasta_saida = posicionais[0];
+        op.estatisticas = posicionais[1];
+        return op;
+    }
+    if (posicionais.size() != 2)
+        throw std::invalid_argument("Esperados <arquivo_entrada.csv> <pasta_saida>");
+    op.caminho_entrada = posicionais[0];
+    op.pasta_saida = posicionais[1];
+    if (op.retomar && op.checkpoint.empty()) op.checkpoint = op.pasta_saida + "/checkpoint.bin";
+    return op;
+}
+
+std::string uso(const std::string& programa) {
+    return "Uso correto: " + programa + " <arquivo_entrada.csv> <pasta_saida>"
+           " [--fases <fases.json>] [--cultivar <nome>] [--modo diario|horario|gdd|grade] [--celulas i,j,...]"
+           " [--agrupamentos semana,decendio,mes_ano,janela] [--janelas nome:DD/MM-DD/MM;...]"
+           " [--melhores K [--dias-janela N] [--viabilidade-min p]] [--imputacoes N] [--shard i/N]"
+           " [--checkpoint <arquivo>] [--resume] [--precisao simples|dupla] [--validar-precisao]"
+           " [--estado <arquivo>] [--falhas] [--sem-detalhado] [--condicional N]"
+           " [--rotacao <fases_segunda.json> [--intervalo-rotacao min-max]]"
+           " [--climatologia <arquivo> [--anos-janela N]]"
+           " [--verify K] [--estatisticas <arquivo>] [--threads N] [--afinidade nenhuma|compacta|espalhada]\n"
+           "       " + programa + " merge <pasta_saida> <parcial.bin>... [--agrupamentos ...] [--janelas ...]\n"
+           "       " + programa + " calibrar <pasta_saida> <estatisticas.bin>"
+           " [--penal-diurna ini:fim:passo|a,b,...] [--penal-noturna ini:fim:passo|a,b,...]";
+}
+
+} // namespace cli
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cli {
+
+// Opções de linha de comando do executável `analise`
+struct Opcoes {
+    std::string caminho_entrada;
+    std::string pasta_saida;
+    std::string caminho_fases;   // JSON de fases do caminho genérico
+    std::string cultivar;        // catálogo embutido (vazio = caminho genérico)
+    std::string agrupamentos;    // lista "semana,decendio,mes_ano,janela" (vazio = nenhum)
+    std::string janelas;         // janelas de semeadura "nome:DD/MM-DD/MM;..."
+    std::string modo = "diario"; // "diario", "horario" (CSV bruto da estação), "gdd" (graus-dia) ou "grade"
+    int melhores = 0;            // > 0: consulta das K melhores janelas por ano em vez da análise completa
+    int dias_janela = 1;         // tamanho das janelas da consulta (dias iniciais contíguos)
+    double viabilidade_min = 0.0;
+    int imputacoes = 0;          // > 0: ensemble de N preenchimentos das lacunas do CSV diário
+    int fatia_indice = 0;        // --shard i/N: avalia só os dias iniciais d ≡ i (mod N)
+    int fatia_total = 0;         // 0 = sem fatiamento
+    std::string checkpoint;      // arquivo de checkpoint da análise completa (vazio = sem checkpoint)
+    bool retomar = false;        // --resume: reaproveita o checkpoint (padrão <pasta_saida>/checkpoint.bin)
+    std::string estado;          // estado persistido para recálculo incremental (vazio = desligado)
+    std::string precisao;        // "simples" (float) ou "dupla" (double) no motor de tabelas; vazio = caminho usual
+    bool validar_precisao = false; // compara float × double e grava validacao_precisao.csv
+    long long condicional = 0;   // > 0: estimador condicional de eventos raros com N amostras por dia
+    std::string rotacao;         // JSON de fases da segunda safra (vazio = safra única)
+    int intervalo_min = 0;       // --intervalo-rotacao min-max: dias do fim da primeira à segunda semeadura
+    int intervalo_max = 0;
+    std::string climatologia;    // histórico por ano da climatologia móvel (vazio = desligada)
+    int anos_janela = 0;         // anos da janela móvel da climatologia (0 = a gravada, ou 30)
+    bool falhas = false;          // grava analise_falhas.csv (fase/limite da primeira falha por dia inicial)
+    bool sem_detalhado = false;  // não grava analise_detalhada.csv (os gráficos usam grafico_*.csv)
+    int verificar = 0;           // --verify K: K dias iniciais sorteados refeitos pelo caminho de referência
+    std::string estatisticas;    // grava as estatísticas de calibração das penalidades (vazio = desligado)
+    bool calibrar = false;       // subcomando "calibrar": rendimento para uma grade de coeficientes
+    std::vector<double> penal_diurna;   // --penal-diurna: coeficientes da grade (vazio = PENAL_DIURNA)
+    std::vector<double> penal_noturna;  // --penal-noturna: idem (vazio = PENAL_NOTURNA)
+    int threads = 0;             // threads do pool de trabalho (0 = OMP_NUM_THREADS / núcleos disponíveis)
+    std::string afinidade = "nenhuma"; // fixação das threads do pool: nenhuma, compacta ou espalhada
+    std::vector<size_t> celulas; // --modo grade: células com CSV detalhado próprio
+    bool mesclar = false;        // subcomando "merge": combina arquivos parciais
+    std::vector<std::string> parciais;
+};
+
+/**
+ * @brief Interpreta os argumentos (sem o nome do programa)
+ *
+ * Aceita dois posicionais <arquivo_entrada.csv> <pasta_saida> e opções nas
+ * formas "--opcao valor" ou "--opcao=valor". Com o subcomando "merge", os
+ * posicionais são <pasta_saida> <parcial.bin>...; com "calibrar",
+ * <pasta_saida> <estatisticas.bin>. As grades de coeficientes aceitam
+ * "ini:fim:passo" ou uma lista "a,b,...".
+ *
+ * @throws std::invalid_argument em opção desconhecida ou posicionais ausentes
+ */
+Opcoes interpretar_argumentos(const std::vector<std::string>& args);
+
+// Texto de uso exibido em erros de argumento
+std::string uso(const std::string& programa);
+
+} // namespace cli
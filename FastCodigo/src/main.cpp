@@ -2,24 +2,67 @@
 #include <fstream>
 #include <filesystem>
 #include <string>
+#include <algorithm>
+#include <random>
+#include <chrono>
 #include "model/viab/analise_viabilidade.h"
 #include "model/io/csv_reader.h"
+#include "model/io/csv_horario_reader.h"
 #include "model/io/json_loader.h"
 #include "model/summary/summary_generator.h"
+#include "model/summary/agregacao.h"
+#include "model/viab/kernel_especializado.h"
+#include "model/viab/analise_gdd.h"
+#include "model/viab/busca_melhores.h"
+#include "model/viab/ensemble_imputacao.h"
+#include "model/summary/calendario.h"
+#include "model/summary/climatologia.h"
+#include "model/summary/graficos.h"
+#include "model/io/climatologia_io.h"
+#include "model/viab/particao.h"
+#include "model/viab/precisao.h"
+#include "model/viab/duracao_ponderada.h"
+#include "model/viab/amostragem_condicional.h"
+#include "model/viab/rotacao.h"
+#include "model/viab/pool_trabalho.h"
+#include "model/viab/verificacao.h"
+#include "model/viab/calibracao.h"
+#include "model/viab/analysis_config.h"
+#include "model/viab/motor_tabelas.h"
+#include "model/io/parcial_io.h"
+#include "model/io/checkpoint.h"
+#include "model/io/grade_io.h"
+#include "model/io/estado_incremental.h"
+#include "model/io/estatisticas_io.h"
+#include "cli/opcoes.h"
 
 namespace fs = std::filesystem;
+
+// Resumos agrupados (uma passada, um CSV por agrupamento)
+static void gravar_agrupamentos(const fs::path& pasta_saida,
+                                const std::vector<model::viab::ResultadoData>& resultados,
+                                const std::vector<model::summary::Agrupamento>& agrupamentos,
+                                const std::vector<model::summary::JanelaSemeadura>& janelas) {
+    if (agrupamentos.empty()) return;
+    const auto colunas = model::summary::extrair_colunas(resultados);
+    for (const auto& grupo : model::summary::agrupar(colunas, agrupamentos, janelas)) {
+        std::ofstream(pasta_saida / model::summary::nome_arquivo(grupo.tipo))
+            << model::summary::gerar_csv_agrupamento(grupo, janelas);
+    }
+}
+
 /**
  * @brief Ponto de entrada para análise de viabilidade do arroz (Oryza sativa L.).
  * 
  * Fluxo:
  *  1) Valida argumentos
  *  2) Carrega CSV de dados meteorológicos
- *  3) Configura fases fenológicas (ideal carregar de JSON)
- *  4) Executa análise de viabilidade
+ *  3) Configura fases fenológicas (JSON ou catálogo embutido via --cultivar)
+ *  4) Executa análise de viabilidade (kernel especializado quando houver catálogo)
  *  5) Gera relatórios CSV de saída
  * 
- * @param argc Deve ser 3: [programa, arquivo_entrada.csv, pasta_saida]
- * @param argv Caminhos de entrada/saída
+ * @param argc Pelo menos 3: [programa, arquivo_entrada.csv, pasta_saida, opções...]
+ * @param argv Caminhos de entrada/saída e opções (ver cli::uso)
  * @return int 0 = sucesso, 1 = erro de argumento/arquivo, 2 = erro desconhecido
  */
 int main(int argc,char**argv){
@@ -27,23 +70,69 @@ int main(int argc,char**argv){
         // ======================================
         // 1. Validação de Entrada
         // ======================================
-        if (argc != 3) {
-            throw std::invalid_argument(
-                "Uso correto: " + std::string(argv[0]) +
-                " <arquivo_entrada.csv> <pasta_saida>"
-            );
+        const auto opcoes = cli::interpretar_argumentos(
+            std::vector<std::string>(argv + 1, argv + argc));
+        // Pool de trabalho persistente, compartilhado por todos os motores
+        model::viab::configurar_pool({opcoes.threads, model::viab::afinidade_de_texto(opcoes.afinidade)});
+
+        const fs::path caminho_entrada(opcoes.caminho_entrada);
+        const fs::path pasta_saida(opcoes.pasta_saida);
+        const std::string& caminho_json = opcoes.caminho_fases;
+        const bool usar_catalogo = !opcoes.cultivar.empty();
+
+        const auto agrupamentos = model::summary::interpretar_agrupamentos(opcoes.agrupamentos);
+        const auto janelas = model::summary::interpretar_janelas(opcoes.janelas);
+        if (janelas.empty() && std::count(agrupamentos.begin(), agrupamentos.end(),
+                                          model::summary::Agrupamento::JanelaSemeadura)) {
+            throw std::invalid_argument("Agrupamento 'janela' exige --janelas");
         }
 
-        const fs::path caminho_entrada(argv[1]);
-        const fs::path pasta_saida(argv[2]);
-        std::string caminho_json = "/home/yuka/Desktop/faculdade/PM/Codigo/FastCodigo/src/config/fases_cultivo_arroz.json";
+        // Subcomando merge: combina as fatias e gera os relatórios usuais
+        if (opcoes.mesclar) {
+            std::vector<model::viab::ResultadoParcial> parciais;
+            for (const auto& caminho : opcoes.parciais) parciais.push_back(model::io::ler_parcial(caminho));
+            const auto combinado = model::viab::combinar_parciais(parciais);
+
+            fs::create_directories(pasta_saida);
+            std::ofstream(pasta_saida / "analise_detalhada.csv")
+                << model::summary::gerar_csv_detalhado(combinado.resultados);
+            std::ofstream(pasta_saida / "resumo_mensal.csv")
+                << model::summary::gerar_csv_resumo_mensal(combinado.resultados, combinado.dias);
+            gravar_agrupamentos(pasta_saida, combinado.resultados, agrupamentos, janelas);
+            std::cout << "Combinadas " << parciais.size() << " fatias (" << combinado.dias.size()
+                      << " dias)\n";
+            return 0;
+        }
+
+        // Subcomando calibrar: rendimento por par de coeficientes a partir das estatísticas gravadas
+        if (opcoes.calibrar) {
+            const auto estatisticas = model::io::ler_estatisticas(opcoes.estatisticas);
+            const auto inicio = std::chrono::steady_clock::now();
+            const auto calibracao = model::viab::calibrar_penalidades(
+                estatisticas,
+                opcoes.penal_diurna.empty() ? std::vector<double>{model::viab::AnalysisConfig::PENAL_DIURNA}
+                                            : opcoes.penal_diurna,
+                opcoes.penal_noturna.empty() ? std::vector<double>{model::viab::AnalysisConfig::PENAL_NOTURNA}
+                                             : opcoes.penal_noturna);
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - inicio).count();
+            fs::create_directories(pasta_saida);
+            std::ofstream(pasta_saida / "calibracao.csv") << model::summary::gerar_csv_calibracao(calibracao);
+            std::cout << "Calibração: " << calibracao.size() << " pares de coeficientes sobre "
+                      << estatisticas.dias.size() << " dias em " << ms << " ms\n";
+            return 0;
+        }
+
+        if (usar_catalogo && !model::viab::cultivar_embutida(opcoes.cultivar)) {
+            throw std::invalid_argument("Cultivar sem catálogo embutido: " + opcoes.cultivar);
+        }
 
         if (!fs::exists(caminho_entrada)) {
             throw std::runtime_error("Arquivo de entrada não encontrado: " 
                                      + caminho_entrada.string());
         }
 
-        if (!fs::exists(caminho_json)) {
+        if (!usar_catalogo && !fs::exists(caminho_json)) {
             throw std::runtime_error("Arquivo json não encontrado!");
         }
 
@@ -51,36 +140,309 @@ int main(int argc,char**argv){
         // 2. Carregamento de Dados
         // ======================================
         // Leitura robusta do CSV, com exceções específicas em caso de falha
-
-        const auto dados_meteorologicos = model::io::ler_dados(caminho_entrada.string());
+        // No modo horário a entrada é o CSV bruto e os dias derivam da série horária
+        const bool modo_horario = opcoes.modo == "horario";
+        // Com --imputacoes, dias sem Tmax/Tmin são aceitos como lacunas
+        model::viab::SerieHoraria serie_horaria;
+        model::viab::SerieComLacunas serie_lacunas;
+        if (modo_horario) {
+            const auto registros = model::io::ler_dados_horarios(caminho_entrada.string());
+            const auto ausentes = std::count_if(registros.begin(), registros.end(),
+                                                [](const auto& r) { return r.ausente; });
+            if (ausentes > 0)
+                std::cout << "Aviso: " << ausentes << " dias ausentes no CSV horário; horas interpoladas\n";
+            serie_horaria = model::viab::montar_serie_horaria(registros);
+        } else if (opcoes.imputacoes > 0) {
+            serie_lacunas = model::io::ler_dados_com_lacunas(caminho_entrada.string());
+        }
+        // No modo grade a entrada é mapeada em memória no passo 4
+        const bool modo_grade = opcoes.modo == "grade";
+        const auto dados_meteorologicos = modo_horario ? serie_horaria.dias
+            : opcoes.imputacoes > 0 ? serie_lacunas.dias
+            : modo_grade ? std::vector<model::viab::Dia>{}
+            : model::io::ler_dados(caminho_entrada.string());
 
          // ======================================
         // 3. Configuração de Fases (Fenologia)
         // ======================================
         
-        const auto fases = model::io::carregar_fases(caminho_json);
+        const auto fases = usar_catalogo ? model::viab::fases_cultivar(opcoes.cultivar)
+                                         : model::io::carregar_fases(caminho_json);
+        // Durações ponderadas só no caminho diário padrão (DP própria)
+        if (model::viab::tem_pesos(fases) &&
+            (opcoes.modo != "diario" || opcoes.melhores > 0 || opcoes.imputacoes > 0 ||
+             opcoes.fatia_total > 0 || !opcoes.checkpoint.empty() || !opcoes.estado.empty() ||
+             !opcoes.precisao.empty() || opcoes.falhas || opcoes.condicional > 0 ||
+             !opcoes.estatisticas.empty()))
+            throw std::invalid_argument("Fases com 'pesos'/'distribuicao' só são aceitas no modo diário padrão");
 
         // ======================================
         // 4. Processamento Principal
         // ======================================
 
-        const auto Resultado = model::viab::rodar_analise(dados_meteorologicos,fases);
+        // Grade regional: resultado binário por célula e CSV das células selecionadas
+        if (modo_grade) {
+            const model::io::GradeMapeada grade(caminho_entrada.string());
+            const auto& cab = grade.cabecalho();
+            const model::summary::Data data0{cab.ano, cab.mes, cab.dia};
+            if (cab.mes < 1 || cab.mes > 12 || cab.dia < 1 || cab.dia > model::summary::dias_no_mes(cab.ano, cab.mes))
+                throw std::runtime_error("Data inicial inválida na grade: " + caminho_entrada.string());
+
+            fs::create_directories(pasta_saida);
+            auto execucao = model::io::rodar_analise_grade(
+                grade, fases, (pasta_saida / "resultado_grade.bin").string(), opcoes.celulas);
+            for (auto& [celula, resultados] : execucao.selecionadas) {
+                auto data = data0;
+                std::vector<model::viab::Dia> dias;
+                for (auto& r : resultados) {
+                    r.data_str = model::summary::formatar_data(data);
+                    dias.push_back({r.data_str, data.mes, 0.0, 0.0});
+                    data = model::summary::dia_seguinte(data);
+                }
+                const std::string prefixo = "celula_" + std::to_string(celula);
+                std::ofstream(pasta_saida / (prefixo + "_detalhada.csv"))
+                    << model::summary::gerar_csv_detalhado(resultados);
+                std::ofstream(pasta_saida / (prefixo + "_resumo_mensal.csv"))
+                    << model::summary::gerar_csv_resumo_mensal(resultados, dias);
+            }
+            std::cout << "Grade: " << execucao.celulas << " células, " << execucao.celulas_unicas
+                      << " séries distintas calculadas; " << execucao.dias_descartados
+                      << " dias iniciais descartados pelo pré-filtro\n";
+            return 0;
+        }
+
+        // Consulta das melhores janelas por ano: substitui a análise completa
+        if (opcoes.melhores > 0) {
+            std::vector<int> anos;
+            for (const auto& d : dados_meteorologicos) {
+                const auto data = model::summary::interpretar_data(d.data_str);
+                anos.push_back(data ? data->ano : 0);
+            }
+            model::viab::ConsultaMelhores consulta;
+            consulta.k = opcoes.melhores;
+            consulta.dias_janela = opcoes.dias_janela;
+            consulta.viabilidade_min = opcoes.viabilidade_min;
+            const auto melhores = model::viab::buscar_melhores_janelas(
+                dados_meteorologicos, fases, consulta, anos);
+
+            fs::create_directories(pasta_saida);
+            std::ofstream(pasta_saida / "melhores_janelas.csv")
+                << model::summary::gerar_csv_melhores(melhores);
+            std::cout << "Melhores janelas: " << melhores.janelas.size() << " selecionadas; "
+                      << melhores.dias_avaliados << " de " << melhores.dias_candidatos
+                      << " dias iniciais avaliados por completo\n";
+            return 0;
+        }
+
+        // Fatia de um processo: grava as contagens brutas para o merge
+        if (opcoes.fatia_total > 0) {
+            const auto parcial = model::viab::rodar_fatia(dados_meteorologicos, fases,
+                                                          opcoes.fatia_indice, opcoes.fatia_total);
+            fs::create_directories(pasta_saida);
+            const fs::path destino = pasta_saida / model::io::nome_parcial(opcoes.fatia_indice,
+                                                                           opcoes.fatia_total);
+            model::io::gravar_parcial(destino.string(), parcial);
+            std::cout << "Fatia " << opcoes.fatia_indice << "/" << opcoes.fatia_total << ": "
+                      << parcial.dias_iniciais.size() << " dias iniciais -> " << destino.string() << "\n";
+            return 0;
+        }
+
+        // Rotação: duas safras encadeadas por primeira data de semeadura
+        if (!opcoes.rotacao.empty()) {
+            if (!fs::exists(opcoes.rotacao))
+                throw std::runtime_error("Arquivo json da segunda safra não encontrado: " + opcoes.rotacao);
+            const auto segunda = model::io::carregar_fases(opcoes.rotacao);
+            const auto rotacao = model::viab::rodar_analise_rotacao(
+                dados_meteorologicos, fases, segunda, {opcoes.intervalo_min, opcoes.intervalo_max});
+            fs::create_directories(pasta_saida);
+            std::ofstream(pasta_saida / "analise_rotacao.csv") << model::summary::gerar_csv_rotacao(rotacao);
+            const auto viaveis = std::count_if(rotacao.begin(), rotacao.end(), [](const auto& r) {
+                return r.prob_viabilidade_conjunta > 0.0;
+            });
+            std::cout << "Rotação: " << viaveis << " de " << rotacao.size()
+                      << " primeiras semeaduras com par de safras viável\n";
+            return 0;
+        }
+
+        std::vector<model::viab::ResultadoHorario> resultado_horario;
+        std::vector<model::viab::ResultadoData> resultado_dupla;   // referência de --validar-precisao
+        std::vector<model::viab::ResultadoEnsemble> resultado_ensemble;
+        std::vector<model::viab::ResultadoData> Resultado;
+        std::vector<model::viab::FalhasDia> falhas;
+        std::vector<model::viab::ResultadoCondicional> resultado_condicional;
+        if (opcoes.imputacoes > 0) {
+            // Médias das realizações alimentam os relatórios usuais
+            resultado_ensemble = model::viab::rodar_ensemble_imputacao(serie_lacunas, fases,
+                                                                        opcoes.imputacoes);
+            for (const auto& r : resultado_ensemble) Resultado.push_back(r.media);
+        } else if (modo_horario) {
+            // Semente base da execução; cada dia deriva a sua, como no caminho genérico
+            const std::uint64_t semente =
+                (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+            resultado_horario = model::viab::rodar_analise_horaria(serie_horaria, fases, semente);
+            for (const auto& r : resultado_horario) Resultado.push_back(r.base);
+        } else if (opcoes.modo == "gdd") {
+            Resultado = model::viab::rodar_analise_gdd(dados_meteorologicos, fases);
+        } else if (!opcoes.estado.empty()) {
+            // Recalcula só os dias iniciais alcançados pelas fases alteradas desde o último estado
+            const auto execucao = model::io::rodar_analise_incremental(dados_meteorologicos, fases,
+                                                                        opcoes.estado);
+            if (execucao.completa)
+                std::cout << "Estado " << opcoes.estado << " ausente ou incompatível: execução completa\n";
+            else
+                std::cout << "Incremental: " << execucao.fases_alteradas << " fases alteradas, "
+                          << execucao.dias_recalculados << " dias iniciais recalculados, "
+                          << execucao.dias_reaproveitados << " reaproveitados\n";
+            Resultado = execucao.resultados;
+        } else if (!opcoes.checkpoint.empty()) {
+            // Motor de tabelas com sementes por dia: retomar reproduz a execução sem interrupção
+            fs::create_directories(pasta_saida);
+            const auto execucao = model::io::rodar_analise_com_checkpoint(
+                dados_meteorologicos, fases, opcoes.checkpoint, opcoes.retomar);
+            if (execucao.invalidado)
+                std::cout << "Checkpoint de outra execução (entrada, fases ou configuração mudaram); recomeçando\n";
+            std::cout << "Checkpoint " << opcoes.checkpoint << ": " << execucao.dias_retomados
+                      << " dias iniciais retomados, " << execucao.dias_avaliados << " avaliados ("
+                      << execucao.dias_descartados << " descartados pelo pré-filtro)\n";
+            Resultado = execucao.resultados;
+        } else if (!opcoes.precisao.empty()) {
+            size_t descartados = 0;
+            Resultado = model::viab::rodar_analise_tabelas(
+                dados_meteorologicos, fases,
+                opcoes.precisao == "simples" ? model::viab::Precisao::Simples : model::viab::Precisao::Dupla,
+                0, &descartados);
+            std::cout << "Pré-filtro: " << descartados << " de " << Resultado.size()
+                      << " dias iniciais sem caminho viável possível\n";
+            if (opcoes.validar_precisao)
+                resultado_dupla = model::viab::rodar_analise_tabelas(dados_meteorologicos, fases,
+                                                                     model::viab::Precisao::Dupla);
+        } else if (!opcoes.estatisticas.empty()) {
+            // Motor de tabelas guardando, por dia inicial, o histograma dos excessos de temperatura
+            model::viab::EstatisticasPenalidade estatisticas;
+            Resultado = model::viab::rodar_analise_estatisticas(dados_meteorologicos, fases, estatisticas);
+            model::io::gravar_estatisticas(opcoes.estatisticas, estatisticas);
+            std::cout << "Estatísticas de calibração gravadas em " << opcoes.estatisticas << "\n";
+        } else if (opcoes.condicional > 0) {
+            // Só caminhos viáveis são sorteados, reponderados contra o sorteio uniforme
+            resultado_condicional = model::viab::rodar_analise_condicional(dados_meteorologicos, fases,
+                                                                           opcoes.condicional);
+            for (const auto& r : resultado_condicional) Resultado.push_back(r.base);
+        } else if (usar_catalogo) {
+            Resultado = model::viab::rodar_analise_cultivar(dados_meteorologicos, opcoes.cultivar);
+        } else {
+            Resultado = model::viab::rodar_analise(dados_meteorologicos, fases,
+                                                   opcoes.falhas ? &falhas : nullptr);
+        }
 
         // ======================================
         // 5. Geração de Relatórios
         // ======================================
         fs::create_directories(pasta_saida);
 
-        // 5.1 CSV Detalhado
-        std::ofstream(std::string(pasta_saida)+"/analise_detalhada.csv")<<model::summary::gerar_csv_detalhado(Resultado);
+        // 5.1 CSV Detalhado (opcional: os gráficos usam as séries de 5.3)
+        if (!opcoes.sem_detalhado) {
+            std::ofstream(std::string(pasta_saida)+"/analise_detalhada.csv")
+                << (modo_horario ? model::summary::gerar_csv_detalhado_horario(resultado_horario)
+                                 : model::summary::gerar_csv_detalhado(Resultado));
+        }
 
         // 5.2 CSV Resumo Mensal
         std::ofstream(std::string(pasta_saida)+"/resumo_mensal.csv")<<model::summary::gerar_csv_resumo_mensal(Resultado,dados_meteorologicos);
 
+        // 5.3 Séries prontas para os gráficos: média móvel, barras mensais e faixas de 95%
+        {
+            const auto series = model::summary::gerar_series_grafico(Resultado, resultado_ensemble);
+            std::ofstream(pasta_saida / "grafico_evolucao.csv") << model::summary::gerar_csv_grafico_evolucao(series);
+            std::ofstream(pasta_saida / "grafico_mensal.csv") << model::summary::gerar_csv_grafico_mensal(series);
+        }
+
+        // 5.4 Dispersão entre realizações de imputação
+        if (!resultado_ensemble.empty()) {
+            std::ofstream(pasta_saida / "analise_ensemble.csv")
+                << model::summary::gerar_csv_ensemble(resultado_ensemble);
+        }
+
+        // 5.5 Desvio float × double por campo
+        if (opcoes.validar_precisao) {
+            const auto validacao = model::viab::comparar_precisao(resultado_dupla, Resultado);
+            std::ofstream(pasta_saida / "validacao_precisao.csv")
+                << model::summary::gerar_csv_validacao_precisao(validacao, Resultado);
+            std::cout << "Validação de precisão: " << validacao.dias_divergentes << " de "
+                      << Resultado.size() << " dias com algum campo diferente\n";
+            for (const auto& c : validacao.campos)
+                std::cout << "  " << c.campo << ": desvio máximo " << std::scientific
+                          << c.desvio_max << std::defaultfloat << "\n";
+        }
+
+        // 5.6 Fase e limite da primeira falha dos caminhos inviáveis
+        if (opcoes.falhas) {
+            std::ofstream(pasta_saida / "analise_falhas.csv")
+                << model::summary::gerar_csv_falhas(falhas, Resultado);
+        }
+
+        // 5.7 Erro padrão do estimador condicional
+        if (!resultado_condicional.empty()) {
+            std::ofstream(pasta_saida / "analise_condicional.csv")
+                << model::summary::gerar_csv_condicional(resultado_condicional);
+        }
+
+        // 5.8 Climatologia por dia do calendário: entram os anos desta série, saem os que excedem a janela
+        if (!opcoes.climatologia.empty()) {
+            // Só anos do mesmo modelo (fases, constantes e modo de análise) entram na janela
+            model::io::ModoClimatologia modo;
+            modo.modo = opcoes.modo;
+            modo.imputacoes = opcoes.imputacoes;
+            modo.precisao_simples = opcoes.precisao == "simples";
+            modo.condicional = opcoes.condicional;
+            const auto impressao = model::io::impressao_climatologia(fases, modo);
+            int janela_gravada = 0;
+            auto climatologia = fs::exists(opcoes.climatologia)
+                ? model::io::ler_climatologia(opcoes.climatologia, impressao, opcoes.anos_janela, &janela_gravada)
+                : model::summary::ClimatologiaMovel(opcoes.anos_janela > 0 ? opcoes.anos_janela
+                                                                           : model::summary::ANOS_JANELA_PADRAO);
+            if (janela_gravada > 0 && janela_gravada != climatologia.anos_janela())
+                std::cout << "Aviso: janela da climatologia alterada de " << janela_gravada << " para "
+                          << climatologia.anos_janela() << " anos\n";
+            for (const auto& [ano, resultados] :
+                 model::summary::separar_anos(model::summary::extrair_colunas(Resultado)))
+                climatologia.incluir_ano(ano, resultados);
+            model::io::gravar_climatologia(opcoes.climatologia, climatologia, impressao);
+            std::ofstream(pasta_saida / "climatologia_dia_do_ano.csv")
+                << model::summary::gerar_csv_climatologia(climatologia);
+            if (!climatologia.anos().empty())
+                std::cout << "Climatologia: " << climatologia.anos().size() << " anos na janela ("
+                          << climatologia.anos().begin()->first << "-" << climatologia.anos().rbegin()->first
+                          << ")\n";
+        }
+
+        // 5.9 K dias iniciais refeitos pelo caminho de referência (avaliar_sequencia)
+        if (opcoes.verificar > 0) {
+            const auto plano = model::viab::planejar_analise(fases);
+            model::viab::ConfiguracaoVerificacao cfg;
+            cfg.dias = opcoes.verificar;
+            cfg.semente = (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+            cfg.producao_amostrada = opcoes.condicional > 0 ||
+                                     (plano.usar_amostragem && !model::viab::tem_pesos(fases));
+            cfg.amostras_producao = opcoes.condicional > 0 ? opcoes.condicional : plano.amostras;
+            if (opcoes.precisao == "simples") cfg.tolerancia = 1e-4;   // penalidade acumulada em float
+            const auto verificacao = model::viab::verificar_resultados(dados_meteorologicos, fases,
+                                                                        Resultado, cfg);
+            std::ofstream(pasta_saida / "verificacao.csv") << model::summary::gerar_csv_verificacao(verificacao);
+            const int discordancias = model::viab::contar_discordancias(verificacao);
+            std::cout << "Verificação: " << verificacao.size() << " dias iniciais (semente " << cfg.semente
+                      << "), " << discordancias << " campos discordantes da referência\n";
+            if (discordancias > 0)
+                std::cerr << "ATENÇÃO: resultados divergem do caminho de referência; ver verificacao.csv\n";
+        }
+
+        // 5.10 Resumos agrupados
+        gravar_agrupamentos(pasta_saida, Resultado, agrupamentos, janelas);
+
         return 0;
     }
     catch (const std::invalid_argument& ia) {
-        std::cerr << "Argumento inválido: " << ia.what() << "\n";
+        std::cerr << "Argumento inválido: " << ia.what() << "\n"
+                  << cli::uso(argv[0]) << "\n";
         return 1;
     }
     catch (const std::runtime_error& re) {
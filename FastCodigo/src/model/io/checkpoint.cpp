@@ -0,0 +1,192 @@
+#include "checkpoint.h"
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include "../viab/particao.h"
+
+namespace model::io {
+
+namespace {
+
+constexpr char ASSINATURA[8] = {'R', 'G', 'C', 'H', 'K', 'P', '\0', '\0'};
+constexpr std::uint32_t VERSAO = 1;
+constexpr size_t TAMANHO_CABECALHO = sizeof(ASSINATURA) + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+// dia (i32), cinco contadores (i64), soma_rend (double), soma de verificação (u32)
+constexpr size_t TAMANHO_DADOS = sizeof(std::int32_t) + 5 * sizeof(std::int64_t) + sizeof(double);
+constexpr size_t TAMANHO_REGISTRO = TAMANHO_DADOS + sizeof(std::uint32_t);
+
+// FNV-1a 32 dos bytes do registro
+std::uint32_t verificacao(const char* p, size_t n) {
+    std::uint32_t h = 0x811c9dc5u;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= static_cast<unsigned char>(p[i]);
+        h *= 0x01000193u;
+    }
+    return h;
+}
+
+template <typename T>
+char* escrever(char* p, const T& v) {
+    std::memcpy(p, &v, sizeof(T));
+    return p + sizeof(T);
+}
+
+template <typename T>
+const char* ler(const char* p, T& v) {
+    std::memcpy(&v, p, sizeof(T));
+    return p + sizeof(T);
+}
+
+void codificar(char* p, int dia, const viab::ContagemDia& c) {
+    char* q = escrever(p, static_cast<std::int32_t>(dia));
+    q = escrever(q, static_cast<std::int64_t>(c.amostras));
+    q = escrever(q, static_cast<std::int64_t>(c.viaveis));
+    q = escrever(q, static_cast<std::int64_t>(c.optimos));
+    q = escrever(q, static_cast<std::int64_t>(c.esb));
+    q = escrever(q, static_cast<std::int64_t>(c.red));
+    q = escrever(q, c.soma_rend);
+    escrever(q, verificacao(p, TAMANHO_DADOS));
+}
+
+// false se a soma de verificação não bater
+bool decodificar(const char* p, int& dia, viab::ContagemDia& c) {
+    std::uint32_t esperado;
+    ler(p + TAMANHO_DADOS, esperado);
+    if (verificacao(p, TAMANHO_DADOS) != esperado) return false;
+    std::int32_t d;
+    std::int64_t v[5];
+    const char* q = ler(p, d);
+    for (auto& x : v) q = ler(q, x);
+    ler(q, c.soma_rend);
+    dia = d;
+    c.amostras = v[0];
+    c.viaveis = v[1];
+    c.optimos = v[2];
+    c.esb = v[3];
+    c.red = v[4];
+    return true;
+}
+
+} // namespace
+
+Checkpoint::Checkpoint(const std::string& caminho, std::uint64_t impressao, bool retomar)
+    : caminho_(caminho), ultima_gravacao_(std::chrono::steady_clock::now()) {
+    namespace fs = std::filesystem;
+    std::uintmax_t valido = 0;  // bytes aproveitáveis do arquivo existente
+    if (retomar && fs::exists(caminho)) {
+        std::ifstream in(caminho, std::ios::binary);
+        if (!in.is_open()) throw std::runtime_error("Não foi possível abrir o arquivo: " + caminho);
+        char cabecalho[TAMANHO_CABECALHO];
+        std::uint32_t versao = 0;
+        std::uint64_t impressao_arquivo = 0;
+        if (in.read(cabecalho, sizeof(cabecalho))) {
+            ler(ler(cabecalho + sizeof(ASSINATURA), versao), impressao_arquivo);
+        }
+        if (in && std::memcmp(cabecalho, ASSINATURA, sizeof(ASSINATURA)) == 0 &&
+            versao == VERSAO && impressao_arquivo == impressao) {
+            valido = TAMANHO_CABECALHO;
+            char registro[TAMANHO_REGISTRO];
+            int dia;
+            viab::ContagemDia c;
+            while (in.read(registro, sizeof(registro)) && decodificar(registro, dia, c)) {
+                concluidos_.emplace_back(dia, c);
+                valido += TAMANHO_REGISTRO;
+            }
+        } else {
+            invalidado_ = true;
+        }
+    }
+
+    if (valido > 0) {
+        // Corta o final truncado antes de voltar a acrescentar
+        fs::resize_file(caminho, valido);
+        out_.open(caminho, std::ios::binary | std::ios::app);
+    } else {
+        out_.open(caminho, std::ios::binary | std::ios::trunc);
+        if (out_.is_open()) {
+            char cabecalho[TAMANHO_CABECALHO];
+            std::memcpy(cabecalho, ASSINATURA, sizeof(ASSINATURA));
+            escrever(escrever(cabecalho + sizeof(ASSINATURA), VERSAO), impressao);
+            out_.write(cabecalho, sizeof(cabecalho));
+            out_.flush();
+        }
+    }
+    if (!out_) throw std::runtime_error("Não foi possível gravar o checkpoint: " + caminho);
+}
+
+Checkpoint::~Checkpoint() {
+    // Falhas aqui só custam recálculo ao retomar
+    std::lock_guard<std::mutex> trava(mutex_);
+    gravar_pendentes();
+}
+
+void Checkpoint::registrar(int dia, const viab::ContagemDia& contagem) {
+    std::lock_guard<std::mutex> trava(mutex_);
+    pendentes_.resize(pendentes_.size() + TAMANHO_REGISTRO);
+    codificar(pendentes_.data() + pendentes_.size() - TAMANHO_REGISTRO, dia, contagem);
+    ++num_pendentes_;
+    if (num_pendentes_ >= LOTE_REGISTROS ||
+        std::chrono::steady_clock::now() - ultima_gravacao_ >= INTERVALO_GRAVACAO)
+        gravar_pendentes();
+}
+
+void Checkpoint::sincronizar() {
+    std::lock_guard<std::mutex> trava(mutex_);
+    gravar_pendentes();
+    if (!out_) throw std::runtime_error("Erro ao gravar o checkpoint: " + caminho_);
+}
+
+void Checkpoint::gravar_pendentes() {
+    // Sem exceções aqui: roda dentro do laço paralelo; a falha fica no estado
+    // do stream e é relatada por sincronizar()
+    ultima_gravacao_ = std::chrono::steady_clock::now();
+    if (pendentes_.empty() || !out_) return;
+    out_.write(pendentes_.data(), static_cast<std::streamsize>(pendentes_.size()));
+    out_.flush();
+    pendentes_.clear();
+    num_pendentes_ = 0;
+}
+
+ExecucaoCheckpoint rodar_analise_com_checkpoint(const std::vector<viab::Dia>& dias,
+                                                const std::vector<viab::Fase>& fases,
+                                                const std::string& caminho, bool retomar,
+                                                std::uint64_t semente) {
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+
+    const int n = static_cast<int>(dias.size());
+    ExecucaoCheckpoint out;
+    out.resultados.resize(n);
+    if (n == 0 || fases.empty()) return out;
+
+    const viab::PlanoAnalise plano = viab::planejar_analise(fases);
+    Checkpoint checkpoint(caminho, viab::impressao_execucao(dias, fases, semente), retomar);
+    out.invalidado = checkpoint.invalidado();
+
+    std::vector<char> concluido(n, 0);
+    for (const auto& [d, c] : checkpoint.concluidos()) {
+        if (d < 0 || d + plano.dias_min > n) continue;
+        out.resultados[d] = viab::finalizar_contagem(c, plano);
+        out.resultados[d].data_str = dias[d].data_str;
+        if (!concluido[d]) ++out.dias_retomados;
+        concluido[d] = 1;
+    }
+
+    std::vector<int> pendentes;
+    for (int d = 0; d + plano.dias_min <= n; ++d)
+        if (!concluido[d]) pendentes.push_back(d);
+    out.dias_avaliados = pendentes.size();
+
+    out.dias_descartados = viab::avaliar_dias(dias, fases, pendentes, semente,
+                       [&](size_t j, const viab::ContagemDia& c) {
+        const int d = pendentes[j];
+        out.resultados[d] = viab::finalizar_contagem(c, plano);
+        out.resultados[d].data_str = dias[d].data_str;
+        checkpoint.registrar(d, c);
+    });
+    checkpoint.sincronizar();
+    return out;
+}
+
+} // namespace model::io
@@ -0,0 +1,92 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../viab/dia.h"
+#include "../viab/fase.h"
+#include "../viab/motor_tabelas.h"
+
+namespace model::io {
+
+/**
+ * @brief Checkpoint de uma análise longa (--checkpoint / --resume)
+ *
+ * Arquivo só de acréscimo: cabeçalho com assinatura "RGCHKP", versão e a
+ * impressão digital da execução (viab::impressao_execucao), seguido de
+ * registros de tamanho fixo (dia inicial, ContagemDia, soma de verificação).
+ * Os registros ficam em memória e vão ao disco em lotes, por quantidade ou
+ * por tempo, para que o custo de E/S não pese no laço paralelo.
+ *
+ * Ao retomar, lê os registros íntegros e descarta um final truncado ou
+ * corrompido (processo interrompido no meio de uma gravação). Se a impressão
+ * não bater — série, fases, semente ou constantes do modelo mudaram — o
+ * checkpoint anterior é ignorado e a execução recomeça do zero.
+ */
+class Checkpoint {
+public:
+    /**
+     * @param retomar false recria o arquivo; true reaproveita os registros válidos
+     * @throws std::runtime_error se o arquivo não puder ser aberto/gravado
+     */
+    Checkpoint(const std::string& caminho, std::uint64_t impressao, bool retomar);
+    ~Checkpoint();
+
+    Checkpoint(const Checkpoint&) = delete;
+    Checkpoint& operator=(const Checkpoint&) = delete;
+
+    // Registros lidos na abertura (dia inicial, contagens), na ordem do arquivo
+    const std::vector<std::pair<int, viab::ContagemDia>>& concluidos() const { return concluidos_; }
+
+    // true se havia um checkpoint de outra execução e ele foi descartado
+    bool invalidado() const { return invalidado_; }
+
+    // Acrescenta um dia concluído; seguro entre threads
+    void registrar(int dia, const viab::ContagemDia& contagem);
+
+    // Grava o lote pendente; std::runtime_error se alguma gravação falhou
+    void sincronizar();
+
+    static constexpr size_t LOTE_REGISTROS = 256;
+    static constexpr std::chrono::seconds INTERVALO_GRAVACAO{2};
+
+private:
+    void gravar_pendentes();
+
+    std::string caminho_;
+    std::ofstream out_;
+    std::mutex mutex_;
+    std::vector<char> pendentes_;
+    size_t num_pendentes_ = 0;
+    std::chrono::steady_clock::time_point ultima_gravacao_;
+    std::vector<std::pair<int, viab::ContagemDia>> concluidos_;
+    bool invalidado_ = false;
+};
+
+// Resultado de rodar_analise_com_checkpoint
+struct ExecucaoCheckpoint {
+    std::vector<viab::ResultadoData> resultados;  // como rodar_analise
+    size_t dias_retomados = 0;                    // lidos do checkpoint
+    size_t dias_avaliados = 0;                    // calculados nesta execução
+    size_t dias_descartados = 0;                  // dos avaliados, zerados pelo pré-filtro
+    bool invalidado = false;
+};
+
+/**
+ * @brief Análise completa pelo motor de tabelas com checkpoint periódico
+ *
+ * Cada dia inicial usa semente_dia(semente, dia) na amostragem, então
+ * retomar produz exatamente o mesmo resultado de uma execução sem interrupção.
+ *
+ * @throws std::invalid_argument se alguma fase tiver durMin > durMax
+ * @throws std::runtime_error em falha de E/S no checkpoint
+ */
+ExecucaoCheckpoint rodar_analise_com_checkpoint(const std::vector<viab::Dia>& dias,
+                                                const std::vector<viab::Fase>& fases,
+                                                const std::string& caminho, bool retomar,
+                                                std::uint64_t semente = 0);
+
+} // namespace model::io
@@ -0,0 +1,113 @@
+#include "climatologia_io.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "../viab/particao.h"
+
+namespace model::io {
+
+namespace {
+
+constexpr char ASSINATURA[8] = {'R', 'G', 'C', 'L', 'I', 'M', '\0', '\0'};
+constexpr std::uint32_t VERSAO = 3;   // 2: impressão digital do modelo; 3: com o modo de análise
+
+// FNV-1a 64 incremental, continuando de uma impressão já calculada
+struct Fnv {
+    std::uint64_t h;
+
+    void bytes(const void* p, size_t n) {
+        const auto* b = static_cast<const unsigned char*>(p);
+        for (size_t i = 0; i < n; ++i) {
+            h ^= b[i];
+            h *= 0x100000001b3ULL;
+        }
+    }
+    template <typename T>
+    void valor(const T& v) { bytes(&v, sizeof(T)); }
+};
+
+} // namespace
+
+std::uint64_t impressao_climatologia(const std::vector<viab::Fase>& fases, const ModoClimatologia& modo) {
+    Fnv fnv{viab::impressao_execucao({}, fases, 0)};
+    fnv.valor(modo.modo.size());
+    fnv.bytes(modo.modo.data(), modo.modo.size());
+    fnv.valor(modo.imputacoes);
+    fnv.valor(modo.precisao_simples);
+    fnv.valor(modo.condicional);
+    // Campos das fases que só o modo horário ou o GDD leem
+    for (const auto& f : fases) {
+        if (modo.modo == "horario") {
+            fnv.valor(f.toleranciaGH);
+        } else if (modo.modo == "gdd") {
+            fnv.valor(f.gddAlvo);
+            fnv.valor(f.gddTolerancia);
+            fnv.valor(f.tBase);
+        }
+    }
+    return fnv.h;
+}
+
+void gravar_climatologia(const std::string& caminho, const summary::ClimatologiaMovel& c,
+                         std::uint64_t impressao) {
+    // Grava ao lado e renomeia: uma falha no meio não destrói o histórico anterior
+    const std::string temporario = caminho + ".tmp";
+    {
+        std::ofstream out(temporario, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) throw std::runtime_error("Não foi possível criar o arquivo: " + temporario);
+        const auto janela = static_cast<std::uint32_t>(c.anos_janela());
+        const auto anos = static_cast<std::uint32_t>(c.anos().size());
+        out.write(ASSINATURA, sizeof(ASSINATURA));
+        out.write(reinterpret_cast<const char*>(&VERSAO), sizeof(VERSAO));
+        out.write(reinterpret_cast<const char*>(&impressao), sizeof(impressao));
+        out.write(reinterpret_cast<const char*>(&janela), sizeof(janela));
+        out.write(reinterpret_cast<const char*>(&anos), sizeof(anos));
+        for (const auto& [ano, r] : c.anos()) {
+            const auto ano32 = static_cast<std::int32_t>(ano);
+            out.write(reinterpret_cast<const char*>(&ano32), sizeof(ano32));
+            out.write(r.presente.data(), sizeof(r.presente));
+            out.write(reinterpret_cast<const char*>(r.valores.data()), sizeof(r.valores));
+        }
+        if (!out) throw std::runtime_error("Erro ao gravar o arquivo: " + temporario);
+    }
+    std::filesystem::rename(temporario, caminho);
+}
+
+summary::ClimatologiaMovel ler_climatologia(const std::string& caminho, std::uint64_t impressao,
+                                            int anos_janela, int* janela_gravada) {
+    std::ifstream in(caminho, std::ios::binary);
+    if (!in.is_open()) throw std::runtime_error("Não foi possível abrir o arquivo: " + caminho);
+    auto ler = [&](void* destino, std::size_t tamanho) {
+        if (!in.read(static_cast<char*>(destino), static_cast<std::streamsize>(tamanho)))
+            throw std::runtime_error("Arquivo de climatologia truncado: " + caminho);
+    };
+    char assinatura[sizeof(ASSINATURA)];
+    ler(assinatura, sizeof(assinatura));
+    if (std::memcmp(assinatura, ASSINATURA, sizeof(ASSINATURA)) != 0)
+        throw std::runtime_error("Arquivo não é uma climatologia: " + caminho);
+    std::uint32_t versao = 0, janela = 0, anos = 0;
+    ler(&versao, sizeof(versao));
+    if (versao != VERSAO) throw std::runtime_error("Versão de climatologia desconhecida: " + caminho);
+    std::uint64_t impressao_arquivo = 0;
+    ler(&impressao_arquivo, sizeof(impressao_arquivo));
+    if (impressao_arquivo != impressao)
+        throw std::runtime_error("Climatologia gerada com outras fases, constantes ou modo de análise: " + caminho);
+    ler(&janela, sizeof(janela));
+    ler(&anos, sizeof(anos));
+    if (janela_gravada) *janela_gravada = static_cast<int>(janela);
+
+    summary::ClimatologiaMovel c(anos_janela > 0 ? anos_janela : static_cast<int>(janela));
+    summary::AnoClimatologia r;
+    for (std::uint32_t i = 0; i < anos; ++i) {
+        std::int32_t ano = 0;
+        ler(&ano, sizeof(ano));
+        ler(r.presente.data(), sizeof(r.presente));
+        ler(r.valores.data(), sizeof(r.valores));
+        c.incluir_ano(ano, r);
+    }
+    return c;
+}
+
+} // namespace model::io
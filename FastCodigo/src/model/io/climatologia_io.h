@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../summary/climatologia.h"
+#include "../viab/fase.h"
+
+namespace model::io {
+
+/**
+ * @brief Grava/lê os anos de uma climatologia móvel (--climatologia)
+ *
+ * Formato (ordem de bytes do host): assinatura "RGCLIM", versão, impressão
+ * digital do modelo, tamanho da janela, número de anos e, por ano, o ano
+ * (int32), a presença de cada dia do calendário (DIAS_CALENDARIO bytes) e os
+ * valores [dia][métrica] em double. Só os resultados anuais são guardados; as
+ * somas da janela são refeitas na leitura, então arredondamentos não se
+ * acumulam entre execuções.
+ *
+ * A impressão é impressao_climatologia(): anos de outro modelo (fases,
+ * constantes ou modo de análise diferentes) não entram na janela.
+ *
+ * @throws std::runtime_error em falha de E/S, assinatura/versão desconhecida
+ *         ou arquivo truncado
+ */
+// Modo de análise que produziu os anos de uma climatologia
+struct ModoClimatologia {
+    std::string modo = "diario";   // "diario", "horario" ou "gdd"
+    int imputacoes = 0;            // realizações do ensemble de imputação (0 = sem lacunas)
+    bool precisao_simples = false; // penalidade em float no motor de tabelas
+    long long condicional = 0;     // amostras do estimador condicional (0 = desligado)
+};
+
+/**
+ * @brief Impressão digital do modelo de uma climatologia
+ *
+ * viab::impressao_execucao das fases, sem série nem semente, combinada com o
+ * modo e os parâmetros que só ele usa (tolerância de graus-hora no horário;
+ * alvo, tolerância e temperatura base no GDD).
+ */
+std::uint64_t impressao_climatologia(const std::vector<viab::Fase>& fases, const ModoClimatologia& modo);
+
+void gravar_climatologia(const std::string& caminho, const summary::ClimatologiaMovel& climatologia,
+                         std::uint64_t impressao);
+
+/**
+ * @brief Relê a climatologia gravada
+ *
+ * @param anos_janela Tamanho da janela (0 = o gravado); menor que o gravado,
+ *        os anos mais antigos excedentes são descartados
+ * @param janela_gravada Se não nulo, recebe o tamanho gravado no arquivo
+ * @throws std::runtime_error também se a impressão gravada for outra
+ */
+summary::ClimatologiaMovel ler_climatologia(const std::string& caminho, std::uint64_t impressao,
+                                            int anos_janela = 0, int* janela_gravada = nullptr);
+
+} // namespace model::io
@@ -0,0 +1,127 @@
+#include "csv_horario_reader.h"
+#include "../summary/calendario.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace model::io {
+
+namespace {
+
+// Remove aspas e espaços; troca vírgula decimal por ponto
+std::string limpar_campo(std::string campo) {
+    campo.erase(std::remove(campo.begin(), campo.end(), '"'), campo.end());
+    while (!campo.empty() && (campo.back() == '\r' || campo.back() == ' ')) campo.pop_back();
+    std::replace(campo.begin(), campo.end(), ',', '.');
+    return campo;
+}
+
+std::vector<std::string> separar(const std::string& linha) {
+    std::vector<std::string> campos;
+    std::istringstream ss(linha);
+    std::string campo;
+    while (std::getline(ss, campo, ';')) campos.push_back(limpar_campo(campo));
+    return campos;
+}
+
+int coluna(const std::vector<std::string>& cabecalho, const std::string& prefixo, bool obrigatoria) {
+    for (size_t i = 0; i < cabecalho.size(); ++i)
+        if (cabecalho[i].rfind(prefixo, 0) == 0) return static_cast<int>(i);
+    if (obrigatoria)
+        throw std::runtime_error("Coluna não encontrada no CSV horário: " + prefixo);
+    return -1;
+}
+
+std::optional<double> temperatura(const std::vector<std::string>& campos, int col,
+                                  const std::string& data_str) {
+    if (col < 0 || col >= static_cast<int>(campos.size()) || campos[col].empty())
+        return std::nullopt;
+    double t;
+    try {
+        t = std::stod(campos[col]);
+    } catch (...) {
+        throw std::runtime_error("Temperatura inválida na data " + data_str + ": " + campos[col]);
+    }
+    if (t < -50 || t > 60)
+        throw std::runtime_error("Temperatura fora do intervalo válido na data: " + data_str);
+    return t;
+}
+
+} // namespace
+
+std::vector<viab::RegistroHorario> ler_dados_horarios(const std::string& caminho_arquivo) {
+    std::ifstream arquivo(caminho_arquivo);
+    if (!arquivo.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o arquivo: " + caminho_arquivo);
+    }
+
+    std::string linha;
+    std::getline(arquivo, linha);
+    if (linha.rfind("\xEF\xBB\xBF", 0) == 0) linha.erase(0, 3);   // BOM UTF-8
+    const auto cabecalho = separar(linha);
+    const int c_data = coluna(cabecalho, "Data", true);
+    const int c_hora = coluna(cabecalho, "Hora", true);
+    const int c_temp = coluna(cabecalho, "Temp. [Hora]", true);
+    const int c_tmax = coluna(cabecalho, "Temp. Max", false);
+    const int c_tmin = coluna(cabecalho, "Temp. Min", false);
+
+    std::vector<viab::RegistroHorario> registros;
+    summary::Data anterior{};
+    while (std::getline(arquivo, linha)) {
+        if (linha.empty() || linha == "\r") continue;
+        const auto campos = separar(linha);
+        if (static_cast<int>(campos.size()) <= std::max(c_data, c_hora))
+            throw std::runtime_error("Linha incompleta no CSV horário: " + linha);
+
+        const std::string& data_str = campos[c_data];
+        if (registros.empty() || registros.back().data_str != data_str) {
+            const auto data = summary::interpretar_data(data_str);
+            if (!data) throw std::runtime_error("Data inválida no CSV horário: " + data_str);
+            // Dias ausentes entre o anterior e este: marcados, sem leituras
+            if (!registros.empty()) {
+                auto esperado = summary::dia_seguinte(anterior);
+                while (std::tie(esperado.ano, esperado.mes, esperado.dia) <
+                       std::tie(data->ano, data->mes, data->dia)) {
+                    viab::RegistroHorario vazio;
+                    vazio.data_str = summary::formatar_data(esperado);
+                    vazio.mes = esperado.mes;
+                    vazio.ausente = true;
+                    registros.push_back(std::move(vazio));
+                    esperado = summary::dia_seguinte(esperado);
+                }
+                if (std::tie(esperado.ano, esperado.mes, esperado.dia) !=
+                    std::tie(data->ano, data->mes, data->dia))
+                    throw std::runtime_error("Data fora de ordem no CSV horário: " + data_str);
+            }
+            anterior = *data;
+            viab::RegistroHorario r;
+            r.data_str = data_str;
+            r.mes = data->mes;
+            registros.push_back(std::move(r));
+        }
+        auto& r = registros.back();
+
+        int hora;
+        try {
+            hora = std::stoi(campos[c_hora]) / 100;   // "1800" -> 18
+        } catch (...) {
+            throw std::runtime_error("Hora inválida na data " + data_str + ": " + campos[c_hora]);
+        }
+        if (hora < 0 || hora > 23)
+            throw std::runtime_error("Hora fora do intervalo na data: " + data_str);
+
+        if (auto t = temperatura(campos, c_temp, data_str)) r.leituras.emplace_back(hora, *t);
+        if (auto t = temperatura(campos, c_tmax, data_str)) r.tmax_diaria = *t;
+        if (auto t = temperatura(campos, c_tmin, data_str)) r.tmin_diaria = *t;
+    }
+
+    if (registros.empty()) {
+        throw std::runtime_error("Nenhum dado válido encontrado no arquivo CSV horário");
+    }
+    return registros;
+}
+
+} // namespace model::io
@@ -0,0 +1,19 @@
+#pragma once
+#include <vector>
+#include <string>
+#include "../viab/analise_horaria.h"
+namespace model::io {
+/**
+ * @brief Lê o CSV bruto de estação (uma linha por leitura sub-diária)
+ *
+ * Formato: separador ';', campos entre aspas, decimal com vírgula. Usa as
+ * colunas "Data", "Hora (UTC)", "Temp. [Hora] (C)" e, se existirem, as
+ * colunas de máxima/mínima diária. Campos vazios são tratados como falhas.
+ * Dias que faltam no arquivo entram sem leituras e com `ausente`, para que o
+ * índice horário de cada dia continue sendo 24 · posição; as horas desses
+ * dias são interpoladas como as demais falhas.
+ *
+ * @throws std::runtime_error em data inválida ou fora de ordem cronológica
+ */
+std::vector<viab::RegistroHorario> ler_dados_horarios(const std::string& caminho_arquivo);
+}
@@ -6,7 +6,17 @@
 
 namespace model::io {
 
-std::vector<viab::Dia> ler_dados(const std::string& caminho_arquivo) {
+namespace {
+
+// Campo de temperatura ausente: vazio ou NaN (saída do pandas sem imputação)
+bool campo_ausente(const std::string& campo) {
+    return campo.empty() || campo == "nan" || campo == "NaN" || campo == "NA";
+}
+
+// Leitura comum; com `leituras` não nulo, dias sem Tmax/Tmin ou com leituras
+// horárias ausentes (4ª coluna, "Ausentes") são aceitos e marcados
+std::vector<viab::Dia> ler_serie(const std::string& caminho_arquivo, std::vector<char>* lacunas,
+                                 std::vector<viab::LeiturasDia>* leituras) {
     std::vector<viab::Dia> dados;
     std::ifstream arquivo(caminho_arquivo);
     
@@ -15,12 +25,13 @@ std::vector<viab::Dia> ler_dados(const std::string& caminho_arquivo) {
     }
     
     std::string linha;
-    // Pular a linha de cabeçalho (Data;Tmax;Tmin)
+    // Pular a linha de cabeçalho (Data;Tmax;Tmin[;Ausentes])
     std::getline(arquivo, linha);
     
     while (std::getline(arquivo, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
         std::istringstream ss(linha);
-        std::string data_str, tmax_str, tmin_str;
+        std::string data_str, tmax_str, tmin_str, ausentes_str;
         viab::Dia dia;
         
         // Formato esperado: Data;Tmax;Tmin
@@ -44,7 +55,46 @@ std::vector<viab::Dia> ler_dados(const std::string& caminho_arquivo) {
         
         // Lê Tmax
         if (!std::getline(ss, tmax_str, ';')) {
-            throw std::runtime_error("Erro ao ler a temperatura máxima no CSV");
+            if (!lacunas) throw std::runtime_error("Erro ao ler a temperatura máxima no CSV");
+            tmax_str.clear();
+        }
+        std::getline(ss, tmin_str, ';');
+        std::getline(ss, ausentes_str);
+        if (lacunas) {
+            viab::LeiturasDia l;
+            l.tmax_observada = !campo_ausente(tmax_str);
+            l.tmin_observada = !campo_ausente(tmin_str);
+            const bool completo = l.tmax_observada && l.tmin_observada;
+            if (ausentes_str.empty()) {
+                l.ausentes = completo ? 0 : viab::LEITURAS_DIA;
+            } else {
+                try {
+                    l.ausentes = std::stoi(ausentes_str);
+                } catch (...) {
+                    throw std::runtime_error("Leituras ausentes inválidas: " + ausentes_str);
+                }
+                if (l.ausentes < 0 || l.ausentes > viab::LEITURAS_DIA || (!completo && l.ausentes == 0))
+                    throw std::runtime_error("Leituras ausentes inválidas na data: " + data_str);
+            }
+            if (l.ausentes > 0) {
+                // Extremos observados são validados; os ausentes são preenchidos pelas realizações
+                dia.tmax = dia.tmin = 0.0;
+                try {
+                    if (l.tmax_observada) dia.tmax = std::stod(tmax_str);
+                    if (l.tmin_observada) dia.tmin = std::stod(tmin_str);
+                } catch (...) {
+                    throw std::runtime_error("Temperatura inválida na data: " + data_str);
+                }
+                if (completo && dia.tmin > dia.tmax)
+                    throw std::runtime_error("Temperatura mínima maior que máxima na data: " + data_str);
+                if (dia.tmax < -50 || dia.tmax > 60 || dia.tmin < -50 || dia.tmin > 60)
+                    throw std::runtime_error("Temperatura fora do intervalo válido na data: " + data_str);
+                dados.push_back(dia);
+                lacunas->push_back(1);
+                leituras->push_back(l);
+                continue;
+            }
+            leituras->push_back(l);
         }
         try {
             dia.tmax = std::stod(tmax_str);
@@ -53,7 +103,7 @@ std::vector<viab::Dia> ler_dados(const std::string& caminho_arquivo) {
         }
         
         // Lê Tmin
-        if (!std::getline(ss, tmin_str)) {
+        if (tmin_str.empty()) {
             throw std::runtime_error("Erro ao ler a temperatura mínima no CSV");
         }
         try {
@@ -72,6 +122,7 @@ std::vector<viab::Dia> ler_dados(const std::string& caminho_arquivo) {
         }
         
         dados.push_back(dia);
+        if (lacunas) lacunas->push_back(0);
     }
     
     if (dados.empty()) {
@@ -81,4 +132,16 @@ std::vector<viab::Dia> ler_dados(const std::string& caminho_arquivo) {
     return dados;
 }
 
+} // namespace
+
+std::vector<viab::Dia> ler_dados(const std::string& caminho_arquivo) {
+    return ler_serie(caminho_arquivo, nullptr, nullptr);
+}
+
+viab::SerieComLacunas ler_dados_com_lacunas(const std::string& caminho_arquivo) {
+    viab::SerieComLacunas serie;
+    serie.dias = ler_serie(caminho_arquivo, &serie.lacuna, &serie.leituras);
+    return serie;
+}
+
 } // namespace model::io
\ No newline at end of file
@@ -2,6 +2,10 @@
 #include <vector>
 #include <string>
 #include "../viab/dia.h"
+#include "../viab/ensemble_imputacao.h"
 namespace model::io {
 std::vector<viab::Dia> ler_dados(const std::string& filepath);
-}
\ No newline at end of file
+// Como ler_dados, aceitando Tmax/Tmin vazios ou NaN e a coluna opcional
+// "Ausentes" (leituras horárias faltantes do dia) como lacunas a imputar
+viab::SerieComLacunas ler_dados_com_lacunas(const std::string& filepath);
+}
@@ -0,0 +1,239 @@
+#include "estado_incremental.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "../viab/incremental.h"
+#include "../viab/particao.h"
+
+namespace model::io {
+
+namespace {
+
+constexpr char ASSINATURA[8] = {'R', 'G', 'E', 'S', 'T', 'D', '\0', '\0'};
+constexpr std::uint32_t VERSAO = 1;
+
+struct Escritor {
+    std::ofstream& out;
+    template <typename T>
+    void valor(const T& v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+    template <typename T>
+    void vetor(const std::vector<T>& v) {
+        valor(static_cast<std::uint64_t>(v.size()));
+        out.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(T)));
+    }
+    void texto(const std::string& s) {
+        valor(static_cast<std::uint32_t>(s.size()));
+        out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+};
+
+// Lança std::runtime_error em arquivo truncado; ler_estado converte em false
+struct Leitor {
+    std::ifstream& in;
+    template <typename T>
+    T valor() {
+        T v{};
+        if (!in.read(reinterpret_cast<char*>(&v), sizeof(T))) throw std::runtime_error("estado truncado");
+        return v;
+    }
+    template <typename T>
+    std::vector<T> vetor(std::uint64_t esperado) {
+        if (valor<std::uint64_t>() != esperado) throw std::runtime_error("estado inconsistente");
+        std::vector<T> v(esperado);
+        if (!in.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(esperado * sizeof(T))))
+            throw std::runtime_error("estado truncado");
+        return v;
+    }
+    std::string texto() {
+        std::string s(valor<std::uint32_t>(), '\0');
+        if (!s.empty() && !in.read(&s[0], static_cast<std::streamsize>(s.size())))
+            throw std::runtime_error("estado truncado");
+        return s;
+    }
+};
+
+} // namespace
+
+void gravar_estado(const std::string& caminho, const EstadoIncremental& e) {
+    const std::string temporario = caminho + ".tmp";
+    {
+        std::ofstream out(temporario, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) throw std::runtime_error("Não foi possível criar o arquivo: " + temporario);
+        Escritor w{out};
+        out.write(ASSINATURA, sizeof(ASSINATURA));
+        w.valor(VERSAO);
+        w.valor(e.impressao_serie);
+        const std::uint64_t n = e.tabelas.empty() ? 0 : e.tabelas.front().inviaveis.size() - 1;
+        w.valor(n);
+        w.valor(static_cast<std::uint32_t>(e.fases.size()));
+        for (size_t i = 0; i < e.fases.size(); ++i) {
+            const auto& f = e.fases[i];
+            w.texto(f.nome);
+            w.valor(f.minT);
+            w.valor(f.maxT);
+            w.valor(f.optMinT);
+            w.valor(f.optMaxT);
+            w.valor(static_cast<std::int32_t>(f.durMin));
+            w.valor(static_cast<std::int32_t>(f.durMax));
+            w.valor(e.hashes[i]);
+            const auto& t = e.tabelas[i];
+            w.vetor(t.inviaveis);
+            w.vetor(t.nao_ideais);
+            w.vetor(t.penalidade);
+            w.vetor(t.esbranq);
+            w.vetor(t.reducao);
+            w.vetor(t.proximo_inviavel);
+        }
+        w.valor(static_cast<std::uint64_t>(e.dias_iniciais.size()));
+        for (size_t j = 0; j < e.dias_iniciais.size(); ++j) {
+            const auto& c = e.contagens[j];
+            w.valor(static_cast<std::int32_t>(e.dias_iniciais[j]));
+            w.valor(static_cast<std::int64_t>(c.amostras));
+            w.valor(static_cast<std::int64_t>(c.viaveis));
+            w.valor(static_cast<std::int64_t>(c.optimos));
+            w.valor(static_cast<std::int64_t>(c.esb));
+            w.valor(static_cast<std::int64_t>(c.red));
+            w.valor(c.soma_rend);
+        }
+        if (!out) throw std::runtime_error("Erro ao gravar o arquivo: " + temporario);
+    }
+    std::filesystem::rename(temporario, caminho);
+}
+
+bool ler_estado(const std::string& caminho, EstadoIncremental& e) {
+    std::ifstream in(caminho, std::ios::binary);
+    if (!in.is_open()) return false;
+    char assinatura[sizeof(ASSINATURA)];
+    if (!in.read(assinatura, sizeof(assinatura)) ||
+        std::memcmp(assinatura, ASSINATURA, sizeof(ASSINATURA)) != 0)
+        return false;
+    try {
+        Leitor r{in};
+        if (r.valor<std::uint32_t>() != VERSAO) return false;
+        EstadoIncremental lido;
+        lido.impressao_serie = r.valor<std::uint64_t>();
+        const auto n = r.valor<std::uint64_t>();
+        const auto num_fases = r.valor<std::uint32_t>();
+        for (std::uint32_t i = 0; i < num_fases; ++i) {
+            std::string nome = r.texto();
+            const double minT = r.valor<double>(), maxT = r.valor<double>();
+            const double optMinT = r.valor<double>(), optMaxT = r.valor<double>();
+            const int durMin = r.valor<std::int32_t>(), durMax = r.valor<std::int32_t>();
+            lido.fases.emplace_back(nome, minT, maxT, optMinT, optMaxT, durMin, durMax);
+            lido.hashes.push_back(r.valor<std::uint64_t>());
+            viab::TabelaFase t;
+            t.inviaveis = r.vetor<int>(n + 1);
+            t.nao_ideais = r.vetor<int>(n + 1);
+            t.penalidade = r.vetor<double>(n + 1);
+            t.esbranq = r.vetor<int>(n + 1);
+            t.reducao = r.vetor<int>(n + 1);
+            t.proximo_inviavel = r.vetor<int>(n + 1);
+            lido.tabelas.push_back(std::move(t));
+        }
+        const auto m = r.valor<std::uint64_t>();
+        for (std::uint64_t j = 0; j < m; ++j) {
+            const int dia = r.valor<std::int32_t>();
+            if (dia < 0 || static_cast<std::uint64_t>(dia) >= n) return false;
+            viab::ContagemDia c;
+            c.amostras = r.valor<std::int64_t>();
+            c.viaveis = r.valor<std::int64_t>();
+            c.optimos = r.valor<std::int64_t>();
+            c.esb = r.valor<std::int64_t>();
+            c.red = r.valor<std::int64_t>();
+            c.soma_rend = r.valor<double>();
+            lido.dias_iniciais.push_back(dia);
+            lido.contagens.push_back(c);
+        }
+        e = std::move(lido);
+        return true;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+ExecucaoIncremental rodar_analise_incremental(const std::vector<viab::Dia>& dias,
+                                              const std::vector<viab::Fase>& fases,
+                                              const std::string& caminho_estado,
+                                              std::uint64_t semente) {
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+
+    const int n = static_cast<int>(dias.size());
+    ExecucaoIncremental out;
+    out.resultados.resize(n);
+    if (n == 0 || fases.empty()) return out;
+
+    const viab::PlanoAnalise plano = viab::planejar_analise(fases);
+    EstadoIncremental novo;
+    novo.impressao_serie = viab::impressao_execucao(dias, {}, semente);
+    novo.fases = fases;
+    for (auto& f : fases) novo.hashes.push_back(viab::hash_fase(f));
+
+    // Tabelas guardadas valem para a mesma série, em qualquer posição: indexadas pelo hash da fase
+    EstadoIncremental antigo;
+    const bool mesma_serie = ler_estado(caminho_estado, antigo) &&
+        antigo.impressao_serie == novo.impressao_serie &&
+        !antigo.tabelas.empty() && antigo.tabelas.front().inviaveis.size() == static_cast<size_t>(n) + 1;
+    std::unordered_map<std::uint64_t, size_t> guardadas;
+    if (mesma_serie)
+        for (size_t i = 0; i < antigo.hashes.size(); ++i) guardadas.emplace(antigo.hashes[i], i);
+    for (size_t i = 0; i < fases.size(); ++i) {
+        const auto it = guardadas.find(novo.hashes[i]);
+        if (it != guardadas.end()) {
+            novo.tabelas.push_back(antigo.tabelas[it->second]);
+            ++out.tabelas_reaproveitadas;
+        } else {
+            novo.tabelas.push_back(viab::construir_tabelas(dias, {fases[i]}).front());
+        }
+    }
+
+    // Contagens reaproveitáveis só com o mesmo espaço de caminhos (número e durações das fases)
+    bool compativel = mesma_serie && antigo.fases.size() == fases.size();
+    for (size_t i = 0; compativel && i < fases.size(); ++i)
+        compativel = antigo.fases[i].durMin == fases[i].durMin && antigo.fases[i].durMax == fases[i].durMax;
+
+    std::vector<char> recalcular(n, 1);
+    std::vector<viab::ContagemDia> contagens(n);
+    if (compativel) {
+        out.completa = false;
+        std::fill(recalcular.begin(), recalcular.end(), 0);
+        // As contagens dependem da tabela em cada posição: compara com a que ocupava a mesma posição
+        for (size_t i = 0; i < fases.size(); ++i) {
+            if (antigo.hashes[i] == novo.hashes[i]) continue;
+            ++out.fases_alteradas;
+            const auto afetados = viab::inicios_afetados(
+                fases, i, viab::dias_alterados(antigo.tabelas[i], novo.tabelas[i]));
+            for (int d = 0; d < n; ++d) recalcular[d] |= afetados[d];
+        }
+        // Dias iniciais sem registro no estado também são recalculados
+        std::vector<char> registrado(n, 0);
+        for (size_t j = 0; j < antigo.dias_iniciais.size(); ++j) {
+            contagens[antigo.dias_iniciais[j]] = antigo.contagens[j];
+            registrado[antigo.dias_iniciais[j]] = 1;
+        }
+        for (int d = 0; d < n; ++d) recalcular[d] |= !registrado[d];
+    }
+
+    std::vector<int> pendentes;
+    for (int d = 0; d + plano.dias_min <= n; ++d) {
+        novo.dias_iniciais.push_back(d);
+        if (recalcular[d]) pendentes.push_back(d);
+    }
+    out.dias_recalculados = pendentes.size();
+    out.dias_reaproveitados = novo.dias_iniciais.size() - pendentes.size();
+    viab::avaliar_dias(novo.tabelas, fases, n, pendentes, semente,
+                       [&](size_t j, const viab::ContagemDia& c) { contagens[pendentes[j]] = c; });
+
+    for (int d : novo.dias_iniciais) {
+        novo.contagens.push_back(contagens[d]);
+        out.resultados[d] = viab::finalizar_contagem(contagens[d], plano);
+        out.resultados[d].data_str = dias[d].data_str;
+    }
+    gravar_estado(caminho_estado, novo);
+    return out;
+}
+
+} // namespace model::io
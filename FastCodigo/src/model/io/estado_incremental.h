@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../viab/dia.h"
+#include "../viab/fase.h"
+#include "../viab/motor_tabelas.h"
+
+namespace model::io {
+
+/**
+ * @brief Estado persistido entre execuções para recálculo incremental (--estado)
+ *
+ * Guarda a impressão digital da série (viab::impressao_execucao sem fases),
+ * as fases com o hash de cada uma, as tabelas por fase (avaliação dia a dia
+ * em somas prefixadas) e as contagens brutas de cada dia inicial.
+ *
+ * Formato (ordem de bytes do host): assinatura "RGESTD", versão, impressão,
+ * número de dias e de fases; por fase, nome, limites, durações, hash e os
+ * vetores da TabelaFase; por fim os registros (dia inicial, ContagemDia).
+ */
+struct EstadoIncremental {
+    std::uint64_t impressao_serie = 0;
+    std::vector<viab::Fase> fases;
+    std::vector<std::uint64_t> hashes;            // viab::hash_fase, alinhado com fases
+    std::vector<viab::TabelaFase> tabelas;
+    std::vector<int> dias_iniciais;
+    std::vector<viab::ContagemDia> contagens;     // alinhado com dias_iniciais
+};
+
+// Grava em arquivo temporário e renomeia, para não deixar estado pela metade
+// @throws std::runtime_error em falha de E/S
+void gravar_estado(const std::string& caminho, const EstadoIncremental& estado);
+
+// false se o arquivo não existir, for de outra versão ou estiver truncado
+bool ler_estado(const std::string& caminho, EstadoIncremental& estado);
+
+// Resultado de rodar_analise_incremental
+struct ExecucaoIncremental {
+    std::vector<viab::ResultadoData> resultados;   // como rodar_analise
+    bool completa = true;            // sem estado compatível: tudo recalculado
+    size_t fases_alteradas = 0;      // posições cuja fase mudou de conteúdo
+    size_t tabelas_reaproveitadas = 0; // fases com a tabela lida do estado, em qualquer posição
+    size_t dias_recalculados = 0;
+    size_t dias_reaproveitados = 0;
+};
+
+/**
+ * @brief Análise pelo motor de tabelas reaproveitando o estado anterior
+ *
+ * As tabelas guardadas são indexadas por viab::hash_fase: com a mesma série,
+ * uma fase cujo conteúdo já está no estado reaproveita a tabela mesmo que
+ * tenha mudado de posição, e só as demais são reconstruídas. Se a quantidade
+ * ou as durações das fases por posição mudaram, o espaço de caminhos é outro
+ * e todos os dias iniciais são reavaliados. Caso contrário, em cada posição
+ * cujo hash mudou, os dias em que a nova tabela difere da que ocupava a
+ * posição definem, por viab::inicios_afetados, os dias iniciais reavaliados.
+ * Os demais reaproveitam as contagens guardadas. Como
+ * cada dia usa semente_dia(semente, dia), o resultado é idêntico ao de uma
+ * execução completa. Ao final, o estado é regravado.
+ *
+ * @throws std::invalid_argument se alguma fase tiver durMin > durMax
+ * @throws std::runtime_error em falha ao gravar o estado
+ */
+ExecucaoIncremental rodar_analise_incremental(const std::vector<viab::Dia>& dias,
+                                              const std::vector<viab::Fase>& fases,
+                                              const std::string& caminho_estado,
+                                              std::uint64_t semente = 0);
+
+} // namespace model::io
@@ -0,0 +1,88 @@
+#include "estatisticas_io.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace model::io {
+
+namespace {
+
+constexpr char ASSINATURA[8] = {'R', 'G', 'E', 'S', 'T', 'P', '\0', '\0'};
+constexpr std::uint32_t VERSAO = 1;
+
+} // namespace
+
+void gravar_estatisticas(const std::string& caminho, const viab::EstatisticasPenalidade& e) {
+    std::ofstream out(caminho, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) throw std::runtime_error("Não foi possível criar o arquivo: " + caminho);
+    auto escrever = [&](const auto& valor) { out.write(reinterpret_cast<const char*>(&valor), sizeof(valor)); };
+    out.write(ASSINATURA, sizeof(ASSINATURA));
+    escrever(VERSAO);
+    escrever(static_cast<std::uint32_t>(e.bins));
+    escrever(e.max_excesso_dia);
+    escrever(e.max_excesso_noite);
+    escrever(static_cast<std::uint64_t>(e.dias.size()));
+    for (const auto& dia : e.dias) {
+        escrever(static_cast<std::int64_t>(dia.amostras));
+        escrever(static_cast<std::int64_t>(dia.viaveis));
+        escrever(static_cast<std::uint32_t>(dia.celulas.size()));
+        for (const auto& c : dia.celulas) {
+            escrever(c.indice);
+            escrever(static_cast<std::int64_t>(c.caminhos));
+            escrever(c.soma_dia);
+            escrever(c.soma_noite);
+        }
+    }
+    if (!out) throw std::runtime_error("Erro ao gravar o arquivo: " + caminho);
+}
+
+viab::EstatisticasPenalidade ler_estatisticas(const std::string& caminho) {
+    std::ifstream in(caminho, std::ios::binary);
+    if (!in.is_open()) throw std::runtime_error("Não foi possível abrir o arquivo: " + caminho);
+    auto ler = [&](auto& destino) {
+        if (!in.read(reinterpret_cast<char*>(&destino), sizeof(destino)))
+            throw std::runtime_error("Arquivo de estatísticas truncado: " + caminho);
+    };
+    char assinatura[sizeof(ASSINATURA)];
+    ler(assinatura);
+    if (std::memcmp(assinatura, ASSINATURA, sizeof(ASSINATURA)) != 0)
+        throw std::runtime_error("Arquivo não contém estatísticas de calibração: " + caminho);
+    std::uint32_t versao = 0, bins = 0;
+    ler(versao);
+    if (versao != VERSAO) throw std::runtime_error("Versão de estatísticas desconhecida: " + caminho);
+    ler(bins);
+    if (bins == 0) throw std::runtime_error("Estatísticas sem bins: " + caminho);
+
+    viab::EstatisticasPenalidade e;
+    e.bins = static_cast<int>(bins);
+    ler(e.max_excesso_dia);
+    ler(e.max_excesso_noite);
+    std::uint64_t dias = 0;
+    ler(dias);
+    for (std::uint64_t d = 0; d < dias; ++d) {
+        viab::EstatisticasDia dia;
+        std::int64_t amostras = 0, viaveis = 0;
+        std::uint32_t celulas = 0;
+        ler(amostras);
+        ler(viaveis);
+        ler(celulas);
+        dia.amostras = amostras;
+        dia.viaveis = viaveis;
+        for (std::uint32_t k = 0; k < celulas; ++k) {
+            viab::CelulaExcesso c;
+            std::int64_t caminhos = 0;
+            ler(c.indice);
+            ler(caminhos);
+            ler(c.soma_dia);
+            ler(c.soma_noite);
+            c.caminhos = caminhos;
+            if (c.indice >= bins * bins) throw std::runtime_error("Célula fora do histograma: " + caminho);
+            dia.celulas.push_back(c);
+        }
+        e.dias.push_back(std::move(dia));
+    }
+    return e;
+}
+
+} // namespace model::io
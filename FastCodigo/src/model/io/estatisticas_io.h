@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include "../viab/calibracao.h"
+
+namespace model::io {
+
+/**
+ * @brief Grava/lê as estatísticas suficientes de calibração (--estatisticas)
+ *
+ * Formato (ordem de bytes do host): assinatura "RGESTP", versão, bins,
+ * excessos máximos de Tmax e Tmin, número de dias e, por dia, amostras,
+ * viáveis, número de células não vazias e as células (índice u32, caminhos
+ * i64, somas dos excessos médios em double).
+ *
+ * @throws std::runtime_error em falha de E/S, assinatura/versão desconhecida
+ *         ou arquivo truncado
+ */
+void gravar_estatisticas(const std::string& caminho, const viab::EstatisticasPenalidade& estatisticas);
+viab::EstatisticasPenalidade ler_estatisticas(const std::string& caminho);
+
+} // namespace model::io
@@ -0,0 +1,332 @@
+#include "grade_io.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include "../viab/motor_tabelas.h"
+#include "../viab/pool_trabalho.h"
+#include "../viab/tabela_fases.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace model::io {
+
+const char* const NOMES_CAMPOS_GRADE[NUM_CAMPOS_GRADE] = {
+    "probabilidade_viabilidade", "rendimento_medio", "prob_esbranquiamento",
+    "prob_reducao_moagem", "prob_optimo"};
+
+namespace {
+
+constexpr char ASSINATURA_GRADE[8] = {'R', 'G', 'G', 'R', 'A', 'D', 'E', '\0'};
+constexpr char ASSINATURA_RESULTADO[8] = {'R', 'G', 'R', 'E', 'S', 'G', '\0', '\0'};
+constexpr std::uint32_t VERSAO = 1;
+// assinatura, versão, layout, células, dias, data do dia 0
+constexpr std::size_t TAMANHO_CABECALHO = 8 + 4 + 4 + 8 + 8 + 3 * 4;
+
+template <typename T>
+void escrever(std::ofstream& out, const T& v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+
+template <typename T>
+T ler(const unsigned char*& p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return v;
+}
+
+// Hash de uma série (Tmax e Tmin) por palavras de 32 bits
+struct HashSerie {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    void valor(float x) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        h = (h ^ bits) * 0x100000001b3ULL;
+    }
+};
+
+// Compara os bits, como HashSerie: NaN (dado ausente) é igual a si mesmo, o que
+// `==` não garante, e menos ainda sob -ffast-math
+bool mesmos_bits(float x, float y) {
+    return std::memcmp(&x, &y, sizeof(float)) == 0;
+}
+
+bool series_iguais(const GradeMapeada& g, std::size_t a, std::size_t b) {
+    const std::size_t n = g.cabecalho().num_dias;
+    for (std::size_t d = 0; d < n; ++d)
+        if (!mesmos_bits(g.tmax(a, d), g.tmax(b, d)) || !mesmos_bits(g.tmin(a, d), g.tmin(b, d)))
+            return false;
+    return true;
+}
+
+} // namespace
+
+GradeMapeada::GradeMapeada(const std::string& caminho) {
+#ifdef _WIN32
+    arquivo_ = CreateFileA(caminho.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (arquivo_ == INVALID_HANDLE_VALUE) {
+        arquivo_ = nullptr;
+        throw std::runtime_error("Não foi possível abrir a grade: " + caminho);
+    }
+    LARGE_INTEGER tamanho;
+    GetFileSizeEx(arquivo_, &tamanho);
+    tamanho_ = static_cast<std::size_t>(tamanho.QuadPart);
+    if (tamanho_ > 0) {
+        mapeamento_ = CreateFileMappingA(arquivo_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        mapa_ = mapeamento_ ? MapViewOfFile(mapeamento_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    }
+    if (tamanho_ > 0 && !mapa_) {
+        if (mapeamento_) CloseHandle(mapeamento_);
+        CloseHandle(arquivo_);
+        throw std::runtime_error("Não foi possível mapear a grade: " + caminho);
+    }
+#else
+    const int fd = ::open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Não foi possível abrir a grade: " + caminho);
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Não foi possível ler o tamanho da grade: " + caminho);
+    }
+    tamanho_ = static_cast<std::size_t>(info.st_size);
+    if (tamanho_ > 0) {
+        mapa_ = ::mmap(nullptr, tamanho_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa_ == MAP_FAILED) mapa_ = nullptr;
+    }
+    ::close(fd);   // o mapeamento continua válido
+    if (tamanho_ > 0 && !mapa_) throw std::runtime_error("Não foi possível mapear a grade: " + caminho);
+#endif
+
+    auto falhar = [&](const std::string& motivo) {
+        liberar();
+        throw std::runtime_error(motivo + ": " + caminho);
+    };
+    if (tamanho_ < TAMANHO_CABECALHO ||
+        std::memcmp(mapa_, ASSINATURA_GRADE, sizeof(ASSINATURA_GRADE)) != 0)
+        falhar("Não é uma grade do RiceGuard");
+    const auto* p = static_cast<const unsigned char*>(mapa_) + sizeof(ASSINATURA_GRADE);
+    if (ler<std::uint32_t>(p) != VERSAO) falhar("Versão de grade não suportada");
+    const auto layout = ler<std::uint32_t>(p);
+    if (layout > static_cast<std::uint32_t>(LayoutGrade::DiaCelula)) falhar("Layout de grade desconhecido");
+    cabecalho_.layout = static_cast<LayoutGrade>(layout);
+    cabecalho_.num_celulas = ler<std::uint64_t>(p);
+    cabecalho_.num_dias = ler<std::uint64_t>(p);
+    cabecalho_.ano = ler<std::int32_t>(p);
+    cabecalho_.mes = ler<std::int32_t>(p);
+    cabecalho_.dia = ler<std::int32_t>(p);
+
+    const std::uint64_t valores = cabecalho_.num_celulas * cabecalho_.num_dias;
+    if (cabecalho_.num_dias != 0 && valores / cabecalho_.num_dias != cabecalho_.num_celulas)
+        falhar("Dimensões de grade inválidas");
+    if (tamanho_ != TAMANHO_CABECALHO + 2 * valores * sizeof(float))
+        falhar("Tamanho da grade diferente do cabeçalho");
+    // O cabeçalho tem 44 bytes; os floats são lidos alinhados a 4
+    tmax_ = reinterpret_cast<const float*>(static_cast<const char*>(mapa_) + TAMANHO_CABECALHO);
+    tmin_ = tmax_ + valores;
+}
+
+GradeMapeada::~GradeMapeada() {
+    liberar();
+}
+
+void GradeMapeada::liberar() {
+#ifdef _WIN32
+    if (mapa_) UnmapViewOfFile(mapa_);
+    if (mapeamento_) CloseHandle(mapeamento_);
+    if (arquivo_) CloseHandle(arquivo_);
+    mapeamento_ = arquivo_ = nullptr;
+#else
+    if (mapa_) ::munmap(mapa_, tamanho_);
+#endif
+    mapa_ = nullptr;
+}
+
+void gravar_grade(const std::string& caminho, const CabecalhoGrade& c,
+                  const std::vector<float>& tmax, const std::vector<float>& tmin) {
+    const std::uint64_t valores = c.num_celulas * c.num_dias;
+    if (tmax.size() != valores || tmin.size() != valores)
+        throw std::invalid_argument("Arranjos com tamanho diferente de células × dias");
+    std::ofstream out(caminho, std::ios::binary);
+    if (!out.is_open()) throw std::runtime_error("Não foi possível criar o arquivo: " + caminho);
+    out.write(ASSINATURA_GRADE, sizeof(ASSINATURA_GRADE));
+    escrever(out, VERSAO);
+    escrever(out, static_cast<std::uint32_t>(c.layout));
+    escrever(out, c.num_celulas);
+    escrever(out, c.num_dias);
+    escrever(out, c.ano);
+    escrever(out, c.mes);
+    escrever(out, c.dia);
+    out.write(reinterpret_cast<const char*>(tmax.data()), static_cast<std::streamsize>(valores * sizeof(float)));
+    out.write(reinterpret_cast<const char*>(tmin.data()), static_cast<std::streamsize>(valores * sizeof(float)));
+    if (!out) throw std::runtime_error("Erro ao gravar o arquivo: " + caminho);
+}
+
+ExecucaoGrade rodar_analise_grade(const GradeMapeada& grade, const std::vector<viab::Fase>& fases,
+                                  const std::string& caminho_saida,
+                                  const std::vector<std::size_t>& selecionadas) {
+    const CabecalhoGrade& cab = grade.cabecalho();
+    const std::size_t num_celulas = cab.num_celulas;
+    const std::size_t n = cab.num_dias;
+    for (auto c : selecionadas)
+        if (c >= num_celulas)
+            throw std::invalid_argument("Célula fora da grade: " + std::to_string(c));
+    for (auto& f : fases)
+        if (f.durMin > f.durMax)
+            throw std::invalid_argument("DurMin > DurMax em fase: " + f.nome);
+
+    ExecucaoGrade out;
+    out.celulas = num_celulas;
+
+    // 1) Hash de cada série numa passada no layout do arquivo
+    std::vector<HashSerie> hashes(num_celulas);
+    if (cab.layout == LayoutGrade::CelulaDia) {
+        viab::paralelo_para(num_celulas, [&](std::size_t c) {
+            for (std::size_t d = 0; d < n; ++d) {
+                hashes[c].valor(grade.tmax(c, d));
+                hashes[c].valor(grade.tmin(c, d));
+            }
+        });
+    } else {
+        // Ladrilhos de células contíguas: cada dia é lido como TAMANHO_BLOCO_GRADE floats adjacentes
+        const std::size_t ladrilhos = (num_celulas + TAMANHO_BLOCO_GRADE - 1) / TAMANHO_BLOCO_GRADE;
+        viab::paralelo_para(ladrilhos, [&](std::size_t l) {
+            const std::size_t c0 = l * TAMANHO_BLOCO_GRADE;
+            const std::size_t c1 = std::min(num_celulas, c0 + TAMANHO_BLOCO_GRADE);
+            for (std::size_t d = 0; d < n; ++d)
+                for (std::size_t c = c0; c < c1; ++c) {
+                    hashes[c].valor(grade.tmax(c, d));
+                    hashes[c].valor(grade.tmin(c, d));
+                }
+        });
+    }
+
+    // 2) Células únicas; colisões de hash são desfeitas pela comparação completa
+    std::vector<std::size_t> unicas;
+    std::vector<std::vector<std::size_t>> membros;   // células de cada única
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> por_hash;   // -> índice em `unicas`
+    for (std::size_t c = 0; c < num_celulas; ++c) {
+        auto& candidatas = por_hash[hashes[c].h];
+        auto igual = std::find_if(candidatas.begin(), candidatas.end(),
+                                  [&](std::size_t u) { return series_iguais(grade, unicas[u], c); });
+        if (igual != candidatas.end()) {
+            membros[*igual].push_back(c);
+        } else {
+            candidatas.push_back(unicas.size());
+            unicas.push_back(c);
+            membros.push_back({c});
+        }
+    }
+    out.celulas_unicas = unicas.size();
+    std::vector<char> selecionada(num_celulas, 0);
+    for (auto c : selecionadas) selecionada[c] = 1;
+
+    // 3) Arquivo de resultado pré-dimensionado; cada única é gravada em todas as suas células
+    const std::size_t valores_celula = n * NUM_CAMPOS_GRADE;
+    std::ofstream saida(caminho_saida, std::ios::binary | std::ios::trunc);
+    if (!saida.is_open()) throw std::runtime_error("Não foi possível criar o arquivo: " + caminho_saida);
+    saida.write(ASSINATURA_RESULTADO, sizeof(ASSINATURA_RESULTADO));
+    escrever(saida, VERSAO);
+    escrever(saida, static_cast<std::uint64_t>(num_celulas));
+    escrever(saida, static_cast<std::uint64_t>(n));
+    escrever(saida, static_cast<std::uint32_t>(NUM_CAMPOS_GRADE));
+    for (auto nome : NOMES_CAMPOS_GRADE) {
+        escrever(saida, static_cast<std::uint32_t>(std::strlen(nome)));
+        saida.write(nome, static_cast<std::streamsize>(std::strlen(nome)));
+    }
+    const std::streamoff inicio_dados = saida.tellp();
+
+    const viab::PlanoAnalise plano = viab::planejar_analise(fases);
+    std::vector<int> inicios;
+    for (int d = 0; d + plano.dias_min <= static_cast<int>(n); ++d) inicios.push_back(d);
+
+    // 4) Blocos de células únicas: cópia para colunas contíguas, análise e gravação. Em DiaCelula,
+    //    um bloco são as únicas de um ladrilho de células contíguas (`unicas` está em ordem crescente)
+    std::vector<std::size_t> limites_blocos = {0};
+    for (std::size_t u = 1; u <= unicas.size(); ++u) {
+        const bool fim = u == unicas.size() || (cab.layout == LayoutGrade::CelulaDia
+            ? u - limites_blocos.back() == TAMANHO_BLOCO_GRADE
+            : unicas[u] / TAMANHO_BLOCO_GRADE != unicas[u - 1] / TAMANHO_BLOCO_GRADE);
+        if (fim) limites_blocos.push_back(u);
+    }
+    std::vector<float> bloco;
+    std::vector<double> colunas;   // DiaCelula: Tmax e Tmin de cada única do bloco, transpostas
+    std::mutex mutex_selecionadas;
+    for (std::size_t b = 0; b + 1 < limites_blocos.size(); ++b) {
+        const std::size_t b0 = limites_blocos[b], b1 = limites_blocos[b + 1];
+        bloco.assign((b1 - b0) * valores_celula, 0.0f);
+        std::atomic<std::size_t> descartados{0};
+        if (cab.layout == LayoutGrade::DiaCelula) {
+            // Transposição por linhas: cada dia do ladrilho é um trecho contíguo do mapeamento
+            colunas.resize((b1 - b0) * 2 * n);
+            const std::size_t faixas = (n + TAMANHO_BLOCO_GRADE - 1) / TAMANHO_BLOCO_GRADE;
+            viab::paralelo_para(faixas, [&](std::size_t f) {
+                const std::size_t d1 = std::min(n, (f + 1) * TAMANHO_BLOCO_GRADE);
+                for (std::size_t d = f * TAMANHO_BLOCO_GRADE; d < d1; ++d)
+                    for (std::size_t j = 0; j < b1 - b0; ++j) {
+                        colunas[j * 2 * n + d] = grade.tmax(unicas[b0 + j], d);
+                        colunas[j * 2 * n + n + d] = grade.tmin(unicas[b0 + j], d);
+                    }
+            });
+        }
+        // Em CelulaDia, série e tabelas de cada célula nascem no trabalhador que a analisa (primeiro toque local)
+        viab::paralelo_para(b1 - b0, [&](std::size_t j) {
+            const std::size_t u = b0 + j;
+            const std::size_t c = unicas[u];
+            std::vector<double> serie;
+            const double* tmax = nullptr;
+            if (cab.layout == LayoutGrade::DiaCelula) {
+                tmax = colunas.data() + j * 2 * n;
+            } else {
+                serie.resize(2 * n);
+                for (std::size_t d = 0; d < n; ++d) {
+                    serie[d] = grade.tmax(c, d);
+                    serie[n + d] = grade.tmin(c, d);
+                }
+                tmax = serie.data();
+            }
+            const double* tmin = tmax + n;
+            const auto tabelas = viab::construir_tabelas(tmax, tmin, n, fases);
+            std::vector<viab::ResultadoData> resultados(n);
+            descartados += viab::avaliar_dias(tabelas, fases, static_cast<int>(n), inicios, 0,
+                                              [&](std::size_t j, const viab::ContagemDia& cont) {
+                resultados[inicios[j]] = viab::finalizar_contagem(cont, plano);
+            });
+            float* destino = bloco.data() + (u - b0) * valores_celula;
+            for (std::size_t d = 0; d < n; ++d) {
+                const auto& r = resultados[d];
+                const double campos[NUM_CAMPOS_GRADE] = {r.prob_viabilidade, r.rendimento_medio,
+                    r.prob_esbranquiamento, r.prob_reducao_moagem, r.prob_optimo};
+                for (int k = 0; k < NUM_CAMPOS_GRADE; ++k)
+                    destino[d * NUM_CAMPOS_GRADE + k] = static_cast<float>(campos[k]);
+            }
+            for (auto m : membros[u]) {
+                if (!selecionada[m]) continue;
+                std::lock_guard<std::mutex> l(mutex_selecionadas);
+                out.selecionadas[m] = resultados;
+            }
+        });
+        out.dias_descartados += descartados;
+
+        for (std::size_t u = b0; u < b1; ++u) {
+            const char* origem = reinterpret_cast<const char*>(bloco.data() + (u - b0) * valores_celula);
+            for (auto m : membros[u]) {
+                saida.seekp(inicio_dados + static_cast<std::streamoff>(m * valores_celula * sizeof(float)));
+                saida.write(origem, static_cast<std::streamsize>(valores_celula * sizeof(float)));
+            }
+        }
+        if (!saida) throw std::runtime_error("Erro ao gravar o arquivo: " + caminho_saida);
+    }
+    return out;
+}
+
+} // namespace model::io
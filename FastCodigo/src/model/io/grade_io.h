@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "../viab/analise_viabilidade.h"
+#include "../viab/fase.h"
+
+namespace model::io {
+
+// Ordem do arranjo float32 de uma grade
+enum class LayoutGrade : std::uint32_t {
+    CelulaDia = 0,   // [celula][dia]: série de cada célula contígua
+    DiaCelula = 1,   // [dia][celula]: um campo espacial por dia (comum em reanálises)
+};
+
+// Cabeçalho de uma grade climática diária
+struct CabecalhoGrade {
+    LayoutGrade layout = LayoutGrade::CelulaDia;
+    std::uint64_t num_celulas = 0;
+    std::uint64_t num_dias = 0;
+    std::int32_t ano = 0, mes = 0, dia = 0;   // data do dia 0 (dias consecutivos)
+};
+
+/**
+ * @brief Grade climática bruta mapeada em memória (--modo grade)
+ *
+ * Formato (ordem de bytes do host): assinatura "RGGRADE", versão, layout,
+ * número de células e de dias, data do dia 0 (ano, mês, dia em int32) e os
+ * arranjos float32 de Tmax e de Tmin, nessa ordem, cada um no layout
+ * indicado. O arquivo não é copiado: as páginas são lidas sob demanda.
+ *
+ * @throws std::runtime_error se o arquivo não abrir, não for uma grade ou
+ *         tiver tamanho diferente do declarado no cabeçalho
+ */
+class GradeMapeada {
+public:
+    explicit GradeMapeada(const std::string& caminho);
+    ~GradeMapeada();
+
+    GradeMapeada(const GradeMapeada&) = delete;
+    GradeMapeada& operator=(const GradeMapeada&) = delete;
+
+    const CabecalhoGrade& cabecalho() const { return cabecalho_; }
+    float tmax(std::size_t celula, std::size_t dia) const { return tmax_[indice(celula, dia)]; }
+    float tmin(std::size_t celula, std::size_t dia) const { return tmin_[indice(celula, dia)]; }
+
+private:
+    void liberar();
+    std::size_t indice(std::size_t celula, std::size_t dia) const {
+        return cabecalho_.layout == LayoutGrade::CelulaDia
+            ? celula * cabecalho_.num_dias + dia
+            : dia * cabecalho_.num_celulas + celula;
+    }
+
+    CabecalhoGrade cabecalho_;
+    const float* tmax_ = nullptr;
+    const float* tmin_ = nullptr;
+    void* mapa_ = nullptr;
+    std::size_t tamanho_ = 0;
+#ifdef _WIN32
+    void* arquivo_ = nullptr;
+    void* mapeamento_ = nullptr;
+#endif
+};
+
+// Grava uma grade no formato lido por GradeMapeada (tmax/tmin já no layout do cabeçalho)
+void gravar_grade(const std::string& caminho, const CabecalhoGrade& cabecalho,
+                  const std::vector<float>& tmax, const std::vector<float>& tmin);
+
+// Saídas gravadas por dia no resultado da grade, nesta ordem
+constexpr int NUM_CAMPOS_GRADE = 5;
+extern const char* const NOMES_CAMPOS_GRADE[NUM_CAMPOS_GRADE];
+
+// Métricas e células selecionadas de rodar_analise_grade
+struct ExecucaoGrade {
+    std::size_t celulas = 0;
+    std::size_t celulas_unicas = 0;      // séries distintas, calculadas uma vez cada
+    std::size_t dias_descartados = 0;    // dias iniciais zerados pelo pré-filtro (nas únicas)
+    std::map<std::size_t, std::vector<viab::ResultadoData>> selecionadas;  // sem data_str
+};
+
+/**
+ * @brief Roda a análise em todas as células de uma grade
+ *
+ * Células com séries idênticas (comuns após reamostragem) são detectadas por
+ * hash e comparação e calculadas uma vez. As células únicas são processadas
+ * em blocos de `TAMANHO_BLOCO_GRADE`, em paralelo dentro do bloco, com a série
+ * de cada uma copiada para colunas contíguas em double. No layout DiaCelula o
+ * bloco é um ladrilho de `TAMANHO_BLOCO_GRADE` células contíguas, transposto
+ * dia a dia (uma linha de floats adjacentes por dia), e o hash das séries
+ * percorre os mesmos ladrilhos.
+ *
+ * Grava em `caminho_saida` o resultado: assinatura "RGRESG", versão, número
+ * de células, de dias e de campos, os nomes dos campos e um arranjo float32
+ * [celula][dia][campo] (zeros nos dias sem ciclo completo).
+ *
+ * @param selecionadas Células cujos ResultadoData completos são devolvidos
+ * @throws std::invalid_argument se alguma célula selecionada não existir
+ * @throws std::runtime_error em falha de E/S
+ */
+ExecucaoGrade rodar_analise_grade(const GradeMapeada& grade, const std::vector<viab::Fase>& fases,
+                                  const std::string& caminho_saida,
+                                  const std::vector<std::size_t>& selecionadas = {});
+
+constexpr std::size_t TAMANHO_BLOCO_GRADE = 64;
+
+} // namespace model::io
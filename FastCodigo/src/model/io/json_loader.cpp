@@ -2,6 +2,7 @@
 #include <fstream>
 #include "include/external/nlohmann/json.hpp"
 #include <stdexcept>
+#include "../viab/duracao_ponderada.h"
 
 namespace model::io {
     std::vector<viab::Fase> carregar_fases(const std::string& caminho_arquivo) {
@@ -43,6 +44,35 @@ namespace model::io {
                     fase_json["durMin"].get<int>(),
                     fase_json["durMax"].get<int>()
                 );
+                // Campos opcionais
+                if (fase_json.contains("toleranciaGH")) {
+                    fases.back().toleranciaGH = fase_json["toleranciaGH"].get<double>();
+                }
+                if (fase_json.contains("gdd")) {
+                    fases.back().gddAlvo = fase_json["gdd"].get<double>();
+                }
+                if (fase_json.contains("gddTolerancia")) {
+                    fases.back().gddTolerancia = fase_json["gddTolerancia"].get<double>();
+                }
+                if (fase_json.contains("tBase")) {
+                    fases.back().tBase = fase_json["tBase"].get<double>();
+                }
+                // Distribuição das durações: pesos explícitos ou especificação paramétrica
+                if (fase_json.contains("pesos")) {
+                    fases.back().pesos = viab::normalizar_pesos(
+                        fases.back(), fase_json["pesos"].get<std::vector<double>>());
+                } else if (fase_json.contains("distribuicao")) {
+                    const auto& dist = fase_json["distribuicao"];
+                    const std::string tipo = dist.at("tipo").get<std::string>();
+                    if (tipo == "triangular") {
+                        fases.back().pesos = viab::pesos_triangulares(fases.back(), dist.at("moda").get<double>());
+                    } else if (tipo == "normal") {
+                        fases.back().pesos = viab::pesos_normais(
+                            fases.back(), dist.at("media").get<double>(), dist.at("desvio").get<double>());
+                    } else if (tipo != "uniforme") {
+                        throw std::runtime_error("Distribuição desconhecida: " + tipo);
+                    }
+                }
             }
 
             return fases;
@@ -0,0 +1,141 @@
+#include "parcial_io.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace model::io {
+
+namespace {
+
+constexpr char ASSINATURA[8] = {'R', 'G', 'P', 'A', 'R', 'C', '\0', '\0'};
+constexpr std::uint32_t VERSAO = 1;
+
+struct Escritor {
+    std::ofstream& out;
+    template <typename T>
+    void valor(const T& v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+    void texto(const std::string& s) {
+        valor(static_cast<std::uint32_t>(s.size()));
+        out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+};
+
+struct Leitor {
+    std::ifstream& in;
+    const std::string& caminho;
+    template <typename T>
+    T valor() {
+        T v{};
+        if (!in.read(reinterpret_cast<char*>(&v), sizeof(T)))
+            throw std::runtime_error("Arquivo parcial truncado: " + caminho);
+        return v;
+    }
+    std::string texto() {
+        const auto tamanho = valor<std::uint32_t>();
+        std::string s(tamanho, '\0');
+        if (tamanho > 0 && !in.read(&s[0], tamanho))
+            throw std::runtime_error("Arquivo parcial truncado: " + caminho);
+        return s;
+    }
+};
+
+} // namespace
+
+void gravar_parcial(const std::string& caminho, const viab::ResultadoParcial& p) {
+    std::ofstream out(caminho, std::ios::binary);
+    if (!out.is_open()) throw std::runtime_error("Não foi possível criar o arquivo: " + caminho);
+    Escritor e{out};
+    out.write(ASSINATURA, sizeof(ASSINATURA));
+    e.valor(VERSAO);
+    e.valor(static_cast<std::int32_t>(p.indice));
+    e.valor(static_cast<std::int32_t>(p.total));
+    e.valor(p.semente);
+    e.valor(p.impressao);
+
+    e.valor(static_cast<std::uint32_t>(p.fases.size()));
+    for (auto& f : p.fases) {
+        e.texto(f.nome);
+        e.valor(f.minT);
+        e.valor(f.maxT);
+        e.valor(f.optMinT);
+        e.valor(f.optMaxT);
+        e.valor(static_cast<std::int32_t>(f.durMin));
+        e.valor(static_cast<std::int32_t>(f.durMax));
+    }
+
+    e.valor(static_cast<std::uint64_t>(p.datas.size()));
+    for (size_t d = 0; d < p.datas.size(); ++d) {
+        e.texto(p.datas[d]);
+        e.valor(static_cast<std::int32_t>(p.meses[d]));
+    }
+
+    e.valor(static_cast<std::uint64_t>(p.dias_iniciais.size()));
+    for (size_t j = 0; j < p.dias_iniciais.size(); ++j) {
+        const auto& c = p.contagens[j];
+        e.valor(static_cast<std::int32_t>(p.dias_iniciais[j]));
+        e.valor(static_cast<std::int64_t>(c.amostras));
+        e.valor(static_cast<std::int64_t>(c.viaveis));
+        e.valor(static_cast<std::int64_t>(c.optimos));
+        e.valor(static_cast<std::int64_t>(c.esb));
+        e.valor(static_cast<std::int64_t>(c.red));
+        e.valor(c.soma_rend);
+    }
+    if (!out) throw std::runtime_error("Erro ao gravar o arquivo: " + caminho);
+}
+
+viab::ResultadoParcial ler_parcial(const std::string& caminho) {
+    std::ifstream in(caminho, std::ios::binary);
+    if (!in.is_open()) throw std::runtime_error("Não foi possível abrir o arquivo: " + caminho);
+    char assinatura[sizeof(ASSINATURA)];
+    if (!in.read(assinatura, sizeof(assinatura)) ||
+        std::memcmp(assinatura, ASSINATURA, sizeof(ASSINATURA)) != 0)
+        throw std::runtime_error("Não é um arquivo parcial do RiceGuard: " + caminho);
+    Leitor l{in, caminho};
+    if (l.valor<std::uint32_t>() != VERSAO)
+        throw std::runtime_error("Versão de arquivo parcial não suportada: " + caminho);
+
+    viab::ResultadoParcial p;
+    p.indice = l.valor<std::int32_t>();
+    p.total = l.valor<std::int32_t>();
+    p.semente = l.valor<std::uint64_t>();
+    p.impressao = l.valor<std::uint64_t>();
+
+    const auto num_fases = l.valor<std::uint32_t>();
+    for (std::uint32_t i = 0; i < num_fases; ++i) {
+        std::string nome = l.texto();
+        const double minT = l.valor<double>(), maxT = l.valor<double>();
+        const double optMinT = l.valor<double>(), optMaxT = l.valor<double>();
+        const int durMin = l.valor<std::int32_t>(), durMax = l.valor<std::int32_t>();
+        p.fases.emplace_back(nome, minT, maxT, optMinT, optMaxT, durMin, durMax);
+    }
+
+    const auto n = l.valor<std::uint64_t>();
+    for (std::uint64_t d = 0; d < n; ++d) {
+        p.datas.push_back(l.texto());
+        p.meses.push_back(l.valor<std::int32_t>());
+    }
+
+    const auto m = l.valor<std::uint64_t>();
+    for (std::uint64_t j = 0; j < m; ++j) {
+        const int dia = l.valor<std::int32_t>();
+        if (dia < 0 || static_cast<std::uint64_t>(dia) >= n)
+            throw std::runtime_error("Dia inicial fora da série em " + caminho);
+        viab::ContagemDia c;
+        c.amostras = l.valor<std::int64_t>();
+        c.viaveis = l.valor<std::int64_t>();
+        c.optimos = l.valor<std::int64_t>();
+        c.esb = l.valor<std::int64_t>();
+        c.red = l.valor<std::int64_t>();
+        c.soma_rend = l.valor<double>();
+        p.dias_iniciais.push_back(dia);
+        p.contagens.push_back(c);
+    }
+    return p;
+}
+
+std::string nome_parcial(int indice, int total) {
+    return "parcial_" + std::to_string(indice) + "_de_" + std::to_string(total) + ".bin";
+}
+
+} // namespace model::io
@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include "../viab/particao.h"
+
+namespace model::io {
+
+/**
+ * @brief Grava/lê o arquivo binário de uma fatia (--shard)
+ *
+ * Formato (ordem de bytes do host): assinatura "RGPARC", versão, fatia i/N,
+ * semente e impressão digital; fases; calendário da série; e, por dia
+ * inicial avaliado, as contagens brutas (ContagemDia).
+ *
+ * @throws std::runtime_error em falha de E/S, assinatura/versão desconhecida
+ *         ou arquivo truncado
+ */
+void gravar_parcial(const std::string& caminho, const viab::ResultadoParcial& parcial);
+viab::ResultadoParcial ler_parcial(const std::string& caminho);
+
+// Nome padrão do arquivo da fatia: parcial_<i>_de_<N>.bin
+std::string nome_parcial(int indice, int total);
+
+} // namespace model::io
@@ -0,0 +1,272 @@
+#include "agregacao.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "../viab/pool_trabalho.h"
+
+namespace model::summary {
+
+const std::array<const char*, NUM_METRICAS> NOMES_METRICAS = {
+    "probabilidade_viabilidade", "rendimento_medio", "prob_esbranquiamento",
+    "prob_reducao_moagem", "prob_optimo"};
+
+void Estatistica::adicionar(double x) {
+    if (n == 0) {
+        min = max = x;
+    } else {
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+    ++n;
+    double delta = x - media;
+    media += delta / n;
+    m2 += delta * (x - media);
+}
+
+void Estatistica::combinar(const Estatistica& outra) {
+    if (outra.n == 0) return;
+    if (n == 0) {
+        *this = outra;
+        return;
+    }
+    long long total = n + outra.n;
+    double delta = outra.media - media;
+    media += delta * outra.n / total;
+    m2 += outra.m2 + delta * delta * (static_cast<double>(n) * outra.n / total);
+    min = std::min(min, outra.min);
+    max = std::max(max, outra.max);
+    n = total;
+}
+
+double Estatistica::variancia() const {
+    return n > 1 ? m2 / (n - 1) : 0.0;
+}
+
+ColunasResultado extrair_colunas(const std::vector<viab::ResultadoData>& resultados) {
+    ColunasResultado c;
+    c.datas.reserve(resultados.size());
+    for (auto& m : c.metricas) m.reserve(resultados.size());
+    for (const auto& r : resultados) {
+        if (r.data_str.empty()) continue;
+        auto data = interpretar_data(r.data_str);
+        if (!data) throw std::runtime_error("Data ilegível no resultado: " + r.data_str);
+        c.datas.push_back(*data);
+        c.metricas[0].push_back(r.prob_viabilidade);
+        c.metricas[1].push_back(r.rendimento_medio);
+        c.metricas[2].push_back(r.prob_esbranquiamento);
+        c.metricas[3].push_back(r.prob_reducao_moagem);
+        c.metricas[4].push_back(r.prob_optimo);
+    }
+    return c;
+}
+
+namespace {
+
+// Períodos por ano de cada agrupamento (índice denso = (ano - ano_base) * periodos + período - 1)
+int periodos_por_ano(Agrupamento tipo, size_t num_janelas) {
+    switch (tipo) {
+        case Agrupamento::SemanaIso:       return 53;
+        case Agrupamento::Decendio:        return 36;
+        case Agrupamento::MesAno:          return 12;
+        case Agrupamento::JanelaSemeadura: return static_cast<int>(num_janelas);
+    }
+    return 0;
+}
+
+bool na_janela(const Data& d, const JanelaSemeadura& j, int& safra) {
+    const int md = d.mes * 100 + d.dia;
+    const int ini = j.mes_ini * 100 + j.dia_ini;
+    const int fim = j.mes_fim * 100 + j.dia_fim;
+    if (ini <= fim) {
+        safra = d.ano;
+        return md >= ini && md <= fim;
+    }
+    // Janela que atravessa o ano: a safra é o ano do início
+    if (md >= ini) { safra = d.ano;     return true; }
+    if (md <= fim) { safra = d.ano - 1; return true; }
+    return false;
+}
+
+} // namespace
+
+std::vector<ResultadoAgrupamento> agrupar(const ColunasResultado& colunas,
+                                          const std::vector<Agrupamento>& agrupamentos,
+                                          const std::vector<JanelaSemeadura>& janelas) {
+    const long n = static_cast<long>(colunas.datas.size());
+    const int G = static_cast<int>(agrupamentos.size());
+    std::vector<ResultadoAgrupamento> saida(G);
+    for (int g = 0; g < G; ++g) saida[g].tipo = agrupamentos[g];
+    if (n == 0 || G == 0) return saida;
+
+    // Anos cobertos, com folga de um ano para semana ISO e safras que atravessam o ano
+    int ano_min = colunas.datas[0].ano, ano_max = ano_min;
+    for (const auto& d : colunas.datas) {
+        ano_min = std::min(ano_min, d.ano);
+        ano_max = std::max(ano_max, d.ano);
+    }
+    const int ano_base = ano_min - 1;
+    const int num_anos = ano_max - ano_base + 2;
+
+    std::vector<int> periodos(G);
+    std::vector<size_t> deslocamento(G + 1, 0);
+    for (int g = 0; g < G; ++g) {
+        periodos[g] = periodos_por_ano(agrupamentos[g], janelas.size());
+        deslocamento[g + 1] = deslocamento[g] + static_cast<size_t>(num_anos) * periodos[g];
+    }
+    const size_t total_celulas = deslocamento[G];
+
+    // Um bloco contíguo de dias por trabalhador do pool, cada um com a sua tabela
+    const long blocos = std::min<long>(n, viab::pool_trabalho().threads());
+    std::vector<std::vector<Acumuladores>> locais(blocos);
+    viab::paralelo_para(static_cast<size_t>(blocos), [&](size_t b) {
+        auto& acc = locais[b];
+        acc.assign(total_celulas, Acumuladores{});
+        auto somar = [&](size_t celula, long i) {
+            for (int m = 0; m < NUM_METRICAS; ++m)
+                acc[celula][m].adicionar(colunas.metricas[m][i]);
+        };
+
+        const long ini = n * static_cast<long>(b) / blocos;
+        const long fim = n * static_cast<long>(b + 1) / blocos;
+        for (long i = ini; i < fim; ++i) {
+            const Data& d = colunas.datas[i];
+            for (int g = 0; g < G; ++g) {
+                const size_t base = deslocamento[g];
+                switch (agrupamentos[g]) {
+                    case Agrupamento::SemanaIso: {
+                        int ano_iso;
+                        int s = semana_iso(d, ano_iso);
+                        somar(base + static_cast<size_t>(ano_iso - ano_base) * periodos[g] + s - 1, i);
+                        break;
+                    }
+                    case Agrupamento::Decendio:
+                        somar(base + static_cast<size_t>(d.ano - ano_base) * periodos[g] + decendio(d) - 1, i);
+                        break;
+                    case Agrupamento::MesAno:
+                        somar(base + static_cast<size_t>(d.ano - ano_base) * periodos[g] + d.mes - 1, i);
+                        break;
+                    case Agrupamento::JanelaSemeadura:
+                        for (size_t j = 0; j < janelas.size(); ++j) {
+                            int safra;
+                            if (na_janela(d, janelas[j], safra))
+                                somar(base + static_cast<size_t>(safra - ano_base) * periodos[g] + j, i);
+                        }
+                        break;
+                }
+            }
+        }
+    });
+
+    // Combinação das tabelas dos blocos e compactação dos grupos não vazios
+    for (int g = 0; g < G; ++g) {
+        for (int a = 0; a < num_anos; ++a) {
+            for (int p = 0; p < periodos[g]; ++p) {
+                const size_t celula = deslocamento[g] + static_cast<size_t>(a) * periodos[g] + p;
+                Acumuladores total{};
+                for (const auto& acc : locais)
+                    if (!acc.empty())
+                        for (int m = 0; m < NUM_METRICAS; ++m) total[m].combinar(acc[celula][m]);
+                if (total[0].n == 0) continue;
+                if (agrupamentos[g] == Agrupamento::JanelaSemeadura)
+                    saida[g].chaves.push_back({p, ano_base + a});
+                else
+                    saida[g].chaves.push_back({ano_base + a, p + 1});
+                saida[g].acumuladores.push_back(total);
+            }
+        }
+        // Janelas listadas por janela e depois por safra
+        if (agrupamentos[g] == Agrupamento::JanelaSemeadura) {
+            std::vector<size_t> ordem(saida[g].chaves.size());
+            for (size_t k = 0; k < ordem.size(); ++k) ordem[k] = k;
+            std::stable_sort(ordem.begin(), ordem.end(), [&](size_t x, size_t y) {
+                return saida[g].chaves[x] < saida[g].chaves[y];
+            });
+            ResultadoAgrupamento ordenado{saida[g].tipo, {}, {}};
+            for (size_t k : ordem) {
+                ordenado.chaves.push_back(saida[g].chaves[k]);
+                ordenado.acumuladores.push_back(saida[g].acumuladores[k]);
+            }
+            saida[g] = std::move(ordenado);
+        }
+    }
+    return saida;
+}
+
+std::vector<Agrupamento> interpretar_agrupamentos(const std::string& lista) {
+    std::vector<Agrupamento> saida;
+    std::istringstream ss(lista);
+    std::string nome;
+    while (std::getline(ss, nome, ',')) {
+        if (nome == "semana")        saida.push_back(Agrupamento::SemanaIso);
+        else if (nome == "decendio") saida.push_back(Agrupamento::Decendio);
+        else if (nome == "mes_ano")  saida.push_back(Agrupamento::MesAno);
+        else if (nome == "janela")   saida.push_back(Agrupamento::JanelaSemeadura);
+        else throw std::invalid_argument("Agrupamento desconhecido: " + nome);
+    }
+    return saida;
+}
+
+std::vector<JanelaSemeadura> interpretar_janelas(const std::string& especificacao) {
+    std::vector<JanelaSemeadura> janelas;
+    std::istringstream ss(especificacao);
+    std::string item;
+    while (std::getline(ss, item, ';')) {
+        if (item.empty()) continue;
+        JanelaSemeadura j;
+        auto dois_pontos = item.find(':');
+        char barra1, traco, barra2;
+        std::istringstream datas(dois_pontos == std::string::npos ? "" : item.substr(dois_pontos + 1));
+        if (dois_pontos == 0 || dois_pontos == std::string::npos ||
+            !(datas >> j.dia_ini >> barra1 >> j.mes_ini >> traco >> j.dia_fim >> barra2 >> j.mes_fim) ||
+            barra1 != '/' || traco != '-' || barra2 != '/' ||
+            j.mes_ini < 1 || j.mes_ini > 12 || j.mes_fim < 1 || j.mes_fim > 12 ||
+            j.dia_ini < 1 || j.dia_ini > 31 || j.dia_fim < 1 || j.dia_fim > 31) {
+            throw std::invalid_argument("Janela de semeadura inválida: " + item +
+                                        " (use nome:DD/MM-DD/MM)");
+        }
+        j.nome = item.substr(0, dois_pontos);
+        janelas.push_back(j);
+    }
+    return janelas;
+}
+
+std::string nome_arquivo(Agrupamento tipo) {
+    switch (tipo) {
+        case Agrupamento::SemanaIso:       return "resumo_semana_iso.csv";
+        case Agrupamento::Decendio:        return "resumo_decendio.csv";
+        case Agrupamento::MesAno:          return "resumo_mes_ano.csv";
+        case Agrupamento::JanelaSemeadura: return "resumo_janelas.csv";
+    }
+    return "resumo.csv";
+}
+
+std::string gerar_csv_agrupamento(const ResultadoAgrupamento& resultado,
+                                  const std::vector<JanelaSemeadura>& janelas) {
+    std::ostringstream o;
+    switch (resultado.tipo) {
+        case Agrupamento::SemanaIso:       o << "ano_iso,semana"; break;
+        case Agrupamento::Decendio:        o << "ano,decendio"; break;
+        case Agrupamento::MesAno:          o << "ano,mes"; break;
+        case Agrupamento::JanelaSemeadura: o << "janela,safra"; break;
+    }
+    o << ",dias";
+    for (const char* m : NOMES_METRICAS)
+        o << "," << m << "_media," << m << "_min," << m << "_max," << m << "_variancia";
+    o << "\n";
+
+    for (size_t k = 0; k < resultado.chaves.size(); ++k) {
+        const auto& chave = resultado.chaves[k];
+        const auto& acc = resultado.acumuladores[k];
+        if (resultado.tipo == Agrupamento::JanelaSemeadura)
+            o << janelas[chave[0]].nome << "," << chave[1];
+        else
+            o << chave[0] << "," << chave[1];
+        o << "," << acc[0].n;
+        for (const auto& e : acc)
+            o << "," << e.media << "," << e.min << "," << e.max << "," << e.variancia();
+        o << "\n";
+    }
+    return o.str();
+}
+
+} // namespace model::summary
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include "../viab/analise_viabilidade.h"
+#include "calendario.h"
+
+namespace model::summary {
+
+/**
+ * @brief Acumulador de tamanho fixo (média/variância de Welford, mínimo, máximo)
+ *
+ * Dois acumuladores parciais são combinados sem perda (fórmula de Chan),
+ * o que permite agregar em paralelo e juntar no final.
+ */
+struct Estatistica {
+    long long n = 0;
+    double media = 0.0;
+    double m2 = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+
+    void adicionar(double x);
+    void combinar(const Estatistica& outra);
+    double variancia() const;   // amostral (0 com menos de 2 valores)
+};
+
+// Métricas agregadas, na ordem das colunas de ResultadoData
+inline constexpr int NUM_METRICAS = 5;
+extern const std::array<const char*, NUM_METRICAS> NOMES_METRICAS;
+using Acumuladores = std::array<Estatistica, NUM_METRICAS>;
+
+enum class Agrupamento { SemanaIso, Decendio, MesAno, JanelaSemeadura };
+
+// Janela de semeadura [ini, fim] por dia/mês; pode atravessar o ano (safra = ano do início)
+struct JanelaSemeadura {
+    std::string nome;
+    int mes_ini;
+    int dia_ini;
+    int mes_fim;
+    int dia_fim;
+};
+
+/**
+ * @brief Resultados em colunas compactas com a data já decomposta
+ *
+ * Dias sem data (não avaliados por falta de dias restantes) são omitidos,
+ * de modo que a agregação não depende do alinhamento com o vetor de Dia.
+ */
+struct ColunasResultado {
+    std::vector<Data> datas;
+    std::array<std::vector<double>, NUM_METRICAS> metricas;
+};
+
+// @throws std::runtime_error se algum resultado tiver data ilegível
+ColunasResultado extrair_colunas(const std::vector<viab::ResultadoData>& resultados);
+
+struct ResultadoAgrupamento {
+    Agrupamento tipo;
+    std::vector<std::array<int, 2>> chaves;   // (ano, período) ou (índice da janela, safra)
+    std::vector<Acumuladores> acumuladores;
+};
+
+/**
+ * @brief Calcula todos os agrupamentos pedidos numa única passada paralela
+ *
+ * Cada bloco de dias, um por trabalhador do pool compartilhado, acumula em
+ * tabelas densas próprias (ano × período), que são combinadas ao final na
+ * ordem dos blocos; grupos vazios não aparecem no resultado.
+ */
+std::vector<ResultadoAgrupamento> agrupar(const ColunasResultado& colunas,
+                                          const std::vector<Agrupamento>& agrupamentos,
+                                          const std::vector<JanelaSemeadura>& janelas);
+
+// Interpreta listas "semana,decendio,mes_ano,janela"
+// @throws std::invalid_argument em nome desconhecido
+std::vector<Agrupamento> interpretar_agrupamentos(const std::string& lista);
+
+// Interpreta "nome:DD/MM-DD/MM;nome2:DD/MM-DD/MM"
+// @throws std::invalid_argument em especificação malformada
+std::vector<JanelaSemeadura> interpretar_janelas(const std::string& especificacao);
+
+// Nome do arquivo CSV do agrupamento (ex.: "resumo_semana_iso.csv")
+std::string nome_arquivo(Agrupamento tipo);
+
+std::string gerar_csv_agrupamento(const ResultadoAgrupamento& resultado,
+                                  const std::vector<JanelaSemeadura>& janelas);
+
+} // namespace model::summary
@@ -0,0 +1,96 @@
+#include "calendario.h"
+#include <cstdio>
+
+namespace model::summary {
+
+std::optional<Data> interpretar_data(const std::string& texto) {
+    Data d{};
+    try {
+        if (texto.size() == 10 && texto[2] == '/' && texto[5] == '/') {
+            d.dia = std::stoi(texto.substr(0, 2));
+            d.mes = std::stoi(texto.substr(3, 2));
+            d.ano = std::stoi(texto.substr(6, 4));
+        } else if (texto.size() == 10 && texto[4] == '-' && texto[7] == '-') {
+            d.ano = std::stoi(texto.substr(0, 4));
+            d.mes = std::stoi(texto.substr(5, 2));
+            d.dia = std::stoi(texto.substr(8, 2));
+        } else {
+            return std::nullopt;
+        }
+    } catch (...) {
+        return std::nullopt;
+    }
+    if (d.mes < 1 || d.mes > 12 || d.dia < 1 || d.dia > dias_no_mes(d.ano, d.mes))
+        return std::nullopt;
+    return d;
+}
+
+bool bissexto(int ano) {
+    return (ano % 4 == 0 && ano % 100 != 0) || ano % 400 == 0;
+}
+
+int dias_no_mes(int ano, int mes) {
+    static constexpr int dias[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return mes == 2 && bissexto(ano) ? 29 : dias[mes - 1];
+}
+
+int dia_do_ano(const Data& d) {
+    int total = d.dia;
+    for (int m = 1; m < d.mes; ++m) total += dias_no_mes(d.ano, m);
+    return total;
+}
+
+Data dia_seguinte(const Data& d) {
+    Data s = d;
+    if (++s.dia > dias_no_mes(s.ano, s.mes)) {
+        s.dia = 1;
+        if (++s.mes > 12) { s.mes = 1; ++s.ano; }
+    }
+    return s;
+}
+
+std::string formatar_data(const Data& d) {
+    char texto[40];
+    std::snprintf(texto, sizeof(texto), "%02d/%02d/%04d", d.dia, d.mes, d.ano);
+    return texto;
+}
+
+int dia_da_semana_iso(const Data& d) {
+    // Dias desde 1970-01-01 (algoritmo days_from_civil), que foi uma quinta-feira
+    int y = d.ano - (d.mes <= 2);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (d.mes + (d.mes > 2 ? -3 : 9)) + 2) / 5 + d.dia - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    long dias = static_cast<long>(era) * 146097 + doe - 719468;
+    long w = (dias + 3) % 7;   // 0 = segunda
+    if (w < 0) w += 7;
+    return static_cast<int>(w) + 1;
+}
+
+// Anos ISO com 53 semanas: 1º de janeiro numa quinta, ou quarta em ano bissexto
+static int semanas_no_ano_iso(int ano) {
+    int jan1 = dia_da_semana_iso({ano, 1, 1});
+    return (jan1 == 4 || (jan1 == 3 && bissexto(ano))) ? 53 : 52;
+}
+
+int semana_iso(const Data& d, int& ano_iso) {
+    int semana = (dia_do_ano(d) - dia_da_semana_iso(d) + 10) / 7;
+    ano_iso = d.ano;
+    if (semana < 1) {
+        ano_iso = d.ano - 1;
+        return semanas_no_ano_iso(ano_iso);
+    }
+    if (semana > semanas_no_ano_iso(d.ano)) {
+        ano_iso = d.ano + 1;
+        return 1;
+    }
+    return semana;
+}
+
+int decendio(const Data& d) {
+    int parte = d.dia <= 10 ? 1 : (d.dia <= 20 ? 2 : 3);
+    return (d.mes - 1) * 3 + parte;
+}
+
+} // namespace model::summary
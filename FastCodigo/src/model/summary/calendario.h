@@ -0,0 +1,30 @@
+#pragma once
+#include <optional>
+#include <string>
+
+namespace model::summary {
+
+// Data civil (calendário gregoriano)
+struct Data {
+    int ano;
+    int mes;
+    int dia;
+};
+
+// Interpreta "DD/MM/AAAA" (formato dos CSVs) ou "AAAA-MM-DD"; nullopt se inválida
+std::optional<Data> interpretar_data(const std::string& texto);
+
+bool bissexto(int ano);
+int dias_no_mes(int ano, int mes);
+int dia_do_ano(const Data& d);              // 1..366
+Data dia_seguinte(const Data& d);
+std::string formatar_data(const Data& d);   // "DD/MM/AAAA", como nos CSVs
+int dia_da_semana_iso(const Data& d);       // 1 = segunda ... 7 = domingo
+
+// Semana ISO 8601 (1..53); `ano_iso` recebe o ano ao qual a semana pertence
+int semana_iso(const Data& d, int& ano_iso);
+
+// Decêndio do ano (1..36): dias 1-10, 11-20 e 21-fim de cada mês
+int decendio(const Data& d);
+
+} // namespace model::summary
@@ -0,0 +1,86 @@
+#include "climatologia.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace model::summary {
+
+int dia_calendario(const Data& d) {
+    return dia_do_ano({2000, d.mes, d.dia}) - 1;
+}
+
+std::map<int, AnoClimatologia> separar_anos(const ColunasResultado& colunas) {
+    std::map<int, AnoClimatologia> anos;
+    for (size_t i = 0; i < colunas.datas.size(); ++i) {
+        auto& ano = anos[colunas.datas[i].ano];
+        const int dia = dia_calendario(colunas.datas[i]);
+        ano.presente[dia] = 1;
+        for (int m = 0; m < NUM_METRICAS; ++m) ano.valores[dia][m] = colunas.metricas[m][i];
+    }
+    return anos;
+}
+
+double SomaJanela::variancia() const {
+    if (n < 2) return 0.0;
+    return std::max(0.0, (soma_quadrados - soma * soma / n) / (n - 1));
+}
+
+ClimatologiaMovel::ClimatologiaMovel(int anos_janela) : anos_janela_(anos_janela) {
+    if (anos_janela < 1)
+        throw std::invalid_argument("Janela da climatologia deve ter >= 1 ano: " + std::to_string(anos_janela));
+}
+
+void ClimatologiaMovel::somar(const AnoClimatologia& resultados, double sinal) {
+    const long long passo = sinal > 0 ? 1 : -1;
+    for (int dia = 0; dia < DIAS_CALENDARIO; ++dia) {
+        if (!resultados.presente[dia]) continue;
+        for (int m = 0; m < NUM_METRICAS; ++m) {
+            auto& s = somas_[dia][m];
+            const double x = resultados.valores[dia][m];
+            s.n += passo;
+            s.soma += sinal * x;
+            s.soma_quadrados += sinal * x * x;
+            if (s.n == 0) s.soma = s.soma_quadrados = 0.0;   // sem resíduo de arredondamento
+        }
+    }
+}
+
+void ClimatologiaMovel::incluir_ano(int ano, const AnoClimatologia& resultados) {
+    if (static_cast<int>(anos_.size()) >= anos_janela_ && ano < anos_.begin()->first) return;
+    auto existente = anos_.find(ano);
+    if (existente != anos_.end()) {
+        auto& guardado = existente->second;
+        somar(guardado, -1.0);
+        for (int dia = 0; dia < DIAS_CALENDARIO; ++dia) {
+            if (!resultados.presente[dia]) continue;
+            guardado.presente[dia] = 1;
+            guardado.valores[dia] = resultados.valores[dia];
+        }
+        somar(guardado, 1.0);
+    } else {
+        somar(anos_.emplace(ano, resultados).first->second, 1.0);
+    }
+    while (static_cast<int>(anos_.size()) > anos_janela_) {
+        somar(anos_.begin()->second, -1.0);
+        anos_.erase(anos_.begin());
+    }
+}
+
+std::string gerar_csv_climatologia(const ClimatologiaMovel& c) {
+    std::ostringstream o;
+    o << "dia,anos";
+    for (const char* m : NOMES_METRICAS) o << "," << m << "_media," << m << "_variancia";
+    o << "\n";
+    Data d{2000, 1, 1};
+    for (int dia = 0; dia < DIAS_CALENDARIO; ++dia, d = dia_seguinte(d)) {
+        const long long anos = c.soma(dia, 0).n;
+        if (anos == 0) continue;
+        o << (d.dia < 10 ? "0" : "") << d.dia << "/" << (d.mes < 10 ? "0" : "") << d.mes << "," << anos;
+        for (int m = 0; m < NUM_METRICAS; ++m)
+            o << "," << c.soma(dia, m).media() << "," << c.soma(dia, m).variancia();
+        o << "\n";
+    }
+    return o.str();
+}
+
+} // namespace model::summary
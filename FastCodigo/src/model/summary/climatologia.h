@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <map>
+#include <string>
+#include "agregacao.h"
+#include "calendario.h"
+
+namespace model::summary {
+
+// Dias do calendário de semeadura (29/02 tem posição própria em todos os anos)
+inline constexpr int DIAS_CALENDARIO = 366;
+inline constexpr int ANOS_JANELA_PADRAO = 30;   // janela sem --anos-janela nem histórico gravado
+
+// Posição 0..365 de dia/mês no calendário de um ano bissexto (01/03 é sempre 60)
+int dia_calendario(const Data& d);
+
+// Resultados de um ano de semeaduras por dia do calendário
+struct AnoClimatologia {
+    std::array<std::array<double, NUM_METRICAS>, DIAS_CALENDARIO> valores{};
+    std::array<char, DIAS_CALENDARIO> presente{};   // 0 = dia sem resultado no ano
+};
+
+// Separa os resultados por ano da data de semeadura
+std::map<int, AnoClimatologia> separar_anos(const ColunasResultado& colunas);
+
+// Somas de uma métrica num dia do calendário sobre os anos da janela
+struct SomaJanela {
+    long long n = 0;
+    double soma = 0.0;
+    double soma_quadrados = 0.0;
+
+    double media() const { return n > 0 ? soma / n : 0.0; }
+    double variancia() const;   // amostral (0 com menos de 2 anos)
+};
+
+/**
+ * @brief Climatologia por dia do calendário numa janela móvel de anos
+ *
+ * Guarda o resultado de cada ano e, por dia do calendário e métrica, somas
+ * e somas de quadrados dos anos da janela. Incluir um ano soma a sua tabela
+ * e descarta (subtrai) os mais antigos além de `anos_janela`, em
+ * O(DIAS_CALENDARIO · NUM_METRICAS) por ano, qualquer que seja o tamanho da
+ * janela; os valores por ano ficam guardados para a subtração ser exata.
+ *
+ * @throws std::invalid_argument se anos_janela < 1
+ */
+class ClimatologiaMovel {
+public:
+    explicit ClimatologiaMovel(int anos_janela);
+
+    // Ano já na janela: os dias presentes substituem os guardados (séries que cobrem só parte do
+    // ano completam o histórico). Anos anteriores ao mais antigo de uma janela cheia são ignorados
+    void incluir_ano(int ano, const AnoClimatologia& resultados);
+
+    int anos_janela() const { return anos_janela_; }
+    const std::map<int, AnoClimatologia>& anos() const { return anos_; }
+    const SomaJanela& soma(int dia, int metrica) const { return somas_[dia][metrica]; }
+
+private:
+    void somar(const AnoClimatologia& resultados, double sinal);
+
+    int anos_janela_;
+    std::map<int, AnoClimatologia> anos_;
+    std::array<std::array<SomaJanela, NUM_METRICAS>, DIAS_CALENDARIO> somas_{};
+};
+
+// Dia "DD/MM", anos na janela e <métrica>_media/<métrica>_variancia por dia do calendário
+std::string gerar_csv_climatologia(const ClimatologiaMovel& climatologia);
+
+} // namespace model::summary
@@ -0,0 +1,108 @@
+#include "graficos.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace model::summary {
+
+namespace {
+
+constexpr double Z_95 = 1.96;
+
+double limitar(double x) {
+    return std::clamp(x, 0.0, 1.0);
+}
+
+} // namespace
+
+SeriesGrafico gerar_series_grafico(const std::vector<viab::ResultadoData>& resultados,
+                                   const std::vector<viab::ResultadoEnsemble>& ensemble) {
+    if (!ensemble.empty() && ensemble.size() != resultados.size())
+        throw std::invalid_argument("Ensemble desalinhado dos resultados");
+
+    // Dias avaliados: somas prefixadas de x, x² e variância entre realizações (viabilidade, rendimento)
+    SeriesGrafico out;
+    std::vector<Data> datas;
+    std::array<std::vector<double>, 2> soma, soma_q, soma_var;
+    for (int k = 0; k < 2; ++k) soma[k] = soma_q[k] = soma_var[k] = {0.0};
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        const auto& r = resultados[i];
+        if (r.data_str.empty()) continue;
+        auto data = interpretar_data(r.data_str);
+        if (!data) throw std::runtime_error("Data ilegível no resultado: " + r.data_str);
+        datas.push_back(*data);
+        const double valores[NUM_METRICAS] = {r.prob_viabilidade, r.rendimento_medio, r.prob_esbranquiamento,
+                                              r.prob_reducao_moagem, r.prob_optimo};
+        for (int m = 0; m < NUM_METRICAS; ++m) out.mensal[data->mes - 1][m].adicionar(valores[m]);
+        for (int k = 0; k < 2; ++k) {
+            const double desvio = ensemble.empty() ? 0.0 : ensemble[i].desvio[k];
+            soma[k].push_back(soma[k].back() + valores[k]);
+            soma_q[k].push_back(soma_q[k].back() + valores[k] * valores[k]);
+            soma_var[k].push_back(soma_var[k].back() + desvio * desvio);
+        }
+    }
+
+    // Média móvel centrada (como rolling(center=True, min_periods=1)), desbastada
+    const int n = static_cast<int>(datas.size());
+    const int passo = std::max(1, (n + PONTOS_MAX_GRAFICO - 1) / PONTOS_MAX_GRAFICO);
+    for (int i = 0; i < n; i += passo) {
+        const int a = std::max(0, i - JANELA_MOVEL_GRAFICO / 2);
+        const int b = std::min(n, i - JANELA_MOVEL_GRAFICO / 2 + JANELA_MOVEL_GRAFICO);
+        const double w = b - a;
+        PontoEvolucao p;
+        p.data = datas[i];
+        for (int k = 0; k < 2; ++k) {
+            const double media = (soma[k][b] - soma[k][a]) / w;
+            const double var_dias = w > 1 ? std::max(0.0, (soma_q[k][b] - soma_q[k][a] - w * media * media) / (w - 1))
+                                          : 0.0;
+            const double var_real = (soma_var[k][b] - soma_var[k][a]) / w;
+            const double erro = std::sqrt((var_dias + var_real) / w);
+            p.media[k] = media;
+            p.inferior[k] = limitar(media - Z_95 * erro);
+            p.superior[k] = limitar(media + Z_95 * erro);
+        }
+        out.evolucao.push_back(p);
+    }
+    return out;
+}
+
+FaixaMensal faixa_mensal(const Estatistica& e) {
+    const double erro = e.n > 0 ? std::sqrt(e.variancia() / e.n) : 0.0;
+    return {e.media, limitar(e.media - Z_95 * erro), limitar(e.media + Z_95 * erro)};
+}
+
+std::string gerar_csv_grafico_evolucao(const SeriesGrafico& series) {
+    std::ostringstream o;
+    o << "Data";
+    for (int k = 0; k < 2; ++k)
+        o << "," << NOMES_METRICAS[k] << "_media_movel," << NOMES_METRICAS[k] << "_inferior,"
+          << NOMES_METRICAS[k] << "_superior";
+    o << "\n";
+    for (const auto& p : series.evolucao) {
+        o << formatar_data(p.data);
+        for (int k = 0; k < 2; ++k) o << "," << p.media[k] << "," << p.inferior[k] << "," << p.superior[k];
+        o << "\n";
+    }
+    return o.str();
+}
+
+std::string gerar_csv_grafico_mensal(const SeriesGrafico& series) {
+    std::ostringstream o;
+    o << "Mês,dias";
+    for (const char* m : NOMES_METRICAS) o << "," << m << "_media," << m << "_inferior," << m << "_superior";
+    o << "\n";
+    for (int mes = 0; mes < 12; ++mes) {
+        const auto& acc = series.mensal[mes];
+        if (acc[0].n == 0) continue;
+        o << mes + 1 << "," << acc[0].n;
+        for (const auto& e : acc) {
+            const auto f = faixa_mensal(e);
+            o << "," << f.media << "," << f.inferior << "," << f.superior;
+        }
+        o << "\n";
+    }
+    return o.str();
+}
+
+} // namespace model::summary
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include "agregacao.h"
+#include "calendario.h"
+#include "../viab/ensemble_imputacao.h"
+
+namespace model::summary {
+
+inline constexpr int JANELA_MOVEL_GRAFICO = 30;   // dias da média móvel centrada
+inline constexpr int PONTOS_MAX_GRAFICO = 730;    // pontos da evolução após o desbaste
+
+// Média móvel de viabilidade e rendimento num dia, com a faixa de 95%
+struct PontoEvolucao {
+    Data data;
+    std::array<double, 2> media{};       // probabilidade_viabilidade, rendimento_medio
+    std::array<double, 2> inferior{};
+    std::array<double, 2> superior{};
+};
+
+/**
+ * @brief Séries compactas para os gráficos do pós-processamento
+ *
+ * Calculadas numa passada pelos resultados, em somas prefixadas: a evolução
+ * diária é a média móvel centrada de JANELA_MOVEL_GRAFICO dias (a da
+ * janela parcial nas pontas), desbastada para no máximo PONTOS_MAX_GRAFICO
+ * pontos; as barras mensais agregam por mês do ano. As faixas são
+ * média ± 1,96 erros padrão da média; no ensemble a variância entre
+ * realizações de cada dia soma-se à variância entre os dias.
+ */
+struct SeriesGrafico {
+    std::vector<PontoEvolucao> evolucao;
+    std::array<Acumuladores, 12> mensal{};   // por mês do ano (0 = janeiro)
+};
+
+// `ensemble`, se não vazio, é alinhado com `resultados` (desvio entre realizações por dia)
+SeriesGrafico gerar_series_grafico(const std::vector<viab::ResultadoData>& resultados,
+                                   const std::vector<viab::ResultadoEnsemble>& ensemble = {});
+
+// Média e faixa de 95% de um mês do ano (média ± 1,96 erros padrão, em [0, 1])
+struct FaixaMensal {
+    double media = 0.0;
+    double inferior = 0.0;
+    double superior = 0.0;
+};
+FaixaMensal faixa_mensal(const Estatistica& e);
+
+// Data e <saída>_media_movel/_inferior/_superior de viabilidade e rendimento
+std::string gerar_csv_grafico_evolucao(const SeriesGrafico& series);
+// Mês, dias e <métrica>_media/_inferior/_superior por mês do ano (barras de risco)
+std::string gerar_csv_grafico_mensal(const SeriesGrafico& series);
+
+} // namespace model::summary
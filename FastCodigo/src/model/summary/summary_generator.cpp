@@ -1,17 +1,125 @@
 #include "summary_generator.h"
 #include <sstream>
 #include <map>
+#include <algorithm>
 
 namespace model::summary {
 std::string gerar_csv_detalhado(const std::vector<viab::ResultadoData>& R){
     std::ostringstream o; o<<"Data,probabilidade_viabilidade,rendimento_medio,prob_esbranquiamento,prob_reducao_moagem,prob_optimo,total_caminhos,caminhos_viaveis\n";
     for(auto& r:R) o<<r.data_str<<","<<r.prob_viabilidade<<","<<r.rendimento_medio
         <<","<<r.prob_esbranquiamento<<","<<r.prob_reducao_moagem
-        <<","<<r.prob_optimo<<","<<r.total_caminhos
+        <<","<<r.prob_optimo<<","<<r.total_caminhos.decimal()
         <<","<<r.caminhos_viaveis<<"\n";
     return o.str();
 }
 
+std::string gerar_csv_detalhado_horario(const std::vector<viab::ResultadoHorario>& R){
+    std::ostringstream o; o<<"Data,probabilidade_viabilidade,rendimento_medio,prob_esbranquiamento,prob_reducao_moagem,prob_optimo,total_caminhos,caminhos_viaveis";
+    size_t P = R.empty() ? 0 : R.front().gh_calor.size();
+    for(size_t k=1;k<=P;++k) o<<",gh_calor_"<<k<<",gh_frio_"<<k;
+    o<<"\n";
+    for(auto& h:R){ auto& r=h.base;
+        o<<r.data_str<<","<<r.prob_viabilidade<<","<<r.rendimento_medio
+        <<","<<r.prob_esbranquiamento<<","<<r.prob_reducao_moagem
+        <<","<<r.prob_optimo<<","<<r.total_caminhos.decimal()
+        <<","<<r.caminhos_viaveis;
+        for(size_t k=0;k<P;++k) o<<","<<h.gh_calor[k]<<","<<h.gh_frio[k];
+        o<<"\n";
+    }
+    return o.str();
+}
+
+std::string gerar_csv_melhores(const viab::ResultadoMelhores& M){
+    std::ostringstream o; o<<"ano,posicao,data_inicio,data_fim,rendimento_esperado,prob_viabilidade,limite_superior\n";
+    int posicao=0, grupo_atual=0;
+    for(size_t i=0;i<M.janelas.size();++i){ auto& j=M.janelas[i];
+        posicao = (i==0 || j.grupo!=grupo_atual) ? 1 : posicao+1;
+        grupo_atual=j.grupo;
+        o<<j.grupo<<","<<posicao<<","<<j.data_inicio<<","<<j.data_fim
+        <<","<<j.rendimento_esperado<<","<<j.prob_viabilidade<<","<<j.limite_superior<<"\n";
+    }
+    return o.str();
+}
+
+std::string gerar_csv_ensemble(const std::vector<viab::ResultadoEnsemble>& E){
+    std::ostringstream o; o<<"Data";
+    for(auto nome:viab::NOMES_SAIDAS_ENSEMBLE) o<<","<<nome<<"_media,"<<nome<<"_desvio";
+    o<<",afetado_por_lacunas\n";
+    for(auto& e:E){ auto& r=e.media;
+        const double medias[viab::NUM_SAIDAS_ENSEMBLE]={r.prob_viabilidade,r.rendimento_medio,
+            r.prob_esbranquiamento,r.prob_reducao_moagem,r.prob_optimo};
+        o<<r.data_str;
+        for(int k=0;k<viab::NUM_SAIDAS_ENSEMBLE;++k) o<<","<<medias[k]<<","<<e.desvio[k];
+        o<<","<<(e.afetado?1:0)<<"\n";
+    }
+    return o.str();
+}
+
+std::string gerar_csv_validacao_precisao(const viab::ValidacaoPrecisao& V,
+                                         const std::vector<viab::ResultadoData>& R){
+    std::ostringstream o; o<<"campo,desvio_maximo,data\n";
+    o.precision(3); o<<std::scientific;
+    for(auto& c:V.campos)
+        o<<c.campo<<","<<c.desvio_max<<","<<(c.dia>=0?R[c.dia].data_str:"")<<"\n";
+    return o.str();
+}
+
+std::string gerar_csv_condicional(const std::vector<viab::ResultadoCondicional>& C){
+    std::ostringstream o; o<<"Data,probabilidade_viabilidade,erro_padrao,erro_relativo,amostras_efetivas\n";
+    for(auto& c:C){ auto& r=c.base;
+        o<<r.data_str<<","<<r.prob_viabilidade<<","<<c.erro_padrao<<","
+         <<(r.prob_viabilidade>0?c.erro_padrao/r.prob_viabilidade:0.0)<<","<<c.amostras_efetivas<<"\n";
+    }
+    return o.str();
+}
+
+std::string gerar_csv_rotacao(const std::vector<viab::ResultadoRotacao>& R){
+    std::ostringstream o; o<<"Data,prob_viabilidade_primeira,prob_viabilidade_conjunta,rendimento_primeira,"
+                             "rendimento_segunda,rendimento_conjunto,dias_ate_segunda_semeadura\n";
+    for(auto& r:R) o<<r.data_str<<","<<r.prob_viabilidade_primeira<<","<<r.prob_viabilidade_conjunta
+        <<","<<r.rendimento_primeira<<","<<r.rendimento_segunda<<","<<r.rendimento_conjunto
+        <<","<<r.dias_ate_segunda<<"\n";
+    return o.str();
+}
+
+std::string gerar_csv_verificacao(const std::vector<viab::VerificacaoDia>& V){
+    std::ostringstream o; o<<"Data,dia_inicial,referencia,avaliados,campo,producao,valor_referencia,diferenca,erro_padrao,z,concorda\n";
+    o.precision(12);
+    for(auto& v:V) for(auto& c:v.campos){
+        const double dif=c.producao-c.referencia;
+        o<<v.data_str<<","<<v.dia<<","<<(v.exata?"exata":"amostrada")<<","<<v.avaliados<<","<<c.campo
+         <<","<<c.producao<<","<<c.referencia<<","<<dif<<","<<c.erro_padrao<<",";
+        if(c.erro_padrao>0) o<<dif/c.erro_padrao;
+        o<<","<<(c.concorda?1:0)<<"\n";
+    }
+    return o.str();
+}
+
+std::string gerar_csv_calibracao(const std::vector<viab::ResultadoCalibracao>& C){
+    std::ostringstream o; o<<"penal_diurna,penal_noturna,rendimento_medio,rendimento_esperado,celulas_aproximadas\n";
+    o.precision(12);
+    for(auto& c:C)
+        o<<c.penal_diurna<<","<<c.penal_noturna<<","<<c.rendimento_medio<<","<<c.rendimento_esperado
+         <<","<<c.celulas_aproximadas<<"\n";
+    return o.str();
+}
+
+std::string gerar_csv_falhas(const std::vector<viab::FalhasDia>& F,
+                             const std::vector<viab::ResultadoData>& R){
+    std::ostringstream o; o<<"Data";
+    size_t P=0;
+    for(auto& f:F) P=std::max(P,f.abaixo_min.size());
+    for(size_t k=1;k<=P;++k) o<<",abaixo_minT_"<<k<<",acima_maxT_"<<k;
+    o<<",fim_serie,deslocamento_moda,falhas_moda\n";
+    for(size_t i=0;i<F.size();++i){ auto& f=F[i];
+        o<<R[i].data_str;
+        for(size_t k=0;k<P;++k)
+            o<<","<<(k<f.abaixo_min.size()?f.abaixo_min[k]:0)<<","<<(k<f.acima_max.size()?f.acima_max[k]:0);
+        o<<","<<f.fim_serie<<","<<f.deslocamento_moda<<","<<f.falhas_moda<<"\n";
+    }
+    return o.str();
+}
+
 std::string gerar_csv_resumo_mensal(const std::vector<viab::ResultadoData>& R,const std::vector<viab::Dia>& D){
     std::ostringstream o; o<<"Mês,probabilidade_viabilidade_media,rendimento_medio,prob_esbranquiamento_media,prob_reducao_moagem_media,probabilidade_optimo_media\n";
     std::map<int,std::vector<const viab::ResultadoData*>> m;
@@ -3,7 +3,37 @@
 #include <string>
 #include "../viab/analise_viabilidade.h"
 #include "../viab/dia.h"
+#include "../viab/analise_horaria.h"
+#include "../viab/busca_melhores.h"
+#include "../viab/ensemble_imputacao.h"
+#include "../viab/precisao.h"
+#include "../viab/amostragem_condicional.h"
+#include "../viab/rotacao.h"
+#include "../viab/verificacao.h"
+#include "../viab/calibracao.h"
 namespace model::summary {
 std::string gerar_csv_detalhado(const std::vector<viab::ResultadoData>& resultados);
+// Colunas do detalhado seguidas de gh_calor_<k>/gh_frio_<k> por fase (k a partir de 1)
+std::string gerar_csv_detalhado_horario(const std::vector<viab::ResultadoHorario>& resultados);
+// Uma linha por janela: ano, posição no ano (1 = melhor), datas e métricas da consulta
+std::string gerar_csv_melhores(const viab::ResultadoMelhores& resultado);
+// Data, <saída>_media/<saída>_desvio entre realizações e afetado_por_lacunas (0/1)
+std::string gerar_csv_ensemble(const std::vector<viab::ResultadoEnsemble>& resultados);
+// Campo, desvio máximo float × double e a data em que ocorreu (vazia sem desvio)
+std::string gerar_csv_validacao_precisao(const viab::ValidacaoPrecisao& validacao,
+                                         const std::vector<viab::ResultadoData>& resultados);
+// Data, probabilidade de viabilidade condicional, erro padrão, erro relativo e amostras efetivas
+std::string gerar_csv_condicional(const std::vector<viab::ResultadoCondicional>& resultados);
+// Primeira semeadura, viabilidades (primeira safra e par), rendimentos nos pares viáveis e dias até a segunda
+std::string gerar_csv_rotacao(const std::vector<viab::ResultadoRotacao>& resultados);
+// Data, abaixo_minT_<k>/acima_maxT_<k> por fase (k a partir de 1), fim_serie e o
+// deslocamento mais frequente da primeira falha (-1 sem falhas) com sua contagem
+std::string gerar_csv_falhas(const std::vector<viab::FalhasDia>& falhas,
+                             const std::vector<viab::ResultadoData>& resultados);
+// Uma linha por dia verificado e campo: referência exata/amostrada, produção, referência,
+// diferença, erro padrão combinado, z (vazio sem erro amostral) e concorda (0/1)
+std::string gerar_csv_verificacao(const std::vector<viab::VerificacaoDia>& verificacao);
+// Um par de coeficientes por linha: rendimento médio, rendimento esperado e células aproximadas
+std::string gerar_csv_calibracao(const std::vector<viab::ResultadoCalibracao>& calibracao);
 std::string gerar_csv_resumo_mensal(const std::vector<viab::ResultadoData>& resultados,const std::vector<viab::Dia>& dias);
 }
\ No newline at end of file
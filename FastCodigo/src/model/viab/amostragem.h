@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "fase.h"
+
+namespace model::viab {
+
+__extension__ typedef unsigned __int128 Contagem128;
+
+/**
+ * @brief Número de caminhos (produto das faixas de duração) sem saturação
+ *
+ * O produto exato é mantido em 128 bits; acima disso (mais de ~3.4e38 caminhos)
+ * resta apenas o log10, que é sempre válido.
+ */
+struct TotalCaminhos {
+    Contagem128 exato = 1;    // válido se !excede_128
+    bool excede_128 = false;
+    double log10 = 0.0;
+
+    // Valor para campos long long (API C, amostras; satura em LLONG_MAX)
+    long long saturado() const;
+    // Valor em double, para desvios e comparações
+    double aproximado() const;
+    // Decimal exato, ou "~1e<log10>" acima de 128 bits
+    std::string texto() const;
+    // Decimal exato para o CSV; acima de 128 bits, notação científica a partir do log10
+    std::string decimal() const;
+};
+
+TotalCaminhos contar_caminhos(const std::vector<Fase>& fases);
+
+// Total de um espaço de caminhos já contado (ex.: bandas de GDD, catálogo fixo)
+TotalCaminhos caminhos_exatos(Contagem128 total);
+
+// proporcao · total, saturado em LLONG_MAX (estimativa de caminhos viáveis)
+long long escalar_caminhos(double proporcao, const TotalCaminhos& total);
+
+/**
+ * @brief Sorteio uniforme e independente da duração de cada fase
+ *
+ * Método de Lemire (multiplicação 32x32 -> 64 com rejeição): sem divisões por
+ * amostra, pois o limiar de rejeição de cada faixa é pré-calculado. Custa
+ * O(fases) por caminho, qualquer que seja o tamanho do espaço de durações.
+ */
+class SorteadorDuracoes {
+public:
+    explicit SorteadorDuracoes(const std::vector<Fase>& fases);
+
+    // Duração da fase i a partir de um gerador de 64 bits (usa os 32 bits altos)
+    template <typename Gerador>
+    int sortear(size_t i, Gerador& gen) const {
+        const std::uint32_t faixa = faixa_[i];
+        std::uint64_t m = static_cast<std::uint64_t>(gen() >> 32) * faixa;
+        while (static_cast<std::uint32_t>(m) < limiar_[i])
+            m = static_cast<std::uint64_t>(gen() >> 32) * faixa;
+        return base_[i] + static_cast<int>(m >> 32);
+    }
+
+private:
+    std::vector<int> base_;               // durMin
+    std::vector<std::uint32_t> faixa_;    // durMax - durMin + 1
+    std::vector<std::uint32_t> limiar_;   // 2^32 mod faixa
+};
+
+} // namespace model::viab
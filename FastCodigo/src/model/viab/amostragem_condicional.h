@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+#include "tabela_fases.h"
+
+namespace model::viab {
+
+// Resultado do estimador condicional de um dia inicial
+struct ResultadoCondicional {
+    ResultadoData base;
+    double erro_padrao = 0.0;         // erro padrão de base.prob_viabilidade
+    double amostras_efetivas = 0.0;   // (Σw)² / Σw² (Kish); = amostras com pesos iguais
+};
+
+/**
+ * @brief Términos a partir dos quais as fases restantes ainda se completam
+ *
+ * completaveis[i] tem n+2 posições e é a soma prefixada do indicador "as fases
+ * i..P-1 podem ocupar [b, ...) sem dia inviável e sem passar de n", de modo
+ * que os b completáveis em [lo, hi] são completaveis[i][hi + 1] -
+ * completaveis[i][lo]. Como o indicador só depende do dia absoluto b, a
+ * recursão de trás para frente é feita uma vez por série em O(P · n).
+ * completaveis[P] vale 1 em todo b <= n.
+ */
+std::vector<std::vector<int>> dias_completaveis(const std::vector<TabelaFase>& tabelas,
+                                                const std::vector<Fase>& fases, int n);
+
+/**
+ * @brief Estimativa de eventos raros por amostragem sequencial condicional
+ *
+ * Em vez de sortear durações uniformes e descartar os caminhos inviáveis, cada
+ * fase sorteia a duração só entre as k que mantêm o caminho viável e ainda
+ * completável (dias_completaveis), e o caminho recebe o peso Π k_i / faixa_i
+ * (razão de verossimilhança contra o sorteio uniforme). Todo sorteio gera um
+ * caminho viável e a média dos pesos é um estimador não viesado da
+ * probabilidade de viabilidade, com erro padrão pela variância amostral dos
+ * pesos. Rendimento e riscos condicionais são médias ponderadas pelos pesos.
+ */
+ResultadoCondicional amostrar_dia_condicional(const std::vector<TabelaFase>& tabelas,
+                                              const std::vector<Fase>& fases,
+                                              const std::vector<std::vector<int>>& completaveis,
+                                              int n, int inicio, long long amostras,
+                                              std::uint64_t semente);
+
+/**
+ * @brief Análise completa com o estimador condicional (`amostras` por dia)
+ *
+ * Dias sem caminho completável recebem zeros exatos sem sortear nada. Cada
+ * dia usa semente_dia(semente, dia).
+ *
+ * @throws std::invalid_argument se amostras < 2 ou durMin > durMax em alguma fase
+ */
+std::vector<ResultadoCondicional> rodar_analise_condicional(const std::vector<Dia>& dias,
+                                                            const std::vector<Fase>& fases,
+                                                            long long amostras,
+                                                            std::uint64_t semente = 0);
+
+} // namespace model::viab
@@ -0,0 +1,38 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+// Graus-dia do dia: max(0, (tmax + tmin) / 2 - tBase)
+double graus_dia(const Dia& dia, double tBase);
+
+// Graus-dia acumulados (n+1 posições) para a temperatura base da fase
+std::vector<double> acumular_graus_dia(const std::vector<Dia>& dias, double tBase);
+
+/**
+ * @brief Faixa de durações da fase iniciada em `inicio` pelo tempo térmico
+ *
+ * A menor duração é a primeira que acumula gddAlvo - gddTolerancia e a maior
+ * a primeira que acumula gddAlvo + gddTolerancia (ou o fim da série). Com
+ * tolerância nula a faixa tem um único valor. Retorna {1, 0} (vazia) quando o
+ * alvo mínimo não é atingido antes do fim da série.
+ */
+std::pair<int, int> faixa_graus_dia(const std::vector<double>& acumulado, int inicio,
+                                    const Fase& fase);
+
+/**
+ * @brief Análise com progressão de fases por graus-dia
+ *
+ * Cada dia inicial gera um caminho determinístico (ou uma pequena banda de
+ * caminhos quando há tolerância). total_caminhos conta os caminhos da banda;
+ * caminhos cujo alvo não é atingido antes do fim da série, ou cuja duração de
+ * fase sem GDD passa do fim, contam como inviáveis (como no caminho genérico).
+ */
+std::vector<ResultadoData> rodar_analise_gdd(const std::vector<Dia>& dias,
+                                             const std::vector<Fase>& fases);
+
+} // namespace model::viab
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+// Um dia do arquivo bruto: leituras sub-diárias e extremos diários (se informados)
+struct RegistroHorario {
+    std::string data_str;
+    int mes = 0;
+    std::vector<std::pair<int, double>> leituras;   // (hora UTC, temperatura)
+    std::optional<double> tmax_diaria;
+    std::optional<double> tmin_diaria;
+    bool ausente = false;   // dia que falta no arquivo, inserido sem leituras
+};
+
+// Série horária reconstruída (24 valores por dia) e os extremos diários derivados dela
+struct SerieHoraria {
+    std::vector<Dia> dias;
+    std::vector<double> temperaturas;
+};
+
+/**
+ * @brief Reconstrói a série horária a partir dos registros brutos
+ *
+ * Interpola linearmente entre as leituras, ancorando a máxima diária em
+ * HORA_TMAX_UTC e a mínima em HORA_TMIN_UTC; as pontas são preenchidas com a
+ * âncora mais próxima. Tmax/Tmin de cada Dia são os extremos da série horária.
+ *
+ * @throws std::runtime_error se não houver nenhuma temperatura válida
+ */
+SerieHoraria montar_serie_horaria(const std::vector<RegistroHorario>& registros);
+
+/**
+ * @brief Graus-hora acumulados por fase, amostrados nas fronteiras de dia
+ *
+ * calor[d] = soma de max(0, T - maxT) nas horas anteriores ao dia d e
+ * frio[d] = soma de max(0, minT - T); a janela [a, b) custa O(1).
+ */
+struct TabelaGrausHora {
+    std::vector<double> calor;
+    std::vector<double> frio;
+};
+
+std::vector<TabelaGrausHora> construir_tabelas_graus_hora(const SerieHoraria& serie,
+                                                           const std::vector<Fase>& fases);
+
+struct ResultadoHorario {
+    ResultadoData base;
+    std::vector<double> gh_calor;   // graus-hora acima de maxT por fase (média nos caminhos viáveis)
+    std::vector<double> gh_frio;    // graus-hora abaixo de minT por fase
+};
+
+/**
+ * @brief Análise com viabilidade por graus-hora
+ *
+ * Uma fase é viável quando os graus-hora fora de [minT, maxT] na sua janela
+ * não excedem Fase::toleranciaGH. Ideal, penalidades e riscos seguem a
+ * avaliação diária sobre os extremos derivados da série horária. Na
+ * amostragem cada dia usa semente_dia(semente, dia), como o caminho genérico.
+ */
+std::vector<ResultadoHorario> rodar_analise_horaria(const SerieHoraria& serie,
+                                                    const std::vector<Fase>& fases,
+                                                    std::uint64_t semente = 0);
+
+} // namespace model::viab
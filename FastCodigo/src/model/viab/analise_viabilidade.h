@@ -4,8 +4,10 @@
 #include <tuple>
 #include <stdexcept>
 #include <algorithm>
+#include "amostragem.h"
 #include "dia.h"
 #include "fase.h"
+#include "analysis_config.h"
 
 namespace model::viab {
 bool dentro(double x, double min, double max);
@@ -22,6 +24,49 @@ void gerar_combinacao_por_indice(std::vector<int>& combinacao,
                                 const std::vector<Fase>& fases,
                                 long long indice);
 
+// Estrutura para resultado diário detalhado
+struct ResultadoDia {
+    bool viavel           = false;
+    bool ideal            = false;
+    double rendimento     = 0.0;
+    bool risco_esbranq    = false;
+    bool risco_reducao    = false;
+    double penalidade_dia = 0.0;
+    double penalidade_noite = 0.0;
+};
+
+/**
+ * @brief Avalia um único dia para uma fase específica
+ *
+ * Dias ideais têm rendimento 1.0 e penalidades nulas; os riscos de
+ * esbranquiamento e redução de moagem só se aplicam à fase "Maturação".
+ */
+ResultadoDia avaliar_dia(const Dia& dia, const Fase& fase, const AnalysisConfig& cfg);
+
+// Primeira falha de um caminho inviável (ver FalhasDia)
+struct FalhaCaminho {
+    enum Limite { Minimo, Maximo, FimSerie };
+    size_t fase = 0;
+    Limite limite = FimSerie;
+    int deslocamento = 0;
+};
+
+/**
+ * @brief Avalia um caminho (uma duração por fase) a partir do dia `inicio`
+ *
+ * Semântica de referência de todos os motores: cada dia passa por
+ * avaliar_dia; o caminho é inviável no primeiro dia inviável ou se passar do
+ * fim da série. penal_dia/penal_noite são as médias por dia do caminho e o
+ * rendimento é max(0, 1 - (penal_dia + penal_noite)).
+ *
+ * @param falha Se não nulo, recebe onde um caminho inviável falhou primeiro
+ * @return true se o caminho é viável
+ */
+bool avaliar_sequencia(const std::vector<Dia>& dias, size_t inicio, const std::vector<Fase>& fases,
+                       const std::vector<int>& duracoes, const AnalysisConfig& cfg,
+                       double& penal_dia, double& penal_noite, bool& risco_esb, bool& risco_red,
+                       bool& seq_ideal, FalhaCaminho* falha = nullptr);
+
 struct ResultadoData {
     std::string data_str;
     double prob_viabilidade=0.0;
@@ -29,9 +74,35 @@ struct ResultadoData {
     double prob_esbranquiamento=0.0;
     double prob_reducao_moagem=0.0;
     double prob_optimo=0.0;
-    long long total_caminhos=0;
+    TotalCaminhos total_caminhos=caminhos_exatos(0);   // sem saturação (ver TotalCaminhos)
     long long caminhos_viaveis=0;
 };
 
-std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias, const std::vector<Fase>& fases);
+/**
+ * @brief Onde os caminhos inviáveis de um dia inicial falharam primeiro
+ *
+ * Cada caminho avaliado (ou amostra) inviável conta uma vez, na primeira fase
+ * e no primeiro dia em que sai de [minT, maxT]. Um dia com Tmax acima de maxT
+ * conta como acima mesmo que Tmin também esteja abaixo de minT.
+ */
+struct FalhasDia {
+    std::vector<long long> abaixo_min;   // por fase: Tmax ou Tmin < minT
+    std::vector<long long> acima_max;    // por fase: Tmax ou Tmin > maxT
+    long long fim_serie = 0;             // caminhos que passam do último dia da série
+    int deslocamento_moda = -1;          // dias após o início da falha mais frequente (-1 = nenhuma)
+    long long falhas_moda = 0;           // caminhos que falharam nesse deslocamento
+};
+
+/**
+ * @brief Análise completa da série
+ *
+ * @param falhas Se não nulo, recebe a atribuição de falhas de cada dia
+ *        inicial, acumulada na mesma passada da avaliação. Nesse modo o
+ *        pré-filtro é desligado (os dias que ele descartaria são justamente
+ *        os que se quer diagnosticar).
+ * @throws std::invalid_argument se durMin > durMax em alguma fase ou se
+ *         `falhas` for pedido com fases de durações ponderadas
+ */
+std::vector<ResultadoData> rodar_analise(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                                         std::vector<FalhasDia>* falhas = nullptr);
 } // namespace model::viab
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace model::viab {
+
+// Constantes e configurações para análise de viabilidade
+struct AnalysisConfig {
+    static constexpr long long LIMITE_COMBINACOES = 100000000;
+    static constexpr double TMAX_PEN_THR = 31.0;  // Limite para penalidade diurna
+    static constexpr double TMIN_PEN_THR = 21.0;  // Limite para penalidade noturna
+    static constexpr double ESBRANQ_THR   = 30.0;  // Limiar de esbranquiamento
+    static constexpr double RED_THR       = 27.0;  // Limiar de redução de moagem
+    static constexpr double PENAL_DIURNA  = 0.06;
+    static constexpr double PENAL_NOTURNA = 0.10;
+    // Modo horário (graus-hora)
+    static constexpr int HORA_TMAX_UTC = 17;         // Hora típica da máxima diária (14h local)
+    static constexpr int HORA_TMIN_UTC = 9;          // Hora típica da mínima diária (06h local)
+    static constexpr double GH_TOLERANCIA = 24.0;    // Graus-hora fora de [minT, maxT] tolerados por fase
+    // Modo térmico (graus-dia)
+    static constexpr double GDD_TBASE = 10.0;        // Temperatura base padrão do arroz
+};
+
+} // namespace model::viab
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+// Consulta das melhores datas (ou janelas contíguas) de semeadura
+struct ConsultaMelhores {
+    int k = 10;                      // quantidade de janelas por grupo
+    int dias_janela = 1;             // 1 = datas isoladas; N = janelas de N dias iniciais
+    double viabilidade_min = 0.0;    // restrição sobre a viabilidade média da janela
+    std::uint64_t semente = 0;       // amostragem, quando o espaço de caminhos exige
+};
+
+struct MelhorJanela {
+    int grupo = 0;                   // chave do grupo (ex.: ano)
+    int inicio = 0;                  // índice do primeiro dia inicial
+    std::string data_inicio;
+    std::string data_fim;            // último dia inicial da janela
+    double rendimento_esperado = 0.0;  // média de P(viável) · rendimento médio
+    double prob_viabilidade = 0.0;     // média da viabilidade exata
+    double limite_superior = 0.0;      // limite usado na poda
+};
+
+struct ResultadoMelhores {
+    std::vector<MelhorJanela> janelas;   // por grupo crescente, melhor primeiro
+    long long dias_candidatos = 0;       // dias iniciais com ciclo completo
+    long long dias_avaliados = 0;        // dias com caminhos avaliados por completo
+};
+
+/**
+ * @brief Melhores K janelas de semeadura por grupo, com branch-and-bound
+ *
+ * O objetivo é o rendimento esperado (rendimento médio ponderado pela
+ * viabilidade, zero nos caminhos inviáveis). Cada dia inicial recebe primeiro
+ * sua viabilidade exata, usada na restrição, e um limite superior do
+ * rendimento esperado (limites_dia); os caminhos completos só são avaliados
+ * para janelas cujo limite ainda supera a K-ésima melhor do grupo. O resultado é o
+ * mesmo de ordenar a saída de rodar_analise, sem avaliar todos os dias.
+ *
+ * `grupos` associa cada dia a uma chave (ex.: ano); vazio = grupo único.
+ * Janelas não cruzam grupos e podem se sobrepor.
+ *
+ * @throws std::invalid_argument para k/dias_janela < 1, viabilidade_min fora
+ *         de [0, 1] ou `grupos` com tamanho diferente de `dias`
+ */
+ResultadoMelhores buscar_melhores_janelas(const std::vector<Dia>& dias,
+                                          const std::vector<Fase>& fases,
+                                          const ConsultaMelhores& consulta,
+                                          const std::vector<int>& grupos = {});
+
+} // namespace model::viab
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+inline constexpr int BINS_CALIBRACAO = 32;   // divisões de cada eixo do histograma
+
+// Célula não vazia do histograma de um dia inicial
+struct CelulaExcesso {
+    std::uint32_t indice = 0;     // bin_dia * bins + bin_noite
+    long long caminhos = 0;       // caminhos viáveis (ou amostras viáveis) na célula
+    double soma_dia = 0.0;        // soma do excesso médio de Tmax sobre TMAX_PEN_THR
+    double soma_noite = 0.0;      // soma do excesso médio de Tmin sobre TMIN_PEN_THR
+};
+
+struct EstatisticasDia {
+    long long amostras = 0;       // caminhos enumerados ou sorteados (0 = dia sem ciclo completo)
+    long long viaveis = 0;
+    std::vector<CelulaExcesso> celulas;
+};
+
+/**
+ * @brief Estatísticas suficientes do rendimento em função dos coeficientes
+ *
+ * O rendimento de um caminho é max(0, 1 - (a·Ed + b·En)), com Ed e En os
+ * excessos médios de Tmax e Tmin sobre TMAX_PEN_THR/TMIN_PEN_THR nos dias não
+ * ideais do caminho e a, b = PENAL_DIURNA, PENAL_NOTURNA. Por dia inicial,
+ * guarda-se o histograma 2-D de (Ed, En) dos caminhos viáveis em
+ * bins × bins células sobre [0, max_excesso_dia] × [0, max_excesso_noite],
+ * só as não vazias, cada uma com a contagem e as somas de Ed e En.
+ */
+struct EstatisticasPenalidade {
+    int bins = BINS_CALIBRACAO;
+    double max_excesso_dia = 0.0;     // maior excesso diário de Tmax na série
+    double max_excesso_noite = 0.0;
+    std::vector<EstatisticasDia> dias;   // um por dia da série
+};
+
+/**
+ * @brief Análise pelo motor de tabelas que também guarda as estatísticas
+ *
+ * Mesmos caminhos de rodar_analise_tabelas (exaustivo, ou as mesmas amostras
+ * com semente_dia(semente, dia)), mesmo pré-filtro e mesmos ResultadoData, a
+ * menos do arredondamento da penalidade.
+ *
+ * @throws std::invalid_argument com fases ponderadas ou durMin > durMax
+ */
+std::vector<ResultadoData> rodar_analise_estatisticas(const std::vector<Dia>& dias,
+                                                      const std::vector<Fase>& fases,
+                                                      EstatisticasPenalidade& estatisticas,
+                                                      std::uint64_t semente = 0);
+
+/**
+ * @brief Rendimento médio de um dia com coeficientes (a, b), sem reenumerar
+ *
+ * Numa célula em que a·Ed + b·En <= 1 em todo o retângulo, o rendimento é
+ * linear e a soma caminhos - a·ΣEd - b·ΣEn é exata; se >= 1 em todo ele, é 0.
+ * Só nas células cortadas pela reta a·Ed + b·En = 1 o rendimento é aproximado
+ * pelo da média da célula. Assim, quando nenhum caminho chega a rendimento
+ * zero, o resultado coincide com uma nova análise.
+ */
+double rendimento_calibrado(const EstatisticasPenalidade& estatisticas, const EstatisticasDia& dia,
+                            double penal_diurna, double penal_noturna);
+
+struct ResultadoCalibracao {
+    double penal_diurna = 0.0;
+    double penal_noturna = 0.0;
+    double rendimento_medio = 0.0;      // média de rendimento_medio entre os dias com caminho viável
+    double rendimento_esperado = 0.0;   // média de prob_viabilidade · rendimento_medio entre os dias avaliados
+    long long celulas_aproximadas = 0;  // células cortadas pelo limite de rendimento zero
+};
+
+// Todos os pares da grade penal_diurna × penal_noturna
+// @throws std::invalid_argument com coeficiente negativo
+std::vector<ResultadoCalibracao> calibrar_penalidades(const EstatisticasPenalidade& estatisticas,
+                                                      const std::vector<double>& penal_diurna,
+                                                      const std::vector<double>& penal_noturna);
+
+} // namespace model::viab
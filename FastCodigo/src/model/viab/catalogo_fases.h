@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "fase.h"
+
+namespace model::viab {
+
+/**
+ * @brief Fase fenológica conhecida em tempo de compilação
+ *
+ * Espelho constexpr de Fase usado pelos catálogos embutidos. O campo
+ * `maturacao` substitui a comparação de nome feita em avaliar_dia().
+ */
+struct FaseFixa {
+    const char* nome;
+    double minT;
+    double maxT;
+    double optMinT;
+    double optMaxT;
+    int durMin;
+    int durMax;
+    bool maturacao;
+};
+
+namespace catalogo {
+
+// Cultivar de produção: espelho de config/fases_cultivo_arroz.json
+struct ArrozPadrao {
+    static constexpr const char* nome = "default";
+    static constexpr std::size_t num_fases = 6;
+    static constexpr FaseFixa fases[num_fases] = {
+        {"Germinação",        10, 40, 25, 35,  2,  5, false},
+        {"Emergência",        12, 35, 25, 30,  7, 14, false},
+        {"Perfilhamento",     18, 35, 25, 30, 14, 28, false},
+        {"Alongamento",       20, 38, 25, 32, 21, 35, false},
+        {"Floração (Antese)", 22, 35, 28, 32,  5, 10, false},
+        {"Maturação",         15, 30, 20, 25, 25, 40, true},
+    };
+};
+
+} // namespace catalogo
+
+// Número de combinações de durações do catálogo, resolvido em compilação
+template <typename Catalogo>
+constexpr long long total_combinacoes() {
+    long long total = 1;
+    for (std::size_t i = 0; i < Catalogo::num_fases; ++i)
+        total *= Catalogo::fases[i].durMax - Catalogo::fases[i].durMin + 1;
+    return total;
+}
+
+// Soma das durações mínimas do catálogo, resolvida em compilação
+template <typename Catalogo>
+constexpr int duracao_minima() {
+    int total = 0;
+    for (std::size_t i = 0; i < Catalogo::num_fases; ++i)
+        total += Catalogo::fases[i].durMin;
+    return total;
+}
+
+// Converte o catálogo para o vetor de Fase usado pelo caminho genérico
+template <typename Catalogo>
+std::vector<Fase> fases_do_catalogo() {
+    std::vector<Fase> fases;
+    fases.reserve(Catalogo::num_fases);
+    for (const auto& f : Catalogo::fases)
+        fases.emplace_back(f.nome, f.minT, f.maxT, f.optMinT, f.optMaxT, f.durMin, f.durMax);
+    return fases;
+}
+
+} // namespace model::viab
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+#include "tabela_fases.h"
+
+namespace model::viab {
+
+/**
+ * @brief Pesos normalizados por duração a partir de uma especificação
+ *
+ * Triangular: cresce linearmente de durMin até a moda e decresce até durMax
+ * (extremos com peso positivo). Normal: densidade N(media, desvio) truncada
+ * em [durMin, durMax]. Os pesos explícitos apenas são validados e normalizados.
+ *
+ * @throws std::invalid_argument se o tamanho não for durMax - durMin + 1,
+ *         houver peso negativo, a soma for nula ou os parâmetros forem inválidos
+ */
+std::vector<double> normalizar_pesos(const Fase& fase, std::vector<double> pesos);
+std::vector<double> pesos_triangulares(const Fase& fase, double moda);
+std::vector<double> pesos_normais(const Fase& fase, double media, double desvio);
+
+// true se alguma fase tem distribuição de durações não uniforme
+bool tem_pesos(const std::vector<Fase>& fases);
+
+// Massas por dia de término (índice = inicio + off → off) dos caminhos viáveis de um dia inicial
+struct TerminosDia {
+    std::vector<double> prob;         // P(viável, término em off)
+    std::vector<double> rendimento;   // E[rendimento · viável, término em off]
+    std::vector<double> ideal;        // P(ideal, término em off)
+    std::vector<double> sem_esb;      // P(viável sem risco de esbranquiamento, término em off)
+    std::vector<double> sem_red;      // P(viável sem risco de redução, término em off)
+    std::vector<double> caminhos;     // caminhos viáveis (não ponderados) com término em off
+    int lo = 0, hi = -1;              // faixa de off possível (soma de durMin..durMax)
+};
+
+/**
+ * @brief Distribuição dos dias de término de um dia inicial (DP de analisar_dia_ponderado)
+ *
+ * Também serve a quem encadeia safras (rotacao.h): a safra seguinte depende só
+ * do dia em que esta termina.
+ */
+TerminosDia terminos_dia(const std::vector<TabelaFase>& tabelas, const std::vector<Fase>& fases,
+                         int n, int inicio, std::uint64_t semente);
+
+/**
+ * @brief Resultado ponderado exato de um dia inicial por programação dinâmica
+ *
+ * Soma, fase a fase, sobre os dias de término possíveis (como limites_dia):
+ * probabilidade dos prefixos viáveis, massa de penalidade, probabilidade de
+ * seguirem ideais e de não terem risco de esbranquiamento/redução, além da
+ * contagem de caminhos. Custa O(P · alcance · faixa) em vez de um termo por
+ * caminho. O rendimento max(0, 1 - pen/T) é linear na penalidade enquanto
+ * pen <= T; a DP também acompanha o maior pen - T entre os caminhos viáveis e,
+ * só se ele for positivo, o rendimento é refeito caminho a caminho (exaustivo
+ * ou amostrado conforme o plano) com os mesmos pesos.
+ */
+ResultadoData analisar_dia_ponderado(const std::vector<TabelaFase>& tabelas,
+                                     const std::vector<Fase>& fases, int n, int inicio,
+                                     std::uint64_t semente);
+
+/**
+ * @brief Análise completa com durações ponderadas (fases com `pesos`)
+ *
+ * Fases sem pesos contam como uniformes. Chamado por rodar_analise quando
+ * tem_pesos(fases).
+ *
+ * @param descartados Se não nulo, recebe o número de dias descartados pelo pré-filtro
+ */
+std::vector<ResultadoData> rodar_analise_ponderada(const std::vector<Dia>& dias,
+                                                   const std::vector<Fase>& fases,
+                                                   std::uint64_t semente = 0,
+                                                   size_t* descartados = nullptr);
+
+} // namespace model::viab
@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+inline constexpr int LEITURAS_DIA = 24;   // leituras horárias por dia
+
+// O que foi observado de um dia: extremos presentes e leituras horárias que faltam
+struct LeiturasDia {
+    int ausentes = LEITURAS_DIA;   // leituras horárias não observadas (0..LEITURAS_DIA)
+    bool tmax_observada = false;
+    bool tmin_observada = false;
+};
+
+// Série diária com a máscara dos dias a imputar (lacuna[i] != 0: falta alguma leitura)
+struct SerieComLacunas {
+    std::vector<Dia> dias;
+    std::vector<char> lacuna;
+    std::vector<LeiturasDia> leituras;   // um por dia; vazio = lacunas sem nenhuma leitura
+};
+
+// Saídas resumidas no ensemble, na ordem de NOMES_SAIDAS_ENSEMBLE
+constexpr int NUM_SAIDAS_ENSEMBLE = 5;
+extern const std::array<const char*, NUM_SAIDAS_ENSEMBLE> NOMES_SAIDAS_ENSEMBLE;
+
+struct ResultadoEnsemble {
+    ResultadoData media;                               // médias das realizações (contagens arredondadas)
+    std::array<double, NUM_SAIDAS_ENSEMBLE> desvio{};  // desvio-padrão amostral entre realizações
+    bool afetado = false;                              // algum caminho alcança uma lacuna
+};
+
+/**
+ * @brief Valores de uma realização para um dia com leituras ausentes
+ *
+ * Mesmo critério da imputação "randômica" do pré-processamento: só as
+ * leituras horárias ausentes são sorteadas, uniformes em [menor optMinT,
+ * maior optMaxT] das fases, e Tmax/Tmin são recalculados sobre elas e os
+ * extremos observados do dia. Determinístico em (semente, realização, dia).
+ */
+void imputar_dia(Dia& dia, const LeiturasDia& leituras, const std::vector<Fase>& fases,
+                 std::uint64_t semente, int realizacao, int indice_dia);
+
+/**
+ * @brief Avalia N realizações de preenchimento das lacunas em uma execução
+ *
+ * Dias iniciais cujos caminhos não alcançam nenhuma lacuna (alcance = soma de
+ * durMax) têm o mesmo resultado em todas as realizações e são avaliados uma
+ * única vez; apenas os demais são reavaliados por realização. As tabelas são
+ * construídas uma vez e, a cada realização, corrigidas só nos trechos que
+ * esses dias leem, a partir dos dias de lacuna. Usa o motor de tabelas (idêntico ao modo exaustivo de
+ * rodar_analise); na amostragem, cada dia usa a mesma semente em todas as
+ * realizações, de modo que o desvio reflete só o preenchimento.
+ *
+ * @throws std::invalid_argument se realizacoes < 1 ou a máscara (ou as
+ *         leituras, se presentes) não tiver um valor por dia
+ */
+std::vector<ResultadoEnsemble> rodar_ensemble_imputacao(const SerieComLacunas& serie,
+                                                        const std::vector<Fase>& fases,
+                                                        int realizacoes,
+                                                        std::uint64_t semente = 0);
+
+} // namespace model::viab
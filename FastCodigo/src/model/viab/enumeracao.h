@@ -0,0 +1,64 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include "fase.h"
+
+namespace model::viab {
+
+/**
+ * @brief Percorre as combinações de durações a partir de `inicio` com poda
+ *
+ * Versão iterativa (profundidade primeiro) do produto cartesiano de durações.
+ * `faixa(i, a)` devolve o intervalo fechado de durações admissíveis da fase i
+ * iniciada no dia a. `estender(i, a, b, anterior, novo)` avalia a janela
+ * [a, b) da fase i e retorna false quando ela é inviável; como uma janela
+ * maior contém a menor, a falha encerra as durações restantes da fase.
+ * `folha(limites, estado)` recebe as fronteiras das fases (P+1 posições)
+ * de cada caminho completo.
+ *
+ * Caminhos que ultrapassam `n` dias são descartados, como em avaliar_sequencia.
+ */
+template <typename Estado, typename Faixa, typename Estender, typename Folha>
+void enumerar_caminhos_faixas(int P, int n, int inicio, const Estado& inicial,
+                              Faixa&& faixa, Estender&& estender, Folha&& folha) {
+    if (P == 0) return;
+    std::vector<int> limites(P + 1);
+    std::vector<int> dur(P), dur_max(P);
+    std::vector<Estado> estados(P + 1, inicial);
+    auto entrar = [&](int i) {
+        std::pair<int, int> f = faixa(i, limites[i]);
+        dur[i] = f.first - 1;
+        dur_max[i] = f.second;
+    };
+
+    limites[0] = inicio;
+    entrar(0);
+    int i = 0;
+    while (i >= 0) {
+        const int fim = limites[i] + (++dur[i]);
+        if (dur[i] > dur_max[i] || fim > n ||
+            !estender(i, limites[i], fim, estados[i], estados[i + 1])) {
+            --i;
+            continue;
+        }
+        limites[i + 1] = fim;
+        if (i + 1 == P) {
+            folha(limites.data(), estados[P]);
+        } else {
+            ++i;
+            entrar(i);
+        }
+    }
+}
+
+// Enumeração sobre as faixas fixas [durMin, durMax] de cada fase
+template <typename Estado, typename Estender, typename Folha>
+void enumerar_caminhos(const std::vector<Fase>& fases, int n, int inicio,
+                       const Estado& inicial, Estender&& estender, Folha&& folha) {
+    enumerar_caminhos_faixas(
+        static_cast<int>(fases.size()), n, inicio, inicial,
+        [&](int i, int) { return std::make_pair(fases[i].durMin, fases[i].durMax); },
+        estender, folha);
+}
+
+} // namespace model::viab
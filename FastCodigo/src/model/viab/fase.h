@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include <vector>
+#include "analysis_config.h"
 
 namespace model::viab {
     struct Fase {
@@ -20,5 +22,15 @@ namespace model::viab {
         double optMaxT;
         int durMin;
         int durMax;
+        // Modo horário: graus-hora fora de [minT, maxT] tolerados na fase
+        double toleranciaGH = AnalysisConfig::GH_TOLERANCIA;
+        // Modo GDD: a fase termina ao acumular gddAlvo ± gddTolerancia graus-dia
+        // acima de tBase; fases sem alvo (0) usam [durMin, durMax]
+        double gddAlvo = 0.0;
+        double gddTolerancia = 0.0;
+        double tBase = AnalysisConfig::GDD_TBASE;
+        // Probabilidade de cada duração em [durMin, durMax], somando 1;
+        // vazio = uniforme (ver duracao_ponderada.h)
+        std::vector<double> pesos;
     };
 } // namespace model::viab
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "fase.h"
+#include "tabela_fases.h"
+
+namespace model::viab {
+
+// Hash (FNV-1a 64) do conteúdo de uma fase: nome, limites térmicos e durações
+std::uint64_t hash_fase(const Fase& fase);
+
+// Dias cuja avaliação diária difere entre duas tabelas da mesma série (1 = alterado)
+std::vector<char> dias_alterados(const TabelaFase& antiga, const TabelaFase& nova);
+
+/**
+ * @brief Dias iniciais cujos caminhos podem passar por um dia alterado na fase `fase`
+ *
+ * A partir de d, a fase i ocupa apenas dias em [d + Σ_{j<i} durMin_j,
+ * d + Σ_{j<=i} durMax_j); fora dessa janela a mudança não altera nenhum
+ * caminho, e o resultado anterior do dia pode ser reaproveitado. O(n) com
+ * somas prefixadas dos dias alterados.
+ */
+std::vector<char> inicios_afetados(const std::vector<Fase>& fases, size_t fase,
+                                   const std::vector<char>& alterados);
+
+} // namespace model::viab
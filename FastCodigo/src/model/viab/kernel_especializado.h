@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "catalogo_fases.h"
+#include "pool_trabalho.h"
+#include "tabela_fases.h"
+
+namespace model::viab {
+
+/**
+ * @brief Verifica se a cultivar possui catálogo embutido nesta compilação
+ *
+ * Catálogos só são embutidos com a opção RICEGUARD_CATALOGOS_EMBUTIDOS.
+ */
+bool cultivar_embutida(const std::string& nome);
+
+// Fases da cultivar embutida; lança std::invalid_argument se indisponível
+std::vector<Fase> fases_cultivar(const std::string& nome);
+
+// Executa o kernel especializado da cultivar embutida
+std::vector<ResultadoData> rodar_analise_cultivar(const std::vector<Dia>& dias,
+                                                  const std::string& nome);
+
+namespace kernel {
+
+// Acumuladores de um dia inicial
+struct Contagem {
+    long long viaveis = 0;
+    long long optimos = 0;
+    long long esb = 0;
+    long long red = 0;
+    double soma_rend = 0.0;
+};
+
+// Estado parcial do caminho ao fim das fases já escolhidas
+struct Parcial {
+    double penalidade;
+    bool ideal;
+    bool esb;
+    bool red;
+};
+
+/**
+ * Tabela da fase I com os limites de temperatura do catálogo como constantes:
+ * mesma semântica de avaliar_dia() (dia ideal sem penalidade, riscos só na
+ * maturação), mas cada comparação usa um imediato e a maturação é decidida
+ * em compilação, sem comparar nomes.
+ */
+template <typename Catalogo, std::size_t I>
+void preencher_tabela(const std::vector<Dia>& dias, TabelaFase& t) {
+    constexpr FaseFixa fase = Catalogo::fases[I];
+    using Cfg = AnalysisConfig;
+    const size_t n = dias.size();
+    t.inviaveis.assign(n + 1, 0);
+    t.nao_ideais.assign(n + 1, 0);
+    t.penalidade.assign(n + 1, 0.0);
+    t.esbranq.assign(n + 1, 0);
+    t.reducao.assign(n + 1, 0);
+    t.proximo_inviavel.assign(n + 1, static_cast<int>(n));
+
+    double penalidade = 0.0;
+    for (size_t d = 0; d < n; ++d) {
+        const double tmax = dias[d].tmax, tmin = dias[d].tmin;
+        const bool viavel = tmax >= fase.minT && tmax <= fase.maxT && tmin >= fase.minT && tmin <= fase.maxT;
+        const bool ideal = viavel && tmax >= fase.optMinT && tmax <= fase.optMaxT &&
+                           tmin >= fase.optMinT && tmin <= fase.optMaxT;
+        double pen_dia = 0.0, pen_noite = 0.0;
+        if (viavel && !ideal) {
+            if (tmax > Cfg::TMAX_PEN_THR) pen_dia = (tmax - Cfg::TMAX_PEN_THR) * Cfg::PENAL_DIURNA;
+            if (tmin > Cfg::TMIN_PEN_THR) pen_noite = (tmin - Cfg::TMIN_PEN_THR) * Cfg::PENAL_NOTURNA;
+        }
+        penalidade += pen_dia + pen_noite;
+        t.inviaveis[d + 1]  = t.inviaveis[d] + !viavel;
+        t.nao_ideais[d + 1] = t.nao_ideais[d] + !ideal;
+        t.penalidade[d + 1] = penalidade;
+        if constexpr (fase.maturacao) {
+            t.esbranq[d + 1] = t.esbranq[d] + (viavel && tmax > Cfg::ESBRANQ_THR);
+            t.reducao[d + 1] = t.reducao[d] + (viavel && tmin > Cfg::RED_THR);
+        }
+    }
+    for (size_t d = n; d-- > 0;) {
+        const bool inviavel = t.inviaveis[d + 1] != t.inviaveis[d];
+        t.proximo_inviavel[d] = inviavel ? static_cast<int>(d) : t.proximo_inviavel[d + 1];
+    }
+}
+
+template <typename Catalogo, std::size_t... I>
+std::vector<TabelaFase> construir_tabelas_fixas(const std::vector<Dia>& dias, std::index_sequence<I...>) {
+    std::vector<TabelaFase> tabelas(Catalogo::num_fases);
+    (preencher_tabela<Catalogo, I>(dias, tabelas[I]), ...);
+    return tabelas;
+}
+
+// Tabelas de todas as fases do catálogo, sem passar por Fase/avaliar_dia
+template <typename Catalogo>
+std::vector<TabelaFase> construir_tabelas_fixas(const std::vector<Dia>& dias) {
+    return construir_tabelas_fixas<Catalogo>(dias, std::make_index_sequence<Catalogo::num_fases>{});
+}
+
+/**
+ * Enumera as durações da fase I a partir de `pos`. Os limites de duração e o
+ * número de fases são constantes do catálogo, de modo que cada nível é gerado
+ * com laço próprio e os ramos inviáveis são cortados via proximo_inviavel
+ * (toda duração maior que o corte também seria inviável).
+ */
+template <typename Catalogo, std::size_t I>
+inline void enumerar(const TabelaFase* tabelas, int n, int inicio, int pos,
+                     Parcial p, Contagem& c) {
+    constexpr FaseFixa fase = Catalogo::fases[I];
+    const TabelaFase& t = tabelas[I];
+    const int limite = std::min(t.proximo_inviavel[pos], n);
+    const int dur_max = std::min(fase.durMax, limite - pos);
+
+    for (int d = fase.durMin; d <= dur_max; ++d) {
+        const int fim = pos + d;
+        Parcial q = p;
+        q.penalidade += t.penalidade[fim] - t.penalidade[pos];
+        q.ideal = q.ideal && t.nao_ideais[fim] == t.nao_ideais[pos];
+        if constexpr (fase.maturacao) {
+            q.esb = q.esb || t.esbranq[fim] != t.esbranq[pos];
+            q.red = q.red || t.reducao[fim] != t.reducao[pos];
+        }
+        if constexpr (I + 1 == Catalogo::num_fases) {
+            c.viaveis++;
+            c.soma_rend += std::max(0.0, 1.0 - q.penalidade / (fim - inicio));
+            c.optimos += q.ideal;
+            c.esb += q.esb;
+            c.red += q.red;
+        } else {
+            enumerar<Catalogo, I + 1>(tabelas, n, inicio, fim, q, c);
+        }
+    }
+}
+
+} // namespace kernel
+
+/**
+ * @brief Análise exaustiva com as fases fixadas em tempo de compilação
+ *
+ * Produz os mesmos campos de rodar_analise() no modo exaustivo; o total de
+ * combinações, a duração mínima do ciclo e os limites de temperatura das
+ * tabelas são constantes do catálogo.
+ */
+template <typename Catalogo>
+std::vector<ResultadoData> rodar_analise_fixa(const std::vector<Dia>& dias) {
+    constexpr long long total = total_combinacoes<Catalogo>();
+    constexpr int dias_min = duracao_minima<Catalogo>();
+    static_assert(total <= AnalysisConfig::LIMITE_COMBINACOES / 10,
+                  "Catálogo exige amostragem: use o caminho genérico");
+
+    std::vector<ResultadoData> resultados;
+    const int n = static_cast<int>(dias.size());
+    if (n == 0) return resultados;
+
+    const auto tabelas = kernel::construir_tabelas_fixas<Catalogo>(dias);
+    resultados.resize(n);
+
+    paralelo_para(0, n, [&](int dia0) {
+        if (n - dia0 < dias_min) return;
+
+        kernel::Contagem c;
+        kernel::enumerar<Catalogo, 0>(tabelas.data(), n, dia0, dia0,
+                                      kernel::Parcial{0.0, true, false, false}, c);
+
+        auto& out = resultados[dia0];
+        out.data_str         = dias[dia0].data_str;
+        out.total_caminhos   = caminhos_exatos(total);
+        out.caminhos_viaveis = c.viaveis;
+        if (c.viaveis > 0) {
+            out.prob_viabilidade     = static_cast<double>(c.viaveis) / total;
+            out.rendimento_medio     = c.soma_rend / c.viaveis;
+            out.prob_optimo          = static_cast<double>(c.optimos) / total;
+            out.prob_esbranquiamento = static_cast<double>(c.esb) / c.viaveis;
+            out.prob_reducao_moagem  = static_cast<double>(c.red) / c.viaveis;
+        }
+    });
+    return resultados;
+}
+
+} // namespace model::viab
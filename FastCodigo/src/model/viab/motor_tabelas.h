@@ -0,0 +1,138 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "amostragem.h"
+#include "analise_viabilidade.h"
+#include "tabela_fases.h"
+
+namespace model::viab {
+
+// Parâmetros derivados das fases, com a mesma regra de modo do caminho genérico
+struct PlanoAnalise {
+    TotalCaminhos caminhos;            // produto exato (128 bits) ou log10
+    long long total_combinacoes = 0;   // caminhos.saturado()
+    bool usar_amostragem = false;
+    long long amostras = 0;            // avaliações por dia inicial
+    int dias_min = 0;                  // dias necessários para o ciclo mais curto
+};
+
+PlanoAnalise planejar_analise(const std::vector<Fase>& fases);
+
+// Contagens brutas de um dia inicial (somas, não razões)
+struct ContagemDia {
+    long long amostras = 0;
+    long long viaveis = 0;
+    long long optimos = 0;
+    long long esb = 0;
+    long long red = 0;
+    double soma_rend = 0.0;
+};
+
+/**
+ * @brief Precisão da penalidade nas tabelas e nos caminhos
+ *
+ * Simples (float) guarda em 32 bits a penalidade por dia das tabelas e a do
+ * caminho em construção, ao lado dos contadores int; as somas de rendimento e
+ * as contagens continuam em double/inteiros. O prefixo em float é re-baseado a
+ * cada DIAS_BLOCO_PENALIDADE dias, então o erro de uma janela depende do
+ * bloco, não do comprimento da série; comparar_precisao() mede o desvio numa
+ * série concreta.
+ */
+enum class Precisao { Dupla, Simples };
+
+// Todas as combinações a partir de `inicio`, com poda pelo próximo dia inviável
+// (instanciado para float e double)
+template <typename Real>
+ContagemDia enumerar_dia(const std::vector<TabelaFaseT<Real>>& tabelas,
+                         const std::vector<Fase>& fases, int n, int inicio);
+
+// `amostras` caminhos com durações uniformes e independentes por fase
+template <typename Real>
+ContagemDia amostrar_dia(const std::vector<TabelaFaseT<Real>>& tabelas,
+                         const std::vector<Fase>& fases, int n, int inicio,
+                         long long amostras, std::uint64_t semente);
+
+// Resultado da programação dinâmica de limites de um dia inicial
+struct LimitesDia {
+    double viabilidade = 0.0;          // probabilidade exata de viabilidade
+    double limite_rendimento = 0.0;    // limite superior de P(viável) · rendimento médio
+};
+
+/**
+ * @brief Viabilidade exata e limite do rendimento esperado a partir de `inicio`
+ *
+ * Programação dinâmica sobre (fase, dia de término) com durações uniformes e
+ * independentes, custando O(P · alcance · faixa) mesmo quando o espaço de
+ * caminhos exige amostragem. Além da probabilidade, acumula a penalidade
+ * esperada e a máxima dos caminhos viáveis: com T <= Tmax (soma de durMax),
+ * max(0, 1 - pen/T) <= max(0, 1 - x), x = pen/Tmax, que fica abaixo da corda
+ * 1 - x/X em [0, X] (X = max(1, pen_max/Tmax)). O limite é linear na
+ * penalidade e, portanto, exato em esperança.
+ */
+LimitesDia limites_dia(const std::vector<TabelaFase>& tabelas,
+                       const std::vector<Fase>& fases, int n, int inicio);
+
+// Probabilidade exata de viabilidade a partir de `inicio` (ver limites_dia)
+double probabilidade_viavel(const std::vector<TabelaFase>& tabelas,
+                            const std::vector<Fase>& fases, int n, int inicio);
+
+/**
+ * @brief Condição necessária de viabilidade a partir de `inicio` (pré-filtro)
+ *
+ * Propaga fase a fase o intervalo [lo, hi] de dias em que a fase pode
+ * começar: de cada início a, a fase termina em [a + durMin, min(a + durMax,
+ * proximo_inviavel[a], n)] se esse intervalo não for vazio. O intervalo é a
+ * envoltória dos términos alcançáveis, logo `false` prova que nenhum caminho
+ * é viável e o dia pode receber zeros exatos sem enumeração nem amostragem.
+ * Custa O(P · faixa), contra milhões de caminhos por dia.
+ */
+template <typename Real>
+bool pode_ser_viavel(const std::vector<TabelaFaseT<Real>>& tabelas,
+                     const std::vector<Fase>& fases, int n, int inicio);
+
+// Semente própria de cada dia inicial (splitmix64), reprodutível e sem correlação entre dias
+std::uint64_t semente_dia(std::uint64_t semente, std::uint64_t dia);
+
+/**
+ * @brief Avalia os dias iniciais `inicios` em paralelo sobre tabelas da série
+ *
+ * Exaustivo ou amostrado conforme o plano; na amostragem cada dia usa
+ * semente_dia(semente, dia), então o resultado de um dia não depende de quais
+ * outros dias são avaliados junto. `concluir(j, contagem)` é chamado ao fim
+ * de inicios[j], de qualquer thread. Dias reprovados por pode_ser_viavel()
+ * recebem contagens nulas com o mesmo número de amostras, o que resulta nos
+ * mesmos ResultadoData da avaliação completa.
+ *
+ * @return Quantos dias o pré-filtro descartou
+ */
+size_t avaliar_dias(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                    const std::vector<int>& inicios, std::uint64_t semente,
+                    const std::function<void(size_t, const ContagemDia&)>& concluir,
+                    Precisao precisao = Precisao::Dupla);
+
+// Como avaliar_dias, sobre tabelas já construídas de uma série de `n` dias
+// (ex.: colunas contíguas de uma célula de grade); instanciado para float e double
+template <typename Real>
+size_t avaliar_dias(const std::vector<TabelaFaseT<Real>>& tabelas, const std::vector<Fase>& fases,
+                    int n, const std::vector<int>& inicios, std::uint64_t semente,
+                    const std::function<void(size_t, const ContagemDia&)>& concluir);
+
+// Converte as contagens em ResultadoData (sem data_str)
+ResultadoData finalizar_contagem(const ContagemDia& c, const PlanoAnalise& plano);
+
+/**
+ * @brief Análise completa pelo motor de tabelas na precisão escolhida
+ *
+ * Na amostragem usa semente_dia(semente, dia), então as duas precisões sorteiam
+ * os mesmos caminhos e diferem apenas no arredondamento da penalidade.
+ *
+ * @param descartados Se não nulo, recebe o número de dias descartados pelo pré-filtro
+ * @throws std::invalid_argument se alguma fase tiver durMin > durMax
+ */
+std::vector<ResultadoData> rodar_analise_tabelas(const std::vector<Dia>& dias,
+                                                 const std::vector<Fase>& fases,
+                                                 Precisao precisao, std::uint64_t semente = 0,
+                                                 size_t* descartados = nullptr);
+
+} // namespace model::viab
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+#include "motor_tabelas.h"
+
+namespace model::viab {
+
+/**
+ * @brief Resultado bruto de uma fatia de dias iniciais (um processo de --shard)
+ *
+ * Guarda contagens e somas (ContagemDia), não razões, para que as fatias se
+ * combinem sem perda. Carrega também as fases e o calendário completo da
+ * série, de modo que o merge não precisa reler a entrada, e uma impressão
+ * digital de (série, fases, semente) para recusar fatias de execuções distintas.
+ */
+struct ResultadoParcial {
+    int indice = 0;                      // fatia i de N
+    int total = 1;
+    std::uint64_t semente = 0;
+    std::uint64_t impressao = 0;
+    std::vector<Fase> fases;
+    std::vector<std::string> datas;      // uma por dia da série
+    std::vector<int> meses;
+    std::vector<int> dias_iniciais;      // dias avaliados nesta fatia
+    std::vector<ContagemDia> contagens;  // alinhado com dias_iniciais
+};
+
+// Dias iniciais da fatia i de N: d ≡ i (mod N), o que equilibra a carga entre fatias
+bool pertence_a_fatia(int dia, int indice, int total);
+
+// Impressão digital (FNV-1a 64) da série, das fases, da semente e das constantes do modelo
+std::uint64_t impressao_execucao(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                                 std::uint64_t semente);
+
+/**
+ * @brief Avalia apenas os dias iniciais da fatia `indice` de `total`
+ *
+ * Usa o motor de tabelas; na amostragem, cada dia usa semente_dia(semente, dia),
+ * logo o resultado não depende de como a série foi fatiada.
+ *
+ * @throws std::invalid_argument se total < 1 ou indice fora de [0, total)
+ */
+ResultadoParcial rodar_fatia(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                             int indice, int total, std::uint64_t semente = 0);
+
+// Série e resultados reconstituídos a partir das fatias
+struct ResultadoCombinado {
+    std::vector<Dia> dias;                  // data_str e mes (sem temperaturas)
+    std::vector<ResultadoData> resultados;  // como rodar_analise (vazios sem ciclo completo)
+};
+
+/**
+ * @brief Combina as N fatias de uma execução
+ *
+ * @throws std::invalid_argument se faltar ou sobrar fatia, ou se as fatias
+ *         vierem de execuções diferentes (impressão, N ou série distintos)
+ */
+ResultadoCombinado combinar_parciais(const std::vector<ResultadoParcial>& parciais);
+
+} // namespace model::viab
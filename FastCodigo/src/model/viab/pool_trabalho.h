@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace model::viab {
+
+// Fixação das threads do pool em CPUs (entre as permitidas ao processo)
+enum class Afinidade {
+    Nenhuma,     // o sistema escolhe
+    Compacta,    // trabalhador k na k-ésima CPU permitida (vizinhas, mesmo soquete primeiro)
+    Espalhada,   // trabalhadores distribuídos uniformemente pelas CPUs permitidas
+};
+
+// "nenhuma", "compacta" ou "espalhada"
+// @throws std::invalid_argument para outro texto
+Afinidade afinidade_de_texto(const std::string& texto);
+
+struct ConfiguracaoPool {
+    int threads = 0;                        // total, contando o chamador; <= 0 = omp_get_max_threads()
+    Afinidade afinidade = Afinidade::Nenhuma;
+};
+
+/**
+ * @brief Threads de trabalho persistentes, reaproveitadas por todas as análises
+ *
+ * As threads são criadas (e fixadas em CPUs, se pedido) uma vez; cada laço
+ * paralelo apenas publica a tarefa e acorda os trabalhadores, que esperam
+ * girando brevemente antes de dormir. Assim, muitas análises pequenas em
+ * sequência (chamadas embutidas, grade célula a célula) não pagam criação de
+ * threads nem migração entre núcleos a cada chamada. Com afinidade, o que um
+ * trabalhador aloca e preenche dentro da tarefa (séries e tabelas por célula)
+ * fica na memória do seu nó NUMA pela política de primeiro toque.
+ *
+ * para_cada distribui os índices dinamicamente (um por vez, como
+ * schedule(dynamic)) e o chamador também trabalha. Chamadas aninhadas, ou
+ * concorrentes vindas de outra thread enquanto o pool está ocupado, rodam em
+ * série na thread que chamou. A primeira exceção de um corpo interrompe a
+ * distribuição e é relançada no chamador.
+ */
+class PoolTrabalho {
+public:
+    explicit PoolTrabalho(const ConfiguracaoPool& configuracao = {});
+    ~PoolTrabalho();
+    PoolTrabalho(const PoolTrabalho&) = delete;
+    PoolTrabalho& operator=(const PoolTrabalho&) = delete;
+
+    int threads() const { return static_cast<int>(trabalhadores_.size()) + 1; }
+    const ConfiguracaoPool& configuracao() const { return configuracao_; }
+
+    // Executa corpo(i) para i em [0, n)
+    void para_cada(std::size_t n, const std::function<void(std::size_t)>& corpo);
+
+private:
+    void trabalhar(int indice);
+    void executar();
+
+    ConfiguracaoPool configuracao_;
+    std::vector<std::thread> trabalhadores_;
+    std::mutex envio_;                      // uma tarefa paralela por vez
+    std::mutex m_;
+    std::condition_variable cv_tarefa_;
+    std::condition_variable cv_fim_;
+    std::atomic<std::uint64_t> geracao_{0};
+    std::atomic<int> pendentes_{0};
+    std::atomic<bool> parar_{false};
+
+    // Tarefa atual
+    const std::function<void(std::size_t)>* corpo_ = nullptr;
+    std::size_t total_ = 0;
+    std::atomic<std::size_t> proximo_{0};
+    std::mutex m_erro_;
+    std::exception_ptr erro_;
+};
+
+// Pool global usado pelos motores; criado no primeiro uso com a configuração padrão
+PoolTrabalho& pool_trabalho();
+
+// Recria o pool global (não chamar enquanto houver análise em andamento)
+void configurar_pool(const ConfiguracaoPool& configuracao);
+
+// Laço paralelo no pool global: corpo(i) para i em [0, n)
+template <typename Corpo>
+void paralelo_para(std::size_t n, Corpo&& corpo) {
+    pool_trabalho().para_cada(n, std::function<void(std::size_t)>(std::forward<Corpo>(corpo)));
+}
+
+// Laço paralelo de índices inteiros: corpo(d) para d em [inicio, fim) (vazio se fim <= inicio)
+template <typename Corpo>
+void paralelo_para(int inicio, int fim, Corpo&& corpo) {
+    if (fim <= inicio) return;
+    pool_trabalho().para_cada(static_cast<std::size_t>(fim - inicio),
+                              [&](std::size_t j) { corpo(inicio + static_cast<int>(j)); });
+}
+
+} // namespace model::viab
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "analise_viabilidade.h"
+
+namespace model::viab {
+
+// Maior desvio absoluto de um campo de ResultadoData e o dia em que ocorreu
+struct DesvioCampo {
+    std::string campo;
+    double desvio_max = 0.0;
+    int dia = -1;            // -1 se não houve desvio
+};
+
+// Relatório do modo de validação: um DesvioCampo por campo numérico
+struct ValidacaoPrecisao {
+    std::vector<DesvioCampo> campos;
+    int dias_divergentes = 0;   // dias com algum campo diferente
+};
+
+/**
+ * @brief Compara campo a campo os resultados das duas precisões
+ *
+ * @param referencia Resultados em double (Precisao::Dupla)
+ * @param avaliado   Resultados da mesma série em float (Precisao::Simples)
+ * @throws std::invalid_argument se as séries tiverem tamanho ou datas diferentes
+ */
+ValidacaoPrecisao comparar_precisao(const std::vector<ResultadoData>& referencia,
+                                    const std::vector<ResultadoData>& avaliado);
+
+} // namespace model::viab
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+// Intervalo, em dias, entre o fim da primeira safra e a segunda semeadura (uniforme em [minimo, maximo])
+struct IntervaloRotacao {
+    int minimo = 0;
+    int maximo = 0;
+};
+
+// Par de safras de uma primeira data de semeadura
+struct ResultadoRotacao {
+    std::string data_str;
+    double prob_viabilidade_primeira = 0.0;   // primeira safra sozinha
+    double prob_viabilidade_conjunta = 0.0;   // as duas safras viáveis
+    double rendimento_primeira = 0.0;         // médio da primeira nos pares viáveis
+    double rendimento_segunda = 0.0;          // médio da segunda nos pares viáveis
+    double rendimento_conjunto = 0.0;         // soma das duas (0 a 2) nos pares viáveis
+    double dias_ate_segunda = 0.0;            // da primeira à segunda semeadura, médio nos pares viáveis
+};
+
+/**
+ * @brief Duas safras por ano: a segunda é semeada após o fim da primeira
+ *
+ * Para cada primeira semeadura d, a distribuição do dia de término e da
+ * primeira safra vem de terminos_dia (exata, com os pesos de duração das
+ * fases). A segunda começa em e + g, g uniforme no intervalo, e depende só
+ * desse dia; seus resultados de safra única por dia inicial são calculados
+ * uma vez e acumulados em somas prefixadas, então cada (d, e) custa O(1) e a
+ * análise toda fica em O(n · alcance) em vez do produto dos dois espaços de
+ * caminhos. Segundas semeaduras sem ciclo completo na série contam como
+ * inviáveis.
+ *
+ * @throws std::invalid_argument se o intervalo for negativo ou invertido,
+ *         ou se alguma fase tiver durMin > durMax
+ */
+std::vector<ResultadoRotacao> rodar_analise_rotacao(const std::vector<Dia>& dias,
+                                                    const std::vector<Fase>& primeira,
+                                                    const std::vector<Fase>& segunda,
+                                                    IntervaloRotacao intervalo,
+                                                    std::uint64_t semente = 0);
+
+} // namespace model::viab
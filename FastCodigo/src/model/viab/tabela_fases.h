@@ -0,0 +1,70 @@
+#pragma once
+#include <type_traits>
+#include <vector>
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+inline constexpr int DIAS_BLOCO_PENALIDADE = 32;   // re-base do prefixo de penalidade em float
+
+/**
+ * @brief Somas prefixadas da avaliação diária de uma fase sobre toda a série
+ *
+ * Cada vetor tem n+1 posições (posição 0 = 0), de modo que a janela de dias
+ * [a, b) da fase é avaliada em O(1): inviaveis[b] - inviaveis[a] etc.
+ * proximo_inviavel[d] é o primeiro dia >= d fora de [minT, maxT] (n se nenhum),
+ * o que limita diretamente a maior duração viável a partir de d.
+ *
+ * `Real` é o tipo da penalidade acumulada: float reduz à metade o espaço da
+ * tabela e dobra a largura SIMD (ver Precisao em motor_tabelas.h). Em float o
+ * prefixo absoluto perderia dígitos à medida que cresce com a série; por isso
+ * penalidade[d] é relativa ao início do bloco de DIAS_BLOCO_PENALIDADE dias
+ * que contém d, cuja base fica em double em base_penalidade. Use
+ * penalidade_janela() para somar uma janela.
+ */
+template <typename Real>
+struct TabelaFaseT {
+    std::vector<int> inviaveis;
+    std::vector<int> nao_ideais;
+    std::vector<Real> penalidade;     // penalidade diurna + noturna (0 em dias ideais)
+    std::vector<int> esbranq;         // risco de esbranquiamento (apenas Maturação)
+    std::vector<int> reducao;         // risco de redução de moagem (apenas Maturação)
+    std::vector<int> proximo_inviavel;
+    std::vector<double> base_penalidade;   // só float: prefixo no início de cada bloco
+};
+
+// Penalidade da janela [a, b); em float o erro é o de somas de poucos blocos, não o do prefixo da série
+template <typename Real>
+inline Real penalidade_janela(const TabelaFaseT<Real>& t, int a, int b) {
+    if constexpr (std::is_same_v<Real, float>) {
+        const double bases = t.base_penalidade[b / DIAS_BLOCO_PENALIDADE] -
+                             t.base_penalidade[a / DIAS_BLOCO_PENALIDADE];
+        return (t.penalidade[b] - t.penalidade[a]) + static_cast<float>(bases);
+    } else {
+        return t.penalidade[b] - t.penalidade[a];
+    }
+}
+
+using TabelaFase = TabelaFaseT<double>;
+
+/**
+ * @brief Constrói a tabela de cada fase a partir da série diária
+ *
+ * Usa avaliar_dia(), portanto preserva exatamente a semântica dia a dia
+ * do caminho genérico (inclusive o rendimento 1.0 sem penalidade em dias ideais).
+ */
+std::vector<TabelaFase> construir_tabelas(const std::vector<Dia>& dias,
+                                          const std::vector<Fase>& fases);
+
+// Mesma construção sobre colunas contíguas de Tmax/Tmin (sem materializar Dia)
+std::vector<TabelaFase> construir_tabelas(const double* tmax, const double* tmin, size_t n,
+                                          const std::vector<Fase>& fases);
+
+// Tabelas em precisão `Real` (float ou double); a soma é feita em double e, em
+// float, cada prefixo é guardado relativo ao seu bloco (erro limitado pelo bloco)
+template <typename Real>
+std::vector<TabelaFaseT<Real>> construir_tabelas_em(const std::vector<Dia>& dias,
+                                                   const std::vector<Fase>& fases);
+
+} // namespace model::viab
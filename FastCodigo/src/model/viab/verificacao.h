@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "analise_viabilidade.h"
+#include "dia.h"
+#include "fase.h"
+
+namespace model::viab {
+
+// Resultado de um dia inicial pelo caminho de referência (avaliar_sequencia caminho a caminho)
+struct ReferenciaDia {
+    ResultadoData resultado;
+    bool exata = false;               // todos os caminhos enumerados (senão, amostragem)
+    long long avaliados = 0;          // caminhos enumerados ou amostras
+    double desvio_rendimento = 0.0;   // desvio padrão do rendimento entre os caminhos viáveis
+};
+
+/**
+ * @brief Referência lenta e direta de um dia inicial
+ *
+ * Avalia cada caminho com avaliar_sequencia (dia a dia com avaliar_dia,
+ * rendimento max(0, 1 - (pd + pn))), sem tabelas, pré-filtro nem poda.
+ * Cada caminho pesa o produto das probabilidades das durações (uniformes ou
+ * os `pesos` das fases). Enumera tudo quando há até `limite_exato` caminhos;
+ * acima disso sorteia `amostras` caminhos com mt19937_64(semente).
+ */
+ReferenciaDia referencia_dia(const std::vector<Dia>& dias, const std::vector<Fase>& fases, int inicio,
+                             long long limite_exato, long long amostras, std::uint64_t semente);
+
+// Um campo de ResultadoData: produção × referência
+struct ComparacaoCampo {
+    std::string campo;
+    double producao = 0.0;
+    double referencia = 0.0;
+    double erro_padrao = 0.0;   // combinado das duas estimativas (0 = comparação exata)
+    bool concorda = true;
+};
+
+struct VerificacaoDia {
+    int dia = 0;
+    std::string data_str;
+    bool exata = false;         // referência exata (ver ReferenciaDia)
+    long long avaliados = 0;
+    std::vector<ComparacaoCampo> campos;
+};
+
+struct ConfiguracaoVerificacao {
+    int dias = 0;                      // K dias iniciais sorteados
+    std::uint64_t semente = 0;         // sorteio dos dias e das amostras da referência
+    long long limite_exato = 1000000;  // caminhos até os quais a referência enumera tudo
+    long long amostras = 100000;       // amostras da referência acima do limite
+    bool producao_amostrada = false;   // produção estimada por amostragem
+    long long amostras_producao = 0;   // amostras por dia da produção (se amostrada)
+    double tolerancia = 1e-9;          // diferença absoluta aceita sem erro amostral
+    double z_limite = 4.0;             // |diferença| / erro padrão aceito com erro amostral
+};
+
+/**
+ * @brief Reavalia K dias iniciais sorteados pela referência e compara campo a campo
+ *
+ * Metade dos dias vem dos que a produção considera viáveis (se houver), o
+ * resto de todos os dias com ciclo completo. Sem erro amostral dos dois
+ * lados, cada campo deve coincidir até `tolerancia` (e caminhos_viaveis,
+ * exatamente); com amostragem de algum lado, a diferença é aceita até
+ * `z_limite` erros padrão (binomial nas probabilidades, com a mesma variância
+ * nos dois lados, desvio do rendimento da referência na média), em vez de
+ * exigir igualdade.
+ *
+ * @throws std::invalid_argument se `producao` não tiver um resultado por dia
+ */
+std::vector<VerificacaoDia> verificar_resultados(const std::vector<Dia>& dias, const std::vector<Fase>& fases,
+                                                 const std::vector<ResultadoData>& producao,
+                                                 const ConfiguracaoVerificacao& configuracao);
+
+// Campos discordantes em todos os dias verificados
+int contar_discordancias(const std::vector<VerificacaoDia>& verificacao);
+
+} // namespace model::viab
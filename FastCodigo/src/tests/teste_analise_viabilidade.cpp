@@ -1,10 +1,49 @@
 #include "../model/viab/analise_viabilidade.h"
 #include "../model/io/csv_reader.h"
 #include "../model/summary/summary_generator.h"
+#include "../model/summary/agregacao.h"
+#include "../model/io/json_loader.h"
+#include "../model/io/csv_horario_reader.h"
+#include "../model/viab/kernel_especializado.h"
+#include "../model/viab/analise_gdd.h"
+#include "../model/viab/busca_melhores.h"
+#include "../model/viab/amostragem.h"
+#include "../model/viab/ensemble_imputacao.h"
+#include "../model/viab/particao.h"
+#include "../model/viab/precisao.h"
+#include "../model/io/parcial_io.h"
+#include "../model/io/checkpoint.h"
+#include "../model/io/grade_io.h"
+#include "../model/io/estado_incremental.h"
+#include "../model/io/climatologia_io.h"
+#include "../model/viab/incremental.h"
+#include "../model/viab/duracao_ponderada.h"
+#include "../model/viab/amostragem_condicional.h"
+#include "../model/viab/rotacao.h"
+#include "../model/viab/pool_trabalho.h"
+#include "../model/viab/verificacao.h"
+#include "../model/viab/calibracao.h"
+#include "../model/io/estatisticas_io.h"
+#include "../model/viab/motor_tabelas.h"
+#include "../model/viab/tabela_fases.h"
+#include "../model/summary/calendario.h"
+#include "../model/summary/graficos.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include "../cli/opcoes.h"
+#include "../capi/riceguard.h"
 #include <gtest/gtest.h>
 #include <sstream>
 #include <cmath>
 #include <random>
+#include <fstream>
+#include <filesystem>
+#include <cstdio>
 
 using namespace model;
 
@@ -247,7 +286,7 @@ TEST(RiscosTest, EsbranquiamentoDeteccao) {
 // Teste de geração de relatório detalhado
 TEST(SummaryTest, GeracaoRelatorioDetalhado) {
     viab::ResultadoData resultado{
-        "2024-01-01", 0.8, 0.9, 0.1, 0.05, 0.7, 100, 80
+        "2024-01-01", 0.8, 0.9, 0.1, 0.05, 0.7, viab::caminhos_exatos(100), 80
     };
     std::string csv = summary::gerar_csv_detalhado({resultado});
     EXPECT_FALSE(csv.empty());
@@ -257,8 +296,8 @@ TEST(SummaryTest, GeracaoRelatorioDetalhado) {
 // Teste de geração de relatório mensal
 TEST(SummaryTest, GeracaoRelatorioMensal) {
     std::vector<viab::ResultadoData> resultados = {
-        {"2024-01-01", 0.8, 0.9, 0.1, 0.05, 0.7, 100, 80},
-        {"2024-01-02", 0.7, 0.85, 0.15, 0.1, 0.6, 100, 70}
+        {"2024-01-01", 0.8, 0.9, 0.1, 0.05, 0.7, viab::caminhos_exatos(100), 80},
+        {"2024-01-02", 0.7, 0.85, 0.15, 0.1, 0.6, viab::caminhos_exatos(100), 70}
     };
     std::vector<viab::Dia> dias = {
         {"2024-01-01", 1, 25.0, 20.0},
@@ -454,6 +493,1942 @@ TEST(CompatibilidadeTest, CondicoesClimaticasBrasileiras) {
                    100.0 * dias_viaveis / resultados.size());
 }
 
+// Catálogo pequeno para comparar o kernel especializado com o caminho genérico
+struct CatalogoTeste {
+    static constexpr std::size_t num_fases = 3;
+    static constexpr viab::FaseFixa fases[num_fases] = {
+        {"Inicial",   15, 34, 22, 28, 2, 4, false},
+        {"Meio",      18, 33, 23, 29, 3, 6, false},
+        {"Maturação", 15, 32, 20, 26, 2, 5, true},
+    };
+};
+
+// Kernel especializado deve reproduzir o modo exaustivo do caminho genérico
+TEST(KernelEspecializadoTest, EquivalenteAoGenerico) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist_max(24.0, 35.0);
+    std::uniform_real_distribution<double> dist_delta(3.0, 9.0);
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < 40; ++i) {
+        double tmax = dist_max(rng);
+        dias.push_back({"Dia " + std::to_string(i), 1, tmax, tmax - dist_delta(rng)});
+    }
+
+    auto generico = viab::rodar_analise(dias, viab::fases_do_catalogo<CatalogoTeste>());
+    auto especializado = viab::rodar_analise_fixa<CatalogoTeste>(dias);
+
+    // Tabelas com limites constantes idênticas às construídas por avaliar_dia
+    auto fixas = viab::kernel::construir_tabelas_fixas<CatalogoTeste>(dias);
+    auto dinamicas = viab::construir_tabelas(dias, viab::fases_do_catalogo<CatalogoTeste>());
+    ASSERT_EQ(fixas.size(), dinamicas.size());
+    for (size_t f = 0; f < fixas.size(); ++f) {
+        EXPECT_EQ(fixas[f].inviaveis, dinamicas[f].inviaveis);
+        EXPECT_EQ(fixas[f].nao_ideais, dinamicas[f].nao_ideais);
+        ASSERT_EQ(fixas[f].penalidade.size(), dinamicas[f].penalidade.size());
+        for (size_t d = 0; d < fixas[f].penalidade.size(); ++d)   // -ffast-math pode contrair de outro modo
+            EXPECT_NEAR(fixas[f].penalidade[d], dinamicas[f].penalidade[d], 1e-12);
+        EXPECT_EQ(fixas[f].esbranq, dinamicas[f].esbranq);
+        EXPECT_EQ(fixas[f].reducao, dinamicas[f].reducao);
+        EXPECT_EQ(fixas[f].proximo_inviavel, dinamicas[f].proximo_inviavel);
+    }
+
+    ASSERT_EQ(generico.size(), especializado.size());
+    for (size_t i = 0; i < dias.size(); ++i) {
+        EXPECT_EQ(generico[i].data_str, especializado[i].data_str);
+        EXPECT_EQ(generico[i].total_caminhos.texto(), especializado[i].total_caminhos.texto());
+        EXPECT_EQ(generico[i].caminhos_viaveis, especializado[i].caminhos_viaveis);
+        EXPECT_NEAR(generico[i].prob_viabilidade, especializado[i].prob_viabilidade, 1e-12);
+        EXPECT_NEAR(generico[i].rendimento_medio, especializado[i].rendimento_medio, 1e-9);
+        EXPECT_NEAR(generico[i].prob_optimo, especializado[i].prob_optimo, 1e-12);
+        EXPECT_NEAR(generico[i].prob_esbranquiamento, especializado[i].prob_esbranquiamento, 1e-12);
+        EXPECT_NEAR(generico[i].prob_reducao_moagem, especializado[i].prob_reducao_moagem, 1e-12);
+    }
+}
+
+#ifdef RICEGUARD_CATALOGOS_EMBUTIDOS
+// O catálogo embutido deve espelhar o JSON de configuração
+TEST(KernelEspecializadoTest, CatalogoPadraoIgualAoJson) {
+    auto json = io::carregar_fases(RICEGUARD_FASES_PADRAO);
+    auto embutido = viab::fases_cultivar("default");
+    ASSERT_EQ(json.size(), embutido.size());
+    for (size_t i = 0; i < json.size(); ++i) {
+        EXPECT_EQ(json[i].nome, embutido[i].nome);
+        EXPECT_EQ(json[i].minT, embutido[i].minT);
+        EXPECT_EQ(json[i].maxT, embutido[i].maxT);
+        EXPECT_EQ(json[i].optMinT, embutido[i].optMinT);
+        EXPECT_EQ(json[i].optMaxT, embutido[i].optMaxT);
+        EXPECT_EQ(json[i].durMin, embutido[i].durMin);
+        EXPECT_EQ(json[i].durMax, embutido[i].durMax);
+        EXPECT_EQ(viab::catalogo::ArrozPadrao::fases[i].maturacao, json[i].nome == "Maturação");
+    }
+}
+#endif
+
+TEST(KernelEspecializadoTest, CultivarDesconhecida) {
+    EXPECT_FALSE(viab::cultivar_embutida("inexistente"));
+    EXPECT_THROW(viab::fases_cultivar("inexistente"), std::invalid_argument);
+}
+
+// Testes da interpretação de argumentos
+TEST(OpcoesTest, PosicionaisEOpcoes) {
+    auto op = cli::interpretar_argumentos({"dados.csv", "saida", "--cultivar", "default", "--fases=f.json"});
+    EXPECT_EQ(op.caminho_entrada, "dados.csv");
+    EXPECT_EQ(op.pasta_saida, "saida");
+    EXPECT_EQ(op.cultivar, "default");
+    EXPECT_EQ(op.caminho_fases, "f.json");
+}
+
+TEST(OpcoesTest, ArgumentosInvalidos) {
+    EXPECT_THROW(cli::interpretar_argumentos({"dados.csv"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"dados.csv", "saida", "--desconhecida", "x"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"dados.csv", "saida", "--cultivar"}), std::invalid_argument);
+}
+
+// Testes do modo horário (graus-hora)
+TEST(HorarioTest, LeituraCsvBruto) {
+    const std::string caminho = "teste_horario_bruto.csv";
+    {
+        std::ofstream f(caminho);
+        f << "\xEF\xBB\xBF\"Data\";\"Hora (UTC)\";\"Temp. [Hora] (C)\";\"Temp. Max. [Diaria] (h)\";\"Temp. Min. [Diaria] (h)\"\n"
+          << "\"01/03/2023\";\"0000\";\"28,6\";\"34,1\";\"\"\n"
+          << "\"01/03/2023\";\"1200\";\"\";\"\";\"22,5\"\n"
+          << "\"02/03/2023\";\"1800\";\"33,4\";\"\";\"\"\n";
+    }
+    auto registros = io::ler_dados_horarios(caminho);
+    std::remove(caminho.c_str());
+
+    ASSERT_EQ(registros.size(), 2);
+    EXPECT_EQ(registros[0].data_str, "01/03/2023");
+    EXPECT_EQ(registros[0].mes, 3);
+    ASSERT_EQ(registros[0].leituras.size(), 1);   // leitura vazia das 12h é falha
+    EXPECT_EQ(registros[0].leituras[0].first, 0);
+    EXPECT_DOUBLE_EQ(registros[0].leituras[0].second, 28.6);
+    EXPECT_DOUBLE_EQ(*registros[0].tmax_diaria, 34.1);
+    EXPECT_DOUBLE_EQ(*registros[0].tmin_diaria, 22.5);
+    EXPECT_FALSE(registros[1].tmax_diaria.has_value());
+    EXPECT_EQ(registros[1].leituras[0].first, 18);
+}
+
+// Dia ausente no arquivo não desloca as horas dos dias seguintes
+TEST(HorarioTest, DiaAusenteMantemIndiceHorario) {
+    const std::string caminho = "teste_horario_lacuna.csv";
+    {
+        std::ofstream f(caminho);
+        f << "\"Data\";\"Hora (UTC)\";\"Temp. [Hora] (C)\"\n"
+          << "\"28/02/2023\";\"0000\";\"20,0\"\n"
+          << "\"02/03/2023\";\"0000\";\"30,0\"\n";
+    }
+    auto registros = io::ler_dados_horarios(caminho);
+    ASSERT_EQ(registros.size(), 3u);
+    EXPECT_TRUE(registros[1].ausente);
+    EXPECT_EQ(registros[1].data_str, "01/03/2023");
+    EXPECT_EQ(registros[1].mes, 3);
+    EXPECT_FALSE(registros[2].ausente);
+    auto serie = viab::montar_serie_horaria(registros);
+    ASSERT_EQ(serie.temperaturas.size(), 72u);
+    EXPECT_DOUBLE_EQ(serie.temperaturas[48], 30.0);   // 0h de 02/03
+    EXPECT_DOUBLE_EQ(serie.temperaturas[24], 25.0);   // interpolado no dia ausente
+
+    {
+        std::ofstream f(caminho);
+        f << "\"Data\";\"Hora (UTC)\";\"Temp. [Hora] (C)\"\n"
+          << "\"02/03/2023\";\"0000\";\"30,0\"\n"
+          << "\"01/03/2023\";\"0000\";\"20,0\"\n";
+    }
+    EXPECT_THROW(io::ler_dados_horarios(caminho), std::runtime_error);
+    std::remove(caminho.c_str());
+}
+
+TEST(HorarioTest, SerieInterpoladaAncoraExtremos) {
+    viab::RegistroHorario r;
+    r.data_str = "01/01/2023";
+    r.mes = 1;
+    r.leituras = {{0, 24.0}, {12, 26.0}, {18, 30.0}};
+    r.tmax_diaria = 32.0;
+    r.tmin_diaria = 20.0;
+    auto serie = viab::montar_serie_horaria({r});
+
+    ASSERT_EQ(serie.temperaturas.size(), 24);
+    EXPECT_DOUBLE_EQ(serie.temperaturas[0], 24.0);
+    EXPECT_DOUBLE_EQ(serie.temperaturas[9], 20.0);    // mínima ancorada às 9 UTC
+    EXPECT_DOUBLE_EQ(serie.temperaturas[17], 32.0);   // máxima ancorada às 17 UTC
+    EXPECT_DOUBLE_EQ(serie.temperaturas[15], 26.0 + (32.0 - 26.0) * 3.0 / 5.0);
+    EXPECT_DOUBLE_EQ(serie.temperaturas[23], 30.0);   // após a última âncora
+    EXPECT_DOUBLE_EQ(serie.dias[0].tmax, 32.0);
+    EXPECT_DOUBLE_EQ(serie.dias[0].tmin, 20.0);
+}
+
+TEST(HorarioTest, GrausHoraPorJanela) {
+    viab::SerieHoraria serie;
+    serie.dias = {{"d1", 1, 36.0, 36.0}, {"d2", 1, 30.0, 30.0}};
+    serie.temperaturas.assign(48, 30.0);
+    for (int h = 0; h < 4; ++h) serie.temperaturas[h] = 36.0;   // 4 horas a 36 °C no dia 1
+    std::vector<viab::Fase> fases = {viab::Fase("F", 20, 35, 25, 30, 1, 2)};
+    auto tab = viab::construir_tabelas_graus_hora(serie, fases);
+
+    EXPECT_DOUBLE_EQ(tab[0].calor[1] - tab[0].calor[0], 4.0);
+    EXPECT_DOUBLE_EQ(tab[0].calor[2] - tab[0].calor[1], 0.0);
+    EXPECT_DOUBLE_EQ(tab[0].frio[2], 0.0);
+}
+
+// Sem tolerância, a viabilidade horária coincide com a diária sobre os mesmos extremos
+TEST(HorarioTest, ToleranciaZeroEquivaleAoDiario) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(19.0, 34.0);
+    std::vector<viab::RegistroHorario> registros;
+    for (int i = 0; i < 30; ++i) {
+        viab::RegistroHorario r;
+        r.data_str = "Dia " + std::to_string(i);
+        r.mes = 1;
+        r.leituras = {{0, dist(rng)}, {12, dist(rng)}, {18, dist(rng)}};
+        registros.push_back(r);
+    }
+    auto serie = viab::montar_serie_horaria(registros);
+    std::vector<viab::Fase> fases = {
+        viab::Fase("F1", 18, 33, 22, 28, 2, 4),
+        viab::Fase("Maturação", 19, 32, 21, 27, 2, 5)
+    };
+    for (auto& f : fases) f.toleranciaGH = 0.0;
+
+    auto horario = viab::rodar_analise_horaria(serie, fases);
+    auto diario = viab::rodar_analise(serie.dias, fases);
+    ASSERT_EQ(horario.size(), diario.size());
+    for (size_t i = 0; i < diario.size(); ++i) {
+        EXPECT_EQ(horario[i].base.caminhos_viaveis, diario[i].caminhos_viaveis);
+        EXPECT_NEAR(horario[i].base.rendimento_medio, diario[i].rendimento_medio, 1e-9);
+        EXPECT_NEAR(horario[i].base.prob_esbranquiamento, diario[i].prob_esbranquiamento, 1e-12);
+        EXPECT_NEAR(horario[i].gh_calor[0], 0.0, 1e-9);
+    }
+}
+
+// Tolerância de graus-hora admite excursões curtas acima de maxT
+TEST(HorarioTest, ToleranciaAdmiteExcursaoCurta) {
+    viab::SerieHoraria serie;
+    serie.dias = {{"d1", 1, 36.0, 24.0}, {"d2", 1, 30.0, 24.0}};
+    serie.temperaturas.assign(48, 26.0);
+    serie.temperaturas[17] = 36.0;   // uma hora, 1 grau-hora acima de 35
+    std::vector<viab::Fase> fases = {viab::Fase("F", 20, 35, 25, 30, 2, 2)};
+
+    fases[0].toleranciaGH = 0.5;
+    EXPECT_EQ(viab::rodar_analise_horaria(serie, fases)[0].base.caminhos_viaveis, 0);
+    fases[0].toleranciaGH = 1.0;
+    auto r = viab::rodar_analise_horaria(serie, fases);
+    EXPECT_EQ(r[0].base.caminhos_viaveis, 1);
+    EXPECT_DOUBLE_EQ(r[0].gh_calor[0], 1.0);
+}
+
+// Testes do modo por graus-dia (GDD)
+TEST(GddTest, GrausDiaComBase) {
+    EXPECT_DOUBLE_EQ(viab::graus_dia({"d", 1, 30.0, 20.0}, 10.0), 15.0);
+    EXPECT_DOUBLE_EQ(viab::graus_dia({"d", 1, 12.0, 6.0}, 10.0), 0.0);
+}
+
+TEST(GddTest, FaixaDeterministicaEBanda) {
+    std::vector<viab::Dia> dias(10, viab::Dia{"d", 1, 30.0, 20.0});   // 15 GDD/dia
+    auto acumulado = viab::acumular_graus_dia(dias, 10.0);
+    viab::Fase fase("F", 15, 35, 20, 30, 1, 1);
+    fase.gddAlvo = 45.0;
+
+    auto faixa = viab::faixa_graus_dia(acumulado, 0, fase);
+    EXPECT_EQ(faixa.first, 3);
+    EXPECT_EQ(faixa.second, 3);
+
+    fase.gddTolerancia = 15.0;
+    faixa = viab::faixa_graus_dia(acumulado, 2, fase);
+    EXPECT_EQ(faixa.first, 2);
+    EXPECT_EQ(faixa.second, 4);
+
+    // Alvo não atingido antes do fim da série: faixa vazia
+    fase.gddAlvo = 200.0;
+    faixa = viab::faixa_graus_dia(acumulado, 0, fase);
+    EXPECT_GT(faixa.first, faixa.second);
+}
+
+TEST(GddTest, CaminhoUnicoPorDiaInicial) {
+    std::vector<viab::Dia> dias(12, viab::Dia{"d", 1, 30.0, 20.0});
+    dias[7].tmax = 38.0;   // inviável para a segunda fase (maxT 35)
+    std::vector<viab::Fase> fases = {
+        viab::Fase("F1", 15, 39, 20, 30, 1, 1),
+        viab::Fase("F2", 15, 35, 20, 30, 1, 1)
+    };
+    fases[0].gddAlvo = 30.0;   // 2 dias
+    fases[1].gddAlvo = 45.0;   // 3 dias
+    auto r = viab::rodar_analise_gdd(dias, fases);
+
+    ASSERT_EQ(r.size(), dias.size());
+    EXPECT_EQ(r[0].total_caminhos.saturado(), 1);
+    EXPECT_EQ(r[0].caminhos_viaveis, 1);     // dias 0-4
+    EXPECT_EQ(r[4].caminhos_viaveis, 0);     // F2 cobre os dias 6-8
+    EXPECT_EQ(r[6].caminhos_viaveis, 1);     // F1 (tolerante) cobre o dia 7
+    EXPECT_EQ(r[8].caminhos_viaveis, 0);     // alvo não atingido antes do fim
+    EXPECT_EQ(r[8].total_caminhos.saturado(), 1);
+}
+
+TEST(GddTest, BandaComTolerancia) {
+    std::vector<viab::Dia> dias(20, viab::Dia{"d", 1, 30.0, 20.0});
+    std::vector<viab::Fase> fases = {
+        viab::Fase("F1", 15, 35, 20, 30, 1, 1),
+        viab::Fase("F2", 15, 35, 20, 30, 1, 1)
+    };
+    for (auto& f : fases) {
+        f.gddAlvo = 45.0;
+        f.gddTolerancia = 15.0;   // 2 a 4 dias
+    }
+    auto r = viab::rodar_analise_gdd(dias, fases);
+    EXPECT_EQ(r[0].total_caminhos.saturado(), 9);
+    EXPECT_EQ(r[0].caminhos_viaveis, 9);
+    EXPECT_DOUBLE_EQ(r[0].prob_viabilidade, 1.0);
+}
+
+// Durações fixas que passam do fim da série contam como inviáveis, como no caminho genérico
+TEST(GddTest, FaseSemGddCortadaPeloFimContaComoInviavel) {
+    std::vector<viab::Dia> dias(12, viab::Dia{"d", 1, 30.0, 20.0});   // 15 GDD/dia
+    std::vector<viab::Fase> fases = {viab::Fase("F1", 15, 39, 20, 30, 1, 1),
+                                     viab::Fase("F2", 15, 39, 20, 30, 2, 5)};
+    fases[0].gddAlvo = 30.0;   // 2 dias
+    auto r = viab::rodar_analise_gdd(dias, fases);
+    const std::vector<viab::Fase> fixas = {viab::Fase("F1", 15, 39, 20, 30, 2, 2), fases[1]};
+    for (size_t d = 0; d + 4 <= dias.size(); ++d) {
+        auto generico = viab::rodar_analise({dias.begin() + d, dias.end()}, fixas);
+        EXPECT_EQ(r[d].total_caminhos.saturado(), 4) << "dia " << d;
+        EXPECT_EQ(r[d].caminhos_viaveis, generico[0].caminhos_viaveis) << "dia " << d;
+        EXPECT_DOUBLE_EQ(r[d].prob_viabilidade, generico[0].prob_viabilidade) << "dia " << d;
+    }
+    EXPECT_EQ(r[8].caminhos_viaveis, 1);   // só F2 = 2 dias cabe
+    EXPECT_EQ(r[11].total_caminhos.saturado(), 4);   // alvo de F1 não atingido: 4 durações de F2
+}
+
+TEST(GddTest, SemAlvoLancaExcecao) {
+    std::vector<viab::Dia> dias(5, viab::Dia{"d", 1, 30.0, 20.0});
+    std::vector<viab::Fase> fases = {viab::Fase("F1", 15, 35, 20, 30, 1, 2)};
+    EXPECT_THROW(viab::rodar_analise_gdd(dias, fases), std::invalid_argument);
+}
+
+// Testes de calendário e agregação agrupada
+TEST(CalendarioTest, SemanaIsoEDecendio) {
+    int ano_iso;
+    EXPECT_EQ(summary::semana_iso({2023, 1, 1}, ano_iso), 52);   // domingo
+    EXPECT_EQ(ano_iso, 2022);
+    EXPECT_EQ(summary::semana_iso({2023, 1, 2}, ano_iso), 1);
+    EXPECT_EQ(ano_iso, 2023);
+    EXPECT_EQ(summary::semana_iso({2020, 12, 31}, ano_iso), 53);
+    EXPECT_EQ(summary::semana_iso({2024, 12, 30}, ano_iso), 1);
+    EXPECT_EQ(ano_iso, 2025);
+
+    EXPECT_EQ(summary::decendio({2023, 1, 10}), 1);
+    EXPECT_EQ(summary::decendio({2023, 2, 11}), 5);
+    EXPECT_EQ(summary::decendio({2023, 12, 31}), 36);
+
+    auto d = summary::interpretar_data("29/02/2024");
+    ASSERT_TRUE(d.has_value());
+    EXPECT_EQ(d->mes, 2);
+    EXPECT_FALSE(summary::interpretar_data("29/02/2023").has_value());
+    EXPECT_TRUE(summary::interpretar_data("2024-01-01").has_value());
+}
+
+TEST(AgregacaoTest, CombinacaoIgualASequencial) {
+    summary::Estatistica seq, a, b;
+    std::vector<double> v = {0.1, 0.5, 0.9, 0.3, 0.7, 0.2};
+    for (size_t i = 0; i < v.size(); ++i) {
+        seq.adicionar(v[i]);
+        (i < 2 ? a : b).adicionar(v[i]);
+    }
+    a.combinar(b);
+    EXPECT_EQ(a.n, seq.n);
+    EXPECT_NEAR(a.media, seq.media, 1e-12);
+    EXPECT_NEAR(a.variancia(), seq.variancia(), 1e-12);
+    EXPECT_DOUBLE_EQ(a.min, 0.1);
+    EXPECT_DOUBLE_EQ(a.max, 0.9);
+}
+
+TEST(AgregacaoTest, MesAnoSeparaAnos) {
+    std::vector<viab::ResultadoData> r = {
+        {"15/01/2023", 0.2, 0.5, 0, 0, 0, 1, 1},
+        {"16/01/2023", 0.4, 0.7, 0, 0, 0, 1, 1},
+        {"15/01/2024", 0.9, 0.1, 0, 0, 0, 1, 1},
+        {"", 0, 0, 0, 0, 0, 0, 0}          // dia não avaliado
+    };
+    auto colunas = summary::extrair_colunas(r);
+    EXPECT_EQ(colunas.datas.size(), 3);
+    auto grupos = summary::agrupar(colunas, {summary::Agrupamento::MesAno}, {});
+
+    ASSERT_EQ(grupos.size(), 1);
+    ASSERT_EQ(grupos[0].chaves.size(), 2);
+    EXPECT_EQ(grupos[0].chaves[0][0], 2023);
+    EXPECT_EQ(grupos[0].chaves[0][1], 1);
+    EXPECT_EQ(grupos[0].acumuladores[0][0].n, 2);
+    EXPECT_NEAR(grupos[0].acumuladores[0][0].media, 0.3, 1e-12);
+    EXPECT_NEAR(grupos[0].acumuladores[0][1].max, 0.7, 1e-12);
+    EXPECT_EQ(grupos[0].chaves[1][0], 2024);
+    EXPECT_NEAR(grupos[0].acumuladores[1][0].media, 0.9, 1e-12);
+}
+
+TEST(AgregacaoTest, JanelaAtravessaOAno) {
+    std::vector<viab::ResultadoData> r = {
+        {"20/12/2023", 1.0, 0, 0, 0, 0, 1, 1},
+        {"10/01/2024", 0.0, 0, 0, 0, 0, 1, 1},
+        {"10/03/2024", 0.5, 0, 0, 0, 0, 1, 1}   // fora da janela
+    };
+    auto janelas = summary::interpretar_janelas("safra:01/12-31/01");
+    auto grupos = summary::agrupar(summary::extrair_colunas(r),
+                                   {summary::Agrupamento::JanelaSemeadura,
+                                    summary::Agrupamento::SemanaIso,
+                                    summary::Agrupamento::Decendio}, janelas);
+
+    ASSERT_EQ(grupos[0].chaves.size(), 1);
+    EXPECT_EQ(grupos[0].chaves[0][1], 2023);   // safra = ano do início
+    EXPECT_EQ(grupos[0].acumuladores[0][0].n, 2);
+    EXPECT_NEAR(grupos[0].acumuladores[0][0].media, 0.5, 1e-12);
+    EXPECT_EQ(grupos[1].chaves.size(), 3);
+    EXPECT_EQ(grupos[2].chaves.size(), 3);
+
+    std::string csv = summary::gerar_csv_agrupamento(grupos[0], janelas);
+    EXPECT_NE(csv.find("safra,2023,2"), std::string::npos);
+}
+
+TEST(AgregacaoTest, EspecificacoesInvalidas) {
+    EXPECT_THROW(summary::interpretar_agrupamentos("semana,ano"), std::invalid_argument);
+    EXPECT_THROW(summary::interpretar_janelas("safra:01/13-31/01"), std::invalid_argument);
+    EXPECT_THROW(summary::interpretar_janelas("01/12-31/01"), std::invalid_argument);
+}
+
+// Testes da ABI C (libriceguard)
+TEST(CApiTest, ColunasIguaisAoCaminhoGenerico) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist_max(24.0, 34.0);
+    const int n = 25;
+    std::vector<double> tmax(n), tmin(n);
+    std::vector<int32_t> datas(n);
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < n; ++i) {
+        tmax[i] = dist_max(rng);
+        tmin[i] = tmax[i] - 6.0;
+        datas[i] = 20230120 + i - (i >= 12 ? 31 - 100 : 0);   // 20/01 .. 31/01, 01/02 ..
+        char texto[16];
+        std::snprintf(texto, sizeof(texto), "%02d/%02d/2023", datas[i] % 100, datas[i] / 100 % 100);
+        dias.push_back({texto, datas[i] / 100 % 100, tmax[i], tmin[i]});
+    }
+    rg_fase fases[2] = {{"F1", 18, 33, 22, 28, 2, 4}, {"Maturação", 17, 32, 20, 26, 3, 5}};
+    std::vector<double> viab(n), rend(n), esb(n);
+    std::vector<int64_t> viaveis(n);
+    rg_resultados saida{viab.data(), rend.data(), esb.data(), nullptr, nullptr, nullptr, viaveis.data()};
+    auto graficos = std::make_unique<rg_graficos>();
+
+    ASSERT_EQ(rg_analisar(tmax.data(), tmin.data(), n, fases, 2, 0, &saida, datas.data(), graficos.get()), RG_OK)
+        << rg_ultimo_erro();
+    auto esperado = viab::rodar_analise(dias, {viab::Fase("F1", 18, 33, 22, 28, 2, 4),
+                                               viab::Fase("Maturação", 17, 32, 20, 26, 3, 5)});
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(viaveis[i], esperado[i].caminhos_viaveis);
+        EXPECT_NEAR(viab[i], esperado[i].prob_viabilidade, 1e-12);
+        EXPECT_NEAR(rend[i], esperado[i].rendimento_medio, 1e-9);
+        EXPECT_NEAR(esb[i], esperado[i].prob_esbranquiamento, 1e-12);
+    }
+
+    // Séries dos gráficos iguais às dos CSVs grafico_*.csv
+    const auto series = summary::gerar_series_grafico(esperado);
+    ASSERT_EQ(graficos->num_pontos, static_cast<int32_t>(series.evolucao.size()));
+    EXPECT_EQ(graficos->evolucao[0].data, 20230120);
+    for (int32_t i = 0; i < graficos->num_pontos; ++i)
+        for (int k = 0; k < 2; ++k) EXPECT_NEAR(graficos->evolucao[i].media[k], series.evolucao[i].media[k], 1e-9);
+    for (int mes = 0; mes < 12; ++mes) {
+        EXPECT_EQ(graficos->mensal[mes].dias, series.mensal[mes][0].n);
+        for (int k = 0; k < RG_NUM_METRICAS; ++k)
+            EXPECT_NEAR(graficos->mensal[mes].superior[k], summary::faixa_mensal(series.mensal[mes][k]).superior, 1e-9);
+    }
+    EXPECT_GT(graficos->mensal[0].dias, 0);
+    EXPECT_GT(graficos->mensal[1].dias, 0);
+}
+
+TEST(CApiTest, PreFiltroComoOMotorDeTabelas) {
+    // Amostragem (10^9 combinações) e dias 0-2 sem caminho viável: o pré-filtro evita as amostras
+    const int n = 8;
+    std::vector<double> tmax = {40, 40, 40, 27, 27, 27, 27, 27}, tmin(n);
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < n; ++i) {
+        tmin[i] = tmax[i] - 5.0;
+        dias.push_back({"d", 1, tmax[i], tmin[i]});
+    }
+    rg_fase fases[3] = {{"F1", 15, 30, 20, 28, 1, 1000}, {"F2", 15, 30, 20, 28, 1, 1000},
+                        {"F3", 15, 30, 20, 28, 1, 1000}};
+    std::vector<viab::Fase> vfases;
+    for (auto& f : fases) vfases.emplace_back(f.nome, f.min_t, f.max_t, f.opt_min_t, f.opt_max_t, f.dur_min, f.dur_max);
+    ASSERT_TRUE(viab::planejar_analise(vfases).usar_amostragem);
+    std::vector<double> viab(n);
+    std::vector<int64_t> total(n), viaveis(n);
+    rg_resultados saida{viab.data(), nullptr, nullptr, nullptr, nullptr, total.data(), viaveis.data()};
+
+    ASSERT_EQ(rg_analisar(tmax.data(), tmin.data(), n, fases, 3, 5, &saida, nullptr, nullptr), RG_OK)
+        << rg_ultimo_erro();
+    size_t descartados = 0;
+    auto esperado = viab::rodar_analise_tabelas(dias, vfases, viab::Precisao::Dupla, 5, &descartados);
+    EXPECT_EQ(descartados, 3u);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(total[i], esperado[i].total_caminhos.saturado());
+        EXPECT_EQ(viaveis[i], esperado[i].caminhos_viaveis);
+        EXPECT_NEAR(viab[i], esperado[i].prob_viabilidade, 1e-12);
+    }
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(viaveis[i], 0);
+}
+
+TEST(CApiTest, ErrosDeArgumentoEDatas) {
+    double t[2] = {30, 30};
+    int32_t datas[2] = {20230101, 20230103};   // lacuna
+    rg_fase fase = {"F", 10, 35, 20, 30, 1, 1};
+    rg_resultados saida{};
+    auto graficos = std::make_unique<rg_graficos>();
+    EXPECT_EQ(rg_versao_abi(), RG_ABI_VERSAO);
+    EXPECT_EQ(rg_analisar(t, t, 2, &fase, 1, 0, &saida, datas, graficos.get()), RG_ERRO_DATAS);
+    EXPECT_STRNE(rg_ultimo_erro(), "");
+    EXPECT_EQ(rg_analisar(t, t, 2, &fase, 1, 0, &saida, nullptr, graficos.get()), RG_ERRO_ARGUMENTO);
+    EXPECT_EQ(rg_analisar(t, t, 2, &fase, 0, 0, &saida, nullptr, nullptr), RG_ERRO_ARGUMENTO);
+    EXPECT_EQ(rg_analisar(t, t, int64_t(INT_MAX) + 1, &fase, 1, 0, &saida, nullptr, nullptr), RG_ERRO_ARGUMENTO);
+    rg_fase negativa = {"F", 10, 35, 20, 30, -1, 1};
+    EXPECT_EQ(rg_analisar(t, t, 2, &negativa, 1, 0, &saida, nullptr, nullptr), RG_ERRO_ARGUMENTO);
+    EXPECT_STREQ(rg_ultimo_erro(), "DurMin negativa em fase 0");
+    EXPECT_EQ(rg_analisar(t, t, 2, &fase, 1, 0, &saida, nullptr, nullptr), RG_OK);
+}
+
+// Testes da consulta das melhores janelas (branch-and-bound)
+namespace {
+// Série de 80 dias a partir de 20/11/2022, atravessando a virada do ano
+std::vector<viab::Dia> serie_dois_anos(std::vector<int>& anos) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist_max(24.0, 35.0);
+    std::uniform_real_distribution<double> dist_delta(3.0, 9.0);
+    std::vector<viab::Dia> dias;
+    summary::Data d{2022, 11, 20};
+    for (int i = 0; i < 80; ++i) {
+        char texto[40];
+        std::snprintf(texto, sizeof(texto), "%02d/%02d/%04d", d.dia, d.mes, d.ano);
+        double tmax = dist_max(rng);
+        dias.push_back({texto, d.mes, tmax, tmax - dist_delta(rng)});
+        anos.push_back(d.ano);
+        if (++d.dia > summary::dias_no_mes(d.ano, d.mes)) {
+            d.dia = 1;
+            if (++d.mes > 12) { d.mes = 1; ++d.ano; }
+        }
+    }
+    return dias;
+}
+} // namespace
+
+TEST(MelhoresJanelasTest, LimitesDiaSaoExatosOuSuperiores) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto tabelas = viab::construir_tabelas(dias, fases);
+    auto generico = viab::rodar_analise(dias, fases);
+    for (size_t d = 0; d < dias.size(); ++d) {
+        if (generico[d].data_str.empty()) continue;
+        auto limites = viab::limites_dia(tabelas, fases, static_cast<int>(dias.size()), d);
+        EXPECT_NEAR(limites.viabilidade, generico[d].prob_viabilidade, 1e-12);
+        EXPECT_GE(limites.limite_rendimento + 1e-12,
+                  generico[d].prob_viabilidade * generico[d].rendimento_medio);
+        EXPECT_LE(limites.limite_rendimento, limites.viabilidade + 1e-12);
+    }
+}
+
+TEST(MelhoresJanelasTest, IgualAOrdenarAnaliseCompleta) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto generico = viab::rodar_analise(dias, fases);
+
+    for (int janela : {1, 5}) {
+        viab::ConsultaMelhores consulta;
+        consulta.k = 3;
+        consulta.dias_janela = janela;
+        consulta.viabilidade_min = 0.05;
+        auto res = viab::buscar_melhores_janelas(dias, fases, consulta, anos);
+
+        // Referência: todas as janelas do mesmo ano, ordenadas pela média do rendimento esperado
+        std::map<int, std::vector<std::pair<double, int>>> esperado;
+        for (size_t s = 0; s + janela <= dias.size(); ++s) {
+            const size_t f = s + janela - 1;
+            if (generico[f].data_str.empty() || anos[s] != anos[f]) continue;
+            double valor = 0.0, viab_media = 0.0;
+            for (size_t d = s; d <= f; ++d) {
+                valor += generico[d].prob_viabilidade * generico[d].rendimento_medio;
+                viab_media += generico[d].prob_viabilidade;
+            }
+            if (viab_media / janela < consulta.viabilidade_min || viab_media == 0.0) continue;
+            esperado[anos[s]].push_back({valor / janela, static_cast<int>(s)});
+        }
+        size_t j = 0;
+        for (auto& [ano, lista] : esperado) {
+            std::stable_sort(lista.begin(), lista.end(),
+                             [](auto& a, auto& b) { return a.first > b.first; });
+            for (size_t r = 0; r < lista.size() && r < 3; ++r, ++j) {
+                ASSERT_LT(j, res.janelas.size());
+                EXPECT_EQ(res.janelas[j].grupo, ano);
+                EXPECT_NEAR(res.janelas[j].rendimento_esperado, lista[r].first, 1e-9);
+                EXPECT_GE(res.janelas[j].limite_superior, res.janelas[j].rendimento_esperado);
+            }
+        }
+        EXPECT_EQ(j, res.janelas.size());
+        EXPECT_FALSE(res.janelas.empty());
+        EXPECT_LT(res.dias_avaliados, res.dias_candidatos);   // a poda evitou dias
+    }
+}
+
+TEST(MelhoresJanelasTest, ConsultaInvalida) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    viab::ConsultaMelhores consulta;
+    consulta.k = 0;
+    EXPECT_THROW(viab::buscar_melhores_janelas(dias, fases, consulta), std::invalid_argument);
+    consulta.k = 1;
+    EXPECT_THROW(viab::buscar_melhores_janelas(dias, fases, consulta, {2023}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--melhores", "3", "--modo", "gdd"}),
+                 std::invalid_argument);
+    auto op = cli::interpretar_argumentos({"d.csv", "s", "--melhores=3", "--dias-janela", "7"});
+    EXPECT_EQ(op.melhores, 3);
+    EXPECT_EQ(op.dias_janela, 7);
+}
+
+// Testes do sorteio de durações e da contagem de caminhos
+TEST(AmostragemTest, ContagemEm128BitsELog) {
+    std::vector<viab::Fase> fases;
+    for (int i = 0; i < 20; ++i) fases.emplace_back("F" + std::to_string(i), 15, 30, 20, 28, 1, 30);
+    auto total = viab::contar_caminhos(fases);   // 30^20 ~ 3.5e29: cabe em 128 bits
+    EXPECT_FALSE(total.excede_128);
+    EXPECT_EQ(total.texto(), "348678440100000000000000000000");
+    EXPECT_NEAR(total.log10, 20 * std::log10(30.0), 1e-9);
+    EXPECT_EQ(total.saturado(), std::numeric_limits<long long>::max());
+    EXPECT_NEAR(static_cast<double>(viab::escalar_caminhos(1e-20, total)), 3.48678e9, 1e5);
+
+    for (int i = 0; i < 20; ++i) fases.emplace_back("G" + std::to_string(i), 15, 30, 20, 28, 1, 1000);
+    total = viab::contar_caminhos(fases);        // ~3.5e89
+    EXPECT_TRUE(total.excede_128);
+    EXPECT_EQ(total.texto(), "~1e89");
+    EXPECT_EQ(total.decimal(), "3.48678e+89");
+    EXPECT_EQ(viab::escalar_caminhos(1e-80, total), 3486784401LL);
+    EXPECT_EQ(viab::escalar_caminhos(0.5, total), std::numeric_limits<long long>::max());
+}
+
+TEST(AmostragemTest, SorteioUniformePorFase) {
+    std::vector<viab::Fase> fases = {viab::Fase("A", 15, 30, 20, 28, 3, 9),
+                                     viab::Fase("B", 15, 30, 20, 28, 1, 1000000)};
+    viab::SorteadorDuracoes sorteador(fases);
+    std::mt19937_64 gen(5);
+    std::vector<int> contagem(7, 0);
+    const int N = 700000;
+    long long soma_b = 0;
+    for (int s = 0; s < N; ++s) {
+        int a = sorteador.sortear(0, gen);
+        int b = sorteador.sortear(1, gen);
+        ASSERT_GE(a, 3);
+        ASSERT_LE(a, 9);
+        ASSERT_GE(b, 1);
+        ASSERT_LE(b, 1000000);
+        contagem[a - 3]++;
+        soma_b += b;
+    }
+    for (int c : contagem) EXPECT_NEAR(c, N / 7.0, 0.01 * N / 7.0);
+    // Antes, o índice saturado em LIMITE_COMBINACOES concentrava as fases iniciais em valores baixos
+    EXPECT_NEAR(static_cast<double>(soma_b) / N, 500000.5, 2000.0);
+}
+
+TEST(AmostragemTest, TotalDeCaminhosSemSaturacaoNoLimite) {
+    std::vector<viab::Dia> dias(3, viab::Dia{"2024-01-01", 1, 25.0, 20.0});   // um único dia inicial
+    std::vector<viab::Fase> fases;
+    for (int i = 0; i < 3; ++i) fases.emplace_back("F" + std::to_string(i), 15, 30, 20, 28, 1, 1000);
+    auto resultados = viab::rodar_analise(dias, fases);
+    EXPECT_EQ(resultados[0].total_caminhos.saturado(), 1000000000LL);   // antes: LIMITE_COMBINACOES
+    auto plano = viab::planejar_analise(fases);
+    EXPECT_TRUE(plano.usar_amostragem);
+    EXPECT_EQ(plano.total_combinacoes, 1000000000LL);
+
+    // Acima de 2^63 o CSV traz o total exato, não LLONG_MAX
+    for (int i = 3; i < 10; ++i) fases.emplace_back("F" + std::to_string(i), 15, 30, 20, 28, 1, 1000);
+    auto r = viab::finalizar_contagem(viab::ContagemDia{}, viab::planejar_analise(fases));
+    EXPECT_EQ(r.total_caminhos.texto(), "1" + std::string(30, '0'));
+    EXPECT_NE(summary::gerar_csv_detalhado({r}).find(",1" + std::string(30, '0') + ","), std::string::npos);
+}
+
+// Testes do ensemble de imputação
+TEST(EnsembleTest, LeituraComLacunas) {
+    const std::string caminho = "teste_lacunas.csv";
+    {
+        std::ofstream f(caminho);
+        f << "Data;Tmax;Tmin\n01/01/2023;30.0;22.0\n02/01/2023;;\n03/01/2023;nan;nan\n04/01/2023;29.5;21.0\n";
+    }
+    auto serie = io::ler_dados_com_lacunas(caminho);
+    ASSERT_EQ(serie.dias.size(), 4u);
+    EXPECT_EQ(serie.lacuna, (std::vector<char>{0, 1, 1, 0}));
+    EXPECT_EQ(serie.dias[1].data_str, "02/01/2023");
+    EXPECT_DOUBLE_EQ(serie.dias[3].tmin, 21.0);
+    EXPECT_THROW(io::ler_dados(caminho), std::runtime_error);
+    std::remove(caminho.c_str());
+}
+
+TEST(EnsembleTest, LeituraComLeiturasAusentes) {
+    const std::string caminho = "teste_ausentes.csv";
+    {
+        std::ofstream f(caminho);
+        f << "Data;Tmax;Tmin;Ausentes\r\n01/01/2023;30.0;22.0;0\r\n02/01/2023;29.0;23.5;5\r\n"
+             "03/01/2023;;;24\r\n";
+    }
+    auto serie = io::ler_dados_com_lacunas(caminho);
+    ASSERT_EQ(serie.leituras.size(), 3u);
+    EXPECT_EQ(serie.lacuna, (std::vector<char>{0, 1, 1}));
+    EXPECT_EQ(serie.leituras[1].ausentes, 5);
+    EXPECT_TRUE(serie.leituras[1].tmax_observada && serie.leituras[1].tmin_observada);
+    EXPECT_DOUBLE_EQ(serie.dias[1].tmax, 29.0);
+    EXPECT_FALSE(serie.leituras[2].tmax_observada);
+    {
+        std::ofstream f(caminho);
+        f << "Data;Tmax;Tmin;Ausentes\n01/01/2023;30.0;22.0;2\n02/01/2023;;;0\n";
+    }
+    EXPECT_THROW(io::ler_dados_com_lacunas(caminho), std::runtime_error);   // extremo ausente sem leitura ausente
+    EXPECT_THROW(io::ler_dados(caminho), std::runtime_error);
+    {
+        std::ofstream f(caminho);
+        f << "Data;Tmax;Tmin;Ausentes\n01/01/2023;30.0;22.0;2\n";
+    }
+    EXPECT_DOUBLE_EQ(io::ler_dados(caminho)[0].tmin, 22.0);   // sem --imputacoes a coluna é ignorada
+    std::remove(caminho.c_str());
+}
+
+TEST(EnsembleTest, ImputaSoLeiturasAusentes) {
+    std::vector<viab::Fase> fases = {viab::Fase("A", 10, 35, 15, 30, 2, 4)};
+    const viab::Dia observado{"01/01/2023", 1, 24.0, 20.0};
+    viab::LeiturasDia parcial;
+    parcial.ausentes = 3;
+    parcial.tmax_observada = parcial.tmin_observada = true;
+
+    // Extremos observados entram no recálculo e as realizações diferem entre si
+    std::set<double> tmax_parcial;
+    double soma = 0.0, soma2 = 0.0;
+    const int R = 20;
+    for (int r = 0; r < R; ++r) {
+        viab::Dia dia = observado;
+        viab::imputar_dia(dia, parcial, fases, 7, r, 0);
+        EXPECT_GE(dia.tmax, 24.0);
+        EXPECT_LE(dia.tmin, 20.0);
+        EXPECT_GE(dia.tmin, 15.0);
+        EXPECT_LE(dia.tmax, 30.0);
+        tmax_parcial.insert(dia.tmax);
+        soma += dia.tmax;
+        soma2 += dia.tmax * dia.tmax;
+    }
+    EXPECT_GT(tmax_parcial.size(), 10u);
+    EXPECT_GT((soma2 - soma * soma / R) / (R - 1), 1.0);   // variância de Tmax entre realizações
+
+    // Sem leituras ausentes o dia observado não muda
+    viab::LeiturasDia completo = parcial;
+    completo.ausentes = 0;
+    viab::Dia dia = observado;
+    viab::imputar_dia(dia, completo, fases, 7, 0, 0);
+    EXPECT_DOUBLE_EQ(dia.tmax, 24.0);
+    EXPECT_DOUBLE_EQ(dia.tmin, 20.0);
+}
+
+TEST(EnsembleTest, TabelasCorrigidasIgualAReconstrucao) {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<double> dist_max(25.0, 28.5);
+    viab::SerieComLacunas serie;
+    const std::set<int> lacunas = {3, 30, 31, 45, 90, 118};
+    for (int i = 0; i < 120; ++i) {
+        double tmax = dist_max(rng);
+        serie.dias.push_back({"Dia " + std::to_string(i), 1, tmax, tmax - 5.0});
+        serie.lacuna.push_back(lacunas.count(i) > 0);
+        viab::LeiturasDia l;
+        l.ausentes = lacunas.count(i) ? (i % 2 ? 4 : viab::LEITURAS_DIA) : 0;
+        l.tmax_observada = l.tmin_observada = l.ausentes < viab::LEITURAS_DIA;
+        serie.leituras.push_back(l);
+    }
+    std::vector<viab::Fase> fases = {viab::Fase("A", 15, 28.6, 20, 26, 2, 4),
+                                     viab::Fase("Maturação", 15, 32, 22, 29, 2, 5)};
+    const int R = 5;
+    auto ensemble = viab::rodar_ensemble_imputacao(serie, fases, R, 3);
+
+    // Referência: tabelas reconstruídas por realização (rodar_analise sobre a série preenchida)
+    std::vector<std::vector<viab::ResultadoData>> execucoes;
+    for (int r = 0; r < R; ++r) {
+        auto dias = serie.dias;
+        for (int d : lacunas) viab::imputar_dia(dias[d], serie.leituras[d], fases, 3, r, d);
+        execucoes.push_back(viab::rodar_analise(dias, fases));
+    }
+    double maior_desvio = 0.0;
+    for (size_t d = 0; d < serie.dias.size(); ++d) {
+        if (execucoes[0][d].data_str.empty()) continue;
+        double viab_media = 0.0, rend_media = 0.0;
+        for (auto& e : execucoes) {
+            viab_media += e[d].prob_viabilidade / R;
+            rend_media += e[d].rendimento_medio / R;
+        }
+        EXPECT_NEAR(ensemble[d].media.prob_viabilidade, viab_media, 1e-12) << d;
+        EXPECT_NEAR(ensemble[d].media.rendimento_medio, rend_media, 1e-9) << d;
+        maior_desvio = std::max(maior_desvio, ensemble[d].desvio[0]);
+    }
+    EXPECT_GT(maior_desvio, 0.0);
+}
+
+TEST(EnsembleTest, SemLacunasIgualAoGenerico) {
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> dist_max(24.0, 35.0);
+    viab::SerieComLacunas serie;
+    for (int i = 0; i < 30; ++i) {
+        double tmax = dist_max(rng);
+        serie.dias.push_back({"Dia " + std::to_string(i), 1, tmax, tmax - 6.0});
+        serie.lacuna.push_back(0);
+    }
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto ensemble = viab::rodar_ensemble_imputacao(serie, fases, 5);
+    auto generico = viab::rodar_analise(serie.dias, fases);
+    for (size_t d = 0; d < serie.dias.size(); ++d) {
+        EXPECT_FALSE(ensemble[d].afetado);
+        EXPECT_EQ(ensemble[d].media.data_str, generico[d].data_str);
+        EXPECT_NEAR(ensemble[d].media.prob_viabilidade, generico[d].prob_viabilidade, 1e-12);
+        EXPECT_NEAR(ensemble[d].media.rendimento_medio, generico[d].rendimento_medio, 1e-9);
+        for (double s : ensemble[d].desvio) EXPECT_EQ(s, 0.0);
+    }
+}
+
+TEST(EnsembleTest, MediaIgualAExecucoesIndependentes) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> dist_max(25.0, 28.0);
+    viab::SerieComLacunas serie;
+    for (int i = 0; i < 60; ++i) {
+        double tmax = dist_max(rng);
+        serie.dias.push_back({"Dia " + std::to_string(i), 1, tmax, tmax - 5.0});
+        serie.lacuna.push_back(i == 40 || i == 41);
+    }
+    // Imputação em [20, 29]: a Tmax preenchida (~28.6) oscila em torno do maxT da fase A
+    std::vector<viab::Fase> fases = {viab::Fase("A", 15, 28.6, 20, 26, 2, 4),
+                                     viab::Fase("Maturação", 15, 32, 22, 29, 2, 5)};
+    const int R = 4;
+    auto ensemble = viab::rodar_ensemble_imputacao(serie, fases, R, 99);
+
+    // Referência: R execuções completas sobre séries preenchidas
+    std::vector<std::vector<viab::ResultadoData>> execucoes;
+    for (int r = 0; r < R; ++r) {
+        auto dias = serie.dias;
+        for (int d : {40, 41}) viab::imputar_dia(dias[d], viab::LeiturasDia{}, fases, 99, r, d);
+        execucoes.push_back(viab::rodar_analise(dias, fases));
+    }
+    int afetados = 0;
+    double maior_desvio = 0.0;
+    for (size_t d = 0; d < serie.dias.size(); ++d) {
+        if (execucoes[0][d].data_str.empty()) continue;
+        for (double s : ensemble[d].desvio) maior_desvio = std::max(maior_desvio, s);
+        double media = 0.0, media2 = 0.0;
+        for (auto& e : execucoes) {
+            media += e[d].rendimento_medio / R;
+            media2 += e[d].rendimento_medio * e[d].rendimento_medio;
+        }
+        const double desvio = std::sqrt(std::max(0.0, (media2 - R * media * media) / (R - 1)));
+        EXPECT_NEAR(ensemble[d].media.rendimento_medio, media, 1e-9);
+        EXPECT_NEAR(ensemble[d].desvio[1], desvio, 1e-6);
+        afetados += ensemble[d].afetado;
+        EXPECT_EQ(ensemble[d].afetado, d + 9 > 40 && d <= 41);   // alcance = 4 + 5
+    }
+    EXPECT_GT(afetados, 0);
+    EXPECT_GT(maior_desvio, 0.0);
+    EXPECT_THROW(viab::rodar_ensemble_imputacao(serie, fases, 0), std::invalid_argument);
+}
+
+// Testes do fatiamento (--shard) e do merge
+TEST(ParticaoTest, FatiasCombinadasIguaisAExecucaoUnica) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto unica = viab::combinar_parciais({viab::rodar_fatia(dias, fases, 0, 1)});
+
+    std::vector<viab::ResultadoParcial> fatias;
+    for (int i = 2; i >= 0; --i) {   // ordem dos arquivos é irrelevante
+        const std::string caminho = io::nome_parcial(i, 3);
+        io::gravar_parcial(caminho, viab::rodar_fatia(dias, fases, i, 3));
+        fatias.push_back(io::ler_parcial(caminho));
+        std::remove(caminho.c_str());
+    }
+    auto combinado = viab::combinar_parciais(fatias);
+    auto generico = viab::rodar_analise(dias, fases);
+
+    EXPECT_EQ(summary::gerar_csv_detalhado(combinado.resultados),
+              summary::gerar_csv_detalhado(unica.resultados));
+    EXPECT_EQ(summary::gerar_csv_resumo_mensal(combinado.resultados, combinado.dias),
+              summary::gerar_csv_resumo_mensal(generico, dias));
+    for (size_t d = 0; d < dias.size(); ++d) {
+        EXPECT_EQ(combinado.resultados[d].data_str, generico[d].data_str);
+        EXPECT_EQ(combinado.resultados[d].caminhos_viaveis, generico[d].caminhos_viaveis);
+        EXPECT_NEAR(combinado.resultados[d].rendimento_medio, generico[d].rendimento_medio, 1e-9);
+    }
+}
+
+TEST(ParticaoTest, FatiasInconsistentes) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto f0 = viab::rodar_fatia(dias, fases, 0, 2);
+    auto f1 = viab::rodar_fatia(dias, fases, 1, 2);
+    EXPECT_THROW(viab::combinar_parciais({f0}), std::invalid_argument);          // fatia ausente
+    EXPECT_THROW(viab::combinar_parciais({f0, f0, f1}), std::invalid_argument);  // repetida
+    dias[5].tmax += 1.0;
+    EXPECT_THROW(viab::combinar_parciais({f0, viab::rodar_fatia(dias, fases, 1, 2)}),
+                 std::invalid_argument);                                         // outra série
+    EXPECT_THROW(viab::rodar_fatia(dias, fases, 2, 2), std::invalid_argument);
+
+    const std::string caminho = "teste_parcial_corrompido.bin";
+    io::gravar_parcial(caminho, f0);
+    std::filesystem::resize_file(caminho, std::filesystem::file_size(caminho) - 3);
+    EXPECT_THROW(io::ler_parcial(caminho), std::runtime_error);
+    std::remove(caminho.c_str());
+}
+
+TEST(ParticaoTest, OpcoesShardEMerge) {
+    auto op = cli::interpretar_argumentos({"d.csv", "s", "--shard", "2/5"});
+    EXPECT_EQ(op.fatia_indice, 2);
+    EXPECT_EQ(op.fatia_total, 5);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--shard=5/5"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--shard", "1/2", "--modo", "gdd"}),
+                 std::invalid_argument);
+    auto merge = cli::interpretar_argumentos({"merge", "saida", "a.bin", "b.bin"});
+    EXPECT_TRUE(merge.mesclar);
+    EXPECT_EQ(merge.pasta_saida, "saida");
+    EXPECT_EQ(merge.parciais, (std::vector<std::string>{"a.bin", "b.bin"}));
+    EXPECT_THROW(cli::interpretar_argumentos({"merge", "saida"}), std::invalid_argument);
+}
+
+// Testes do checkpoint (--checkpoint / --resume)
+TEST(CheckpointTest, RetomadaIgualAExecucaoSemInterrupcao) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    const std::string caminho = "teste_checkpoint.bin";
+    auto completa = io::rodar_analise_com_checkpoint(dias, fases, caminho, false);
+    EXPECT_EQ(completa.dias_retomados, 0u);
+    EXPECT_EQ(summary::gerar_csv_detalhado(completa.resultados),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, fases)));
+
+    // Interrompido após 10 registros, no meio do 11º
+    const auto tamanho_registro = (std::filesystem::file_size(caminho) - 20) / completa.dias_avaliados;
+    std::filesystem::resize_file(caminho, 20 + 10 * tamanho_registro + tamanho_registro / 2);
+    auto retomada = io::rodar_analise_com_checkpoint(dias, fases, caminho, true);
+    EXPECT_FALSE(retomada.invalidado);
+    EXPECT_EQ(retomada.dias_retomados, 10u);
+    EXPECT_EQ(retomada.dias_retomados + retomada.dias_avaliados, completa.dias_avaliados);
+    EXPECT_EQ(summary::gerar_csv_detalhado(retomada.resultados),
+              summary::gerar_csv_detalhado(completa.resultados));
+
+    // O checkpoint retomado ficou completo: nada a reavaliar
+    auto de_novo = io::rodar_analise_com_checkpoint(dias, fases, caminho, true);
+    EXPECT_EQ(de_novo.dias_avaliados, 0u);
+    EXPECT_EQ(summary::gerar_csv_detalhado(de_novo.resultados),
+              summary::gerar_csv_detalhado(completa.resultados));
+    std::remove(caminho.c_str());
+}
+
+TEST(CheckpointTest, InvalidadoQuandoAEntradaMuda) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    const std::string caminho = "teste_checkpoint_invalido.bin";
+    io::rodar_analise_com_checkpoint(dias, fases, caminho, false);
+
+    fases[1].optMaxT += 0.5;
+    auto outra = io::rodar_analise_com_checkpoint(dias, fases, caminho, true);
+    EXPECT_TRUE(outra.invalidado);
+    EXPECT_EQ(outra.dias_retomados, 0u);
+    EXPECT_EQ(summary::gerar_csv_detalhado(outra.resultados),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, fases)));
+    std::remove(caminho.c_str());
+
+    auto op = cli::interpretar_argumentos({"d.csv", "saida", "--resume"});
+    EXPECT_TRUE(op.retomar);
+    EXPECT_EQ(op.checkpoint, "saida/checkpoint.bin");
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--resume=1"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--checkpoint", "c.bin", "--shard", "0/2"}),
+                 std::invalid_argument);
+}
+
+// Testes do modo de precisão simples (float) e da validação contra double
+TEST(PrecisaoTest, DuplaIgualAoGenericoESimplesDentroDaTolerancia) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto dupla = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla);
+    auto simples = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Simples);
+    EXPECT_EQ(summary::gerar_csv_detalhado(dupla),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, fases)));
+
+    auto v = viab::comparar_precisao(dupla, simples);
+    ASSERT_EQ(v.campos.size(), 7u);
+    for (auto& c : v.campos) {
+        if (c.campo == "rendimento_medio") {
+            EXPECT_LT(c.desvio_max, 1e-5);
+        } else {
+            EXPECT_EQ(c.desvio_max, 0.0) << c.campo;   // contagens não dependem da penalidade
+        }
+    }
+    EXPECT_EQ(viab::comparar_precisao(dupla, dupla).dias_divergentes, 0);
+
+    simples.pop_back();
+    EXPECT_THROW(viab::comparar_precisao(dupla, simples), std::invalid_argument);
+}
+
+TEST(PrecisaoTest, TabelasSimplesGuardamPrefixoPorBloco) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto td = viab::construir_tabelas_em<double>(dias, fases);
+    auto tf = viab::construir_tabelas_em<float>(dias, fases);
+    const int n = static_cast<int>(dias.size());
+    for (size_t f = 0; f < fases.size(); ++f) {
+        EXPECT_EQ(tf[f].inviaveis, td[f].inviaveis);
+        EXPECT_EQ(tf[f].proximo_inviavel, td[f].proximo_inviavel);
+        EXPECT_TRUE(td[f].base_penalidade.empty());
+        ASSERT_EQ(tf[f].base_penalidade.size(), size_t(n / viab::DIAS_BLOCO_PENALIDADE + 1));
+        for (int d = 0; d <= n; ++d) {
+            const double base = tf[f].base_penalidade[d / viab::DIAS_BLOCO_PENALIDADE];
+            EXPECT_EQ(tf[f].penalidade[d], static_cast<float>(td[f].penalidade[d] - base));
+        }
+        for (int a = 0; a <= n; ++a)
+            for (int b = a; b <= n; ++b)
+                EXPECT_NEAR(viab::penalidade_janela(tf[f], a, b), viab::penalidade_janela(td[f], a, b), 1e-5);
+    }
+
+    auto op = cli::interpretar_argumentos({"d.csv", "s", "--validar-precisao"});
+    EXPECT_EQ(op.precisao, "simples");
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--precisao", "meia"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--precisao", "dupla", "--modo", "gdd"}),
+                 std::invalid_argument);
+}
+
+// O desvio em float não pode crescer com o comprimento da série
+TEST(PrecisaoTest, DesvioSimplesNaoCresceComASerie) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> dist_max(27.0, 33.0);
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < 45 * 365; ++i) {
+        const double tmax = dist_max(rng);   // quase todos os dias penalizados
+        dias.push_back({"01/01/2000", 1, tmax, tmax - 6.0});
+    }
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto desvio = [&](const std::vector<viab::Dia>& serie) {
+        auto v = viab::comparar_precisao(viab::rodar_analise_tabelas(serie, fases, viab::Precisao::Dupla),
+                                         viab::rodar_analise_tabelas(serie, fases, viab::Precisao::Simples));
+        for (auto& c : v.campos)
+            if (c.campo == "rendimento_medio") return c.desvio_max;
+        return -1.0;
+    };
+    const double curto = desvio({dias.begin(), dias.begin() + 365});
+    const double longo = desvio(dias);
+    EXPECT_GE(curto, 0.0);
+    EXPECT_LT(longo, 1e-6);
+    EXPECT_LT(longo, 4 * curto + 1e-7);
+}
+
+// Testes do pré-filtro de viabilidade
+TEST(PreFiltroTest, SoDescartaDiasSemCaminhoViavel) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    for (int d = 30; d < 34; ++d) dias[d].tmax = 45.0;   // onda de calor inviável em qualquer fase
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    const int n = static_cast<int>(dias.size());
+    const auto tabelas = viab::construir_tabelas(dias, fases);
+    int reprovados = 0;
+    for (int d = 0; d < n; ++d) {
+        if (viab::pode_ser_viavel(tabelas, fases, n, d)) continue;
+        ++reprovados;
+        EXPECT_EQ(viab::enumerar_dia(tabelas, fases, n, d).viaveis, 0) << "dia " << d;
+    }
+    EXPECT_GT(reprovados, 0);
+
+    size_t descartados = 0;
+    auto tabelas_res = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla, 0, &descartados);
+    EXPECT_GT(descartados, 0u);
+    testing::internal::CaptureStdout();
+    auto generico = viab::rodar_analise(dias, fases);
+    const std::string log = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(summary::gerar_csv_detalhado(tabelas_res), summary::gerar_csv_detalhado(generico));
+    // Mesmo total nos motores: dias finais sem espaço para o ciclo não contam como podados
+    const std::string linha = "Pré-filtro: " + std::to_string(descartados) + " de " + std::to_string(n);
+    EXPECT_NE(log.find(linha), std::string::npos) << log;
+
+    for (auto& f : fases) f.pesos.assign(f.durMax - f.durMin + 1, 1.0 / (f.durMax - f.durMin + 1));
+    size_t ponderados = 0;
+    viab::rodar_analise_ponderada(dias, fases, 0, &ponderados);
+    EXPECT_EQ(ponderados, descartados);
+}
+
+// Testes da grade mapeada em memória (--modo grade)
+namespace {
+// Lê o arranjo float32 [celula][dia][campo] de resultado_grade
+std::vector<float> ler_resultado_grade(const std::string& caminho, size_t& celulas, size_t& dias) {
+    std::ifstream in(caminho, std::ios::binary);
+    char assinatura[8];
+    std::uint32_t versao, campos;
+    std::uint64_t c, n;
+    in.read(assinatura, 8);
+    in.read(reinterpret_cast<char*>(&versao), 4);
+    in.read(reinterpret_cast<char*>(&c), 8);
+    in.read(reinterpret_cast<char*>(&n), 8);
+    in.read(reinterpret_cast<char*>(&campos), 4);
+    for (std::uint32_t k = 0; k < campos; ++k) {
+        std::uint32_t tamanho;
+        in.read(reinterpret_cast<char*>(&tamanho), 4);
+        in.seekg(tamanho, std::ios::cur);
+    }
+    celulas = c;
+    dias = n;
+    std::vector<float> valores(c * n * campos);
+    in.read(reinterpret_cast<char*>(valores.data()), valores.size() * sizeof(float));
+    EXPECT_TRUE(static_cast<bool>(in));
+    return valores;
+}
+} // namespace
+
+TEST(GradeTest, CelulasIguaisCalculadasUmaVezNosDoisLayouts) {
+    std::vector<int> anos;
+    const auto base = serie_dois_anos(anos);
+    const size_t n = base.size(), C = 7;
+    // Células 0, 3 e 5 idênticas; 1 e 4 idênticas; 2 e 6 únicas
+    const double deslocamento[C] = {0.0, 1.3, -0.8, 0.0, 1.3, 0.0, 2.1};
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+
+    for (auto layout : {io::LayoutGrade::CelulaDia, io::LayoutGrade::DiaCelula}) {
+        io::CabecalhoGrade cab;
+        cab.layout = layout;
+        cab.num_celulas = C;
+        cab.num_dias = n;
+        cab.ano = 2022; cab.mes = 11; cab.dia = 20;
+        std::vector<float> tmax(C * n), tmin(C * n);
+        for (size_t c = 0; c < C; ++c)
+            for (size_t d = 0; d < n; ++d) {
+                const size_t i = layout == io::LayoutGrade::CelulaDia ? c * n + d : d * C + c;
+                tmax[i] = static_cast<float>(base[d].tmax + deslocamento[c]);
+                tmin[i] = static_cast<float>(base[d].tmin + deslocamento[c]);
+            }
+        // Dado ausente (NaN) no mesmo dia de 1 e 4: continuam idênticas
+        for (size_t c : {size_t(1), size_t(4)})
+            tmin[layout == io::LayoutGrade::CelulaDia ? c * n : c] = std::numeric_limits<float>::quiet_NaN();
+        const std::string entrada = "teste_grade.bin", saida = "teste_resultado_grade.bin";
+        io::gravar_grade(entrada, cab, tmax, tmin);
+        io::GradeMapeada grade(entrada);
+        auto exec = io::rodar_analise_grade(grade, fases, saida, {2, 5});
+        EXPECT_EQ(exec.celulas, C);
+        EXPECT_EQ(exec.celulas_unicas, 4u);
+
+        // Célula selecionada igual ao caminho genérico sobre a mesma série float
+        for (size_t c : {size_t(2), size_t(5)}) {
+            std::vector<viab::Dia> dias = base;
+            for (size_t d = 0; d < n; ++d) {
+                dias[d].tmax = grade.tmax(c, d);
+                dias[d].tmin = grade.tmin(c, d);
+            }
+            auto generico = viab::rodar_analise(dias, fases);
+            auto& obtido = exec.selecionadas.at(c);
+            for (size_t d = 0; d < n; ++d) obtido[d].data_str = generico[d].data_str;
+            EXPECT_EQ(summary::gerar_csv_detalhado(obtido), summary::gerar_csv_detalhado(generico));
+        }
+
+        size_t celulas = 0, dias = 0;
+        auto valores = ler_resultado_grade(saida, celulas, dias);
+        ASSERT_EQ(celulas, C);
+        ASSERT_EQ(dias, n);
+        const size_t bloco = n * io::NUM_CAMPOS_GRADE;
+        auto celula = [&](size_t c) {
+            return std::vector<float>(valores.begin() + c * bloco, valores.begin() + (c + 1) * bloco);
+        };
+        EXPECT_EQ(celula(3), celula(0));
+        EXPECT_EQ(celula(5), celula(0));
+        EXPECT_EQ(celula(4), celula(1));
+        EXPECT_NE(celula(6), celula(0));
+        const auto& r5 = exec.selecionadas.at(5);
+        for (size_t d = 0; d < n; ++d)
+            EXPECT_FLOAT_EQ(valores[5 * bloco + d * io::NUM_CAMPOS_GRADE + 1],
+                            static_cast<float>(r5[d].rendimento_medio));
+
+        EXPECT_THROW(io::rodar_analise_grade(grade, fases, saida, {C}), std::invalid_argument);
+        std::remove(saida.c_str());
+        std::remove(entrada.c_str());
+    }
+}
+
+TEST(GradeTest, LadrilhosDiaCelulaIguaisACelulaDia) {
+    // Mais de dois ladrilhos, com repetições dentro de um ladrilho e entre ladrilhos
+    std::vector<int> anos;
+    const auto base = serie_dois_anos(anos);
+    const size_t n = base.size(), C = 2 * io::TAMANHO_BLOCO_GRADE + 11;
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    std::vector<std::vector<float>> resultados;
+    std::vector<size_t> unicas;
+    for (auto layout : {io::LayoutGrade::CelulaDia, io::LayoutGrade::DiaCelula}) {
+        io::CabecalhoGrade cab;
+        cab.layout = layout;
+        cab.num_celulas = C;
+        cab.num_dias = n;
+        cab.ano = 2022; cab.mes = 11; cab.dia = 20;
+        std::vector<float> tmax(C * n), tmin(C * n);
+        for (size_t c = 0; c < C; ++c)
+            for (size_t d = 0; d < n; ++d) {
+                const size_t i = layout == io::LayoutGrade::CelulaDia ? c * n + d : d * C + c;
+                const double deslocamento = 0.1 * static_cast<double>(c % 101);
+                tmax[i] = static_cast<float>(base[d].tmax + deslocamento);
+                tmin[i] = static_cast<float>(base[d].tmin + deslocamento);
+            }
+        const std::string entrada = "teste_grade_ladrilhos.bin", saida = "teste_resultado_ladrilhos.bin";
+        io::gravar_grade(entrada, cab, tmax, tmin);
+        {
+            io::GradeMapeada grade(entrada);
+            unicas.push_back(io::rodar_analise_grade(grade, fases, saida).celulas_unicas);
+        }
+        size_t celulas = 0, dias = 0;
+        resultados.push_back(ler_resultado_grade(saida, celulas, dias));
+        std::remove(saida.c_str());
+        std::remove(entrada.c_str());
+    }
+    EXPECT_EQ(unicas[0], 101u);
+    EXPECT_EQ(unicas[1], 101u);
+    EXPECT_EQ(resultados[1], resultados[0]);
+}
+
+TEST(GradeTest, ArquivoInvalido) {
+    const std::string caminho = "teste_grade_invalida.bin";
+    io::CabecalhoGrade cab;
+    cab.num_celulas = 2;
+    cab.num_dias = 3;
+    io::gravar_grade(caminho, cab, std::vector<float>(6, 25.f), std::vector<float>(6, 20.f));
+    std::filesystem::resize_file(caminho, std::filesystem::file_size(caminho) - 4);
+    EXPECT_THROW(io::GradeMapeada{caminho}, std::runtime_error);
+    std::remove(caminho.c_str());
+    EXPECT_THROW(io::GradeMapeada{"nao_existe.bin"}, std::runtime_error);
+    EXPECT_THROW(io::gravar_grade(caminho, cab, {1.f}, {1.f}), std::invalid_argument);
+
+    auto op = cli::interpretar_argumentos({"g.bin", "s", "--modo", "grade", "--celulas", "3,10"});
+    EXPECT_EQ(op.celulas, (std::vector<size_t>{3, 10}));
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--celulas", "1"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"g.bin", "s", "--modo", "grade", "--celulas", "1,x"}),
+                 std::invalid_argument);
+}
+
+// Testes do recálculo incremental (--estado)
+TEST(IncrementalTest, SoRecalculaDiasAlcancadosPelaFaseAlterada) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    const std::string caminho = "teste_estado.bin";
+    std::remove(caminho.c_str());
+
+    auto primeira = io::rodar_analise_incremental(dias, fases, caminho);
+    EXPECT_TRUE(primeira.completa);
+    auto repetida = io::rodar_analise_incremental(dias, fases, caminho);
+    EXPECT_FALSE(repetida.completa);
+    EXPECT_EQ(repetida.dias_recalculados, 0u);
+    EXPECT_EQ(summary::gerar_csv_detalhado(repetida.resultados),
+              summary::gerar_csv_detalhado(primeira.resultados));
+
+    // maxT da Maturação passa a admitir um único dia da série: só parte dos dias iniciais muda
+    auto ajustadas = fases;
+    double menor_acima = 1e9;
+    for (auto& d : dias)
+        if (d.tmax > ajustadas[2].maxT) menor_acima = std::min(menor_acima, d.tmax);
+    ajustadas[2].maxT = menor_acima + 1e-6;
+    auto ajustada = io::rodar_analise_incremental(dias, ajustadas, caminho);
+    EXPECT_FALSE(ajustada.completa);
+    EXPECT_EQ(ajustada.fases_alteradas, 1u);
+    EXPECT_GT(ajustada.dias_recalculados, 0u);
+    EXPECT_GT(ajustada.dias_reaproveitados, 0u);
+    EXPECT_EQ(summary::gerar_csv_detalhado(ajustada.resultados),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, ajustadas)));
+
+    EXPECT_EQ(ajustada.tabelas_reaproveitadas, 2u);
+
+    // Fase inserida no início: as posições mudam, mas as tabelas seguem o conteúdo
+    auto inseridas = ajustadas;
+    inseridas.insert(inseridas.begin(), viab::Fase("Preparo", 10, 40, 20, 30, 1, 2));
+    auto inserida = io::rodar_analise_incremental(dias, inseridas, caminho);
+    EXPECT_TRUE(inserida.completa);
+    EXPECT_EQ(inserida.tabelas_reaproveitadas, 3u);
+    EXPECT_EQ(summary::gerar_csv_detalhado(inserida.resultados),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, inseridas)));
+
+    // Duas fases de mesmas durações trocadas: cada posição é comparada com a que ocupava
+    auto trocadas = inseridas;
+    trocadas[3].durMin = trocadas[1].durMin;
+    trocadas[3].durMax = trocadas[1].durMax;
+    io::rodar_analise_incremental(dias, trocadas, caminho);
+    std::swap(trocadas[1], trocadas[3]);
+    auto trocada = io::rodar_analise_incremental(dias, trocadas, caminho);
+    EXPECT_FALSE(trocada.completa);
+    EXPECT_EQ(trocada.fases_alteradas, 2u);
+    EXPECT_EQ(trocada.tabelas_reaproveitadas, 4u);
+    EXPECT_EQ(summary::gerar_csv_detalhado(trocada.resultados),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, trocadas)));
+
+    // Duração diferente muda o espaço de caminhos: execução completa
+    ajustadas[0].durMax += 1;
+    auto outra = io::rodar_analise_incremental(dias, ajustadas, caminho);
+    EXPECT_TRUE(outra.completa);
+    EXPECT_EQ(summary::gerar_csv_detalhado(outra.resultados),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, ajustadas)));
+
+    // Estado corrompido também
+    std::filesystem::resize_file(caminho, std::filesystem::file_size(caminho) / 2);
+    EXPECT_TRUE(io::rodar_analise_incremental(dias, ajustadas, caminho).completa);
+    std::remove(caminho.c_str());
+}
+
+TEST(IncrementalTest, JanelaDeAlcanceDaFase) {
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();   // durações 2-4, 3-6, 2-5
+    std::vector<char> alterados(40, 0);
+    alterados[20] = 1;
+    // Fase 1 (Meio) ocupa [d + 2, d + 10): afetados d em (10, 18]
+    auto afetados = viab::inicios_afetados(fases, 1, alterados);
+    for (int d = 0; d < 40; ++d) EXPECT_EQ(afetados[d] != 0, d >= 11 && d <= 18) << "dia " << d;
+    EXPECT_NE(viab::hash_fase(fases[0]), viab::hash_fase(fases[1]));
+}
+
+namespace {
+// 40 dias viáveis para o CatalogoTeste com um bloco quente (dias 18-32) em
+// que a penalidade média passa de 1: o rendimento truncado em 0 é exercitado
+std::vector<viab::Dia> serie_com_bloco_quente() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> dist_max(25.0, 31.0);
+    std::uniform_real_distribution<double> dist_delta(3.0, 7.0);
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < 40; ++i) {
+        const bool quente = i >= 18 && i <= 32;
+        double tmax = quente ? 31.9 : dist_max(rng);
+        double tmin = quente ? 31.6 : tmax - dist_delta(rng);
+        dias.push_back({"Dia " + std::to_string(i), 1, tmax, tmin});
+    }
+    return dias;
+}
+} // namespace
+
+TEST(DuracaoPonderadaTest, PesosUniformesIguaisAoGenerico) {
+    auto dias = serie_com_bloco_quente();
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto generico = viab::rodar_analise(dias, fases);
+    for (auto& f : fases) f.pesos.assign(f.durMax - f.durMin + 1, 1.0 / (f.durMax - f.durMin + 1));
+    auto ponderado = viab::rodar_analise(dias, fases);
+
+    ASSERT_EQ(generico.size(), ponderado.size());
+    for (size_t i = 0; i < dias.size(); ++i) {
+        EXPECT_EQ(generico[i].data_str, ponderado[i].data_str);
+        EXPECT_EQ(generico[i].total_caminhos.texto(), ponderado[i].total_caminhos.texto());
+        EXPECT_EQ(generico[i].caminhos_viaveis, ponderado[i].caminhos_viaveis);
+        EXPECT_NEAR(generico[i].prob_viabilidade, ponderado[i].prob_viabilidade, 1e-12);
+        EXPECT_NEAR(generico[i].rendimento_medio, ponderado[i].rendimento_medio, 1e-9);
+        EXPECT_NEAR(generico[i].prob_optimo, ponderado[i].prob_optimo, 1e-12);
+        EXPECT_NEAR(generico[i].prob_esbranquiamento, ponderado[i].prob_esbranquiamento, 1e-12);
+        EXPECT_NEAR(generico[i].prob_reducao_moagem, ponderado[i].prob_reducao_moagem, 1e-12);
+    }
+}
+
+// Referência por força bruta: cada combinação de durações é um caminho único
+// (durMin = durMax) avaliado pelo caminho genérico e somado com o seu peso
+TEST(DuracaoPonderadaTest, IgualAEnumeracaoPonderada) {
+    auto dias = serie_com_bloco_quente();
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    fases[0].pesos = viab::normalizar_pesos(fases[0], {1.0, 3.0, 0.5});
+    fases[1].pesos = viab::pesos_triangulares(fases[1], 4);
+    fases[2].pesos = viab::pesos_normais(fases[2], 4.2, 0.8);
+    auto ponderado = viab::rodar_analise(dias, fases);
+
+    const size_t n = dias.size();
+    std::vector<double> viab_(n, 0.0), rend(n, 0.0), opt(n, 0.0), esb(n, 0.0), red(n, 0.0);
+    std::vector<long long> caminhos(n, 0);
+    std::vector<char> truncado(n, 0);   // algum caminho viável com rendimento 0
+    std::vector<int> comb(fases.size());
+    for (long long idx = 0; idx < 3 * 4 * 4; ++idx) {
+        viab::gerar_combinacao_por_indice(comb, fases, idx);
+        auto fixas = fases;
+        double peso = 1.0;
+        for (size_t f = 0; f < fases.size(); ++f) {
+            peso *= fases[f].pesos[comb[f] - fases[f].durMin];
+            fixas[f].durMin = fixas[f].durMax = comb[f];
+            fixas[f].pesos.clear();
+        }
+        auto unico = viab::rodar_analise(dias, fixas);
+        for (size_t d = 0; d < n; ++d) {
+            if (unico[d].caminhos_viaveis == 0) continue;
+            ++caminhos[d];
+            truncado[d] |= unico[d].rendimento_medio == 0.0;
+            viab_[d] += peso;
+            rend[d] += peso * unico[d].rendimento_medio;
+            opt[d] += peso * unico[d].prob_optimo;
+            esb[d] += peso * unico[d].prob_esbranquiamento;
+            red[d] += peso * unico[d].prob_reducao_moagem;
+        }
+    }
+    for (size_t d = 0; d < n; ++d) {
+        EXPECT_EQ(ponderado[d].caminhos_viaveis, caminhos[d]) << "dia " << d;
+        EXPECT_NEAR(ponderado[d].prob_viabilidade, viab_[d], 1e-12) << "dia " << d;
+        EXPECT_NEAR(ponderado[d].prob_optimo, opt[d], 1e-12) << "dia " << d;
+        if (viab_[d] == 0.0) continue;
+        EXPECT_NEAR(ponderado[d].rendimento_medio, rend[d] / viab_[d], 1e-9) << "dia " << d;
+        EXPECT_NEAR(ponderado[d].prob_esbranquiamento, esb[d] / viab_[d], 1e-12) << "dia " << d;
+        EXPECT_NEAR(ponderado[d].prob_reducao_moagem, red[d] / viab_[d], 1e-12) << "dia " << d;
+    }
+    EXPECT_GT(std::count(caminhos.begin(), caminhos.end(), 0LL), 0);
+    EXPECT_LT(std::count(caminhos.begin(), caminhos.end(), 0LL), static_cast<long>(n));
+    EXPECT_GT(std::count(truncado.begin(), truncado.end(), 1), 0);
+}
+
+TEST(DuracaoPonderadaTest, EspecificacoesDePesos) {
+    viab::Fase fase("F", 15, 34, 22, 28, 2, 6);
+    auto tri = viab::pesos_triangulares(fase, 3);   // 1/2, 1, 3/4, 1/2, 1/4 antes de normalizar
+    ASSERT_EQ(tri.size(), 5u);
+    EXPECT_NEAR(tri[1] / tri[0], 2.0, 1e-12);
+    EXPECT_NEAR(tri[4] / tri[1], 0.25, 1e-12);
+    auto normal = viab::pesos_normais(fase, 4, 1);
+    EXPECT_NEAR(normal[1], normal[3], 1e-12);
+    EXPECT_GT(normal[2], normal[1]);
+    double soma = 0.0;
+    for (double p : normal) soma += p;
+    EXPECT_NEAR(soma, 1.0, 1e-12);
+
+    EXPECT_THROW(viab::normalizar_pesos(fase, {1, 1}), std::invalid_argument);
+    EXPECT_THROW(viab::normalizar_pesos(fase, {1, -1, 1, 1, 1}), std::invalid_argument);
+    EXPECT_THROW(viab::normalizar_pesos(fase, {0, 0, 0, 0, 0}), std::invalid_argument);
+    EXPECT_THROW(viab::pesos_triangulares(fase, 7), std::invalid_argument);
+    EXPECT_THROW(viab::pesos_normais(fase, 4, 0), std::invalid_argument);
+    EXPECT_FALSE(viab::tem_pesos({fase}));
+}
+
+TEST(FalhasTest, AtribuiFaseLimiteEDeslocamento) {
+    // Série amena com um dia quente (8) e um frio (30)
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < 40; ++i) dias.push_back({"Dia " + std::to_string(i), 1, 28.0, 22.0});
+    dias[8].tmax = 40.0;
+    dias[30].tmin = 10.0;
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    std::vector<viab::FalhasDia> falhas;
+    auto resultados = viab::rodar_analise(dias, fases, &falhas);
+    ASSERT_EQ(falhas.size(), dias.size());
+    EXPECT_EQ(summary::gerar_csv_detalhado(resultados),
+              summary::gerar_csv_detalhado(viab::rodar_analise(dias, fases)));
+
+    // Todo caminho avaliado é viável ou tem exatamente uma primeira falha
+    for (size_t d = 0; d + 7 <= dias.size(); ++d) {
+        const auto& f = falhas[d];
+        long long total = resultados[d].caminhos_viaveis + f.fim_serie;
+        for (size_t k = 0; k < fases.size(); ++k) total += f.abaixo_min[k] + f.acima_max[k];
+        EXPECT_EQ(total, resultados[d].total_caminhos.saturado()) << "dia " << d;
+    }
+
+    // Dia 0: só o dia 8 derruba caminhos, na fase Meio (término após o dia 8) ou na Maturação
+    EXPECT_EQ(falhas[0].deslocamento_moda, 8);
+    EXPECT_EQ(falhas[0].acima_max[0], 0);
+    EXPECT_GT(falhas[0].acima_max[1], 0);
+    EXPECT_GT(falhas[0].acima_max[2], 0);
+    EXPECT_EQ(falhas[0].falhas_moda, falhas[0].acima_max[1] + falhas[0].acima_max[2]);
+    EXPECT_EQ(falhas[0].abaixo_min, std::vector<long long>(3, 0));
+
+    // Dia 28: o dia 30 cai na Inicial (durações 3-4) ou no início do Meio (Inicial de 2 dias)
+    EXPECT_EQ(falhas[28].deslocamento_moda, 2);
+    EXPECT_EQ(falhas[28].falhas_moda, resultados[28].total_caminhos.saturado());
+    EXPECT_EQ(falhas[28].abaixo_min[0], 32);
+    EXPECT_EQ(falhas[28].abaixo_min[1], 16);
+    EXPECT_EQ(resultados[28].caminhos_viaveis, 0);
+
+    // Dias finais: caminhos que passam do fim da série
+    EXPECT_GT(falhas[33].fim_serie, 0);
+    EXPECT_NE(summary::gerar_csv_falhas(falhas, resultados).find("abaixo_minT_3,acima_maxT_3,fim_serie"),
+              std::string::npos);
+
+    EXPECT_TRUE(cli::interpretar_argumentos({"d.csv", "s", "--falhas"}).falhas);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--falhas", "--modo", "gdd"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--falhas", "--cultivar", "default"}),
+                 std::invalid_argument);
+}
+
+// Testes do estimador condicional de eventos raros
+TEST(CondicionalTest, NaoViesadoFrenteAViabilidadeExata) {
+    std::vector<int> anos;
+    auto dias = serie_dois_anos(anos);
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    const auto tabelas = viab::construir_tabelas(dias, fases);
+    const int n = static_cast<int>(dias.size());
+    auto generico = viab::rodar_analise(dias, fases);
+    auto condicional = viab::rodar_analise_condicional(dias, fases, 4000, 3);
+    ASSERT_EQ(condicional.size(), dias.size());
+
+    int viaveis = 0;
+    for (int d = 0; d + 7 <= n; ++d) {
+        const auto& c = condicional[d];
+        const double exata = viab::probabilidade_viavel(tabelas, fases, n, d);
+        EXPECT_EQ(c.base.data_str, dias[d].data_str);
+        EXPECT_EQ(c.base.total_caminhos.texto(), generico[d].total_caminhos.texto());
+        EXPECT_NEAR(c.base.prob_viabilidade, exata, 5 * c.erro_padrao + 1e-12) << "dia " << d;
+        if (exata == 0.0) {
+            EXPECT_EQ(c.amostras_efetivas, 0.0);
+            continue;
+        }
+        ++viaveis;
+        EXPECT_NEAR(c.base.rendimento_medio, generico[d].rendimento_medio, 0.02) << "dia " << d;
+        EXPECT_NEAR(c.base.prob_optimo, generico[d].prob_optimo, 5 * c.erro_padrao + 0.01) << "dia " << d;
+        EXPECT_GT(c.amostras_efetivas, 1.0);
+        EXPECT_LE(c.amostras_efetivas, 4000.0 + 1e-6);
+    }
+    EXPECT_GT(viaveis, 0);
+    EXPECT_THROW(viab::rodar_analise_condicional(dias, fases, 1), std::invalid_argument);
+}
+
+TEST(CondicionalTest, ProbabilidadeRaraComPoucasAmostras) {
+    // 4 fases de 1 a 30 dias (810 000 caminhos) e só 8 dias até o fim da série:
+    // C(8, 4) = 70 caminhos cabem, P ≈ 8.6e-5
+    std::vector<viab::Fase> fases;
+    for (int i = 0; i < 4; ++i) fases.emplace_back("F" + std::to_string(i), 10, 40, 20, 30, 1, 30);
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < 20; ++i) dias.push_back({"Dia " + std::to_string(i), 1, 28.0, 22.0});
+    const auto tabelas = viab::construir_tabelas(dias, fases);
+    const double exata = viab::probabilidade_viavel(tabelas, fases, 20, 12);
+    EXPECT_NEAR(exata, 70.0 / 810000.0, 1e-15);
+
+    auto c = viab::rodar_analise_condicional(dias, fases, 2000, 9)[12];
+    EXPECT_NEAR(c.base.prob_viabilidade, exata, 5 * c.erro_padrao);
+    EXPECT_LT(c.erro_padrao / exata, 0.05);
+    EXPECT_EQ(c.base.caminhos_viaveis, static_cast<long long>(c.base.prob_viabilidade * 810000.0));
+    EXPECT_NEAR(c.base.rendimento_medio, 1.0, 1e-12);
+    EXPECT_NE(summary::gerar_csv_condicional({c}).find("erro_relativo"), std::string::npos);
+}
+
+// Testes da rotação de duas safras
+TEST(RotacaoTest, IgualAoEncadeamentoPorForcaBruta) {
+    auto dias = serie_com_bloco_quente();
+    auto primeira = viab::fases_do_catalogo<CatalogoTeste>();
+    std::vector<viab::Fase> segunda = {{"Vegetativa", 15, 34, 22, 28, 2, 3},
+                                       {"Maturação", 15, 32, 20, 26, 2, 4}};
+    const viab::IntervaloRotacao intervalo{1, 3};
+    auto rotacao = viab::rodar_analise_rotacao(dias, primeira, segunda, intervalo);
+    auto unica = viab::rodar_analise(dias, segunda);
+
+    // Cada combinação da primeira safra é um caminho único avaliado pelo caminho genérico
+    const size_t n = dias.size();
+    std::vector<double> prob_a(n, 0.0), conjunta(n, 0.0), rend_a(n, 0.0), rend_b(n, 0.0), dias_b(n, 0.0);
+    std::vector<int> comb(primeira.size());
+    for (long long idx = 0; idx < 48; ++idx) {
+        viab::gerar_combinacao_por_indice(comb, primeira, idx);
+        auto fixas = primeira;
+        int T = 0;
+        for (size_t f = 0; f < fixas.size(); ++f) {
+            fixas[f].durMin = fixas[f].durMax = comb[f];
+            T += comb[f];
+        }
+        auto caminho = viab::rodar_analise(dias, fixas);
+        for (size_t d = 0; d < n; ++d) {
+            if (caminho[d].caminhos_viaveis == 0) continue;
+            prob_a[d] += 1.0 / 48;
+            for (int g = intervalo.minimo; g <= intervalo.maximo; ++g) {
+                const size_t s = d + T + g;
+                if (s >= n) continue;
+                const double p = unica[s].prob_viabilidade / 48 / 3;
+                conjunta[d] += p;
+                rend_a[d] += p * caminho[d].rendimento_medio;
+                rend_b[d] += p * unica[s].rendimento_medio;
+                dias_b[d] += p * (T + g);
+            }
+        }
+    }
+    int pares = 0;
+    for (size_t d = 0; d < n; ++d) {
+        EXPECT_EQ(rotacao[d].data_str, dias[d].data_str);
+        EXPECT_NEAR(rotacao[d].prob_viabilidade_primeira, prob_a[d], 1e-12) << "dia " << d;
+        EXPECT_NEAR(rotacao[d].prob_viabilidade_conjunta, conjunta[d], 1e-12) << "dia " << d;
+        if (conjunta[d] == 0.0) continue;
+        ++pares;
+        EXPECT_NEAR(rotacao[d].rendimento_primeira, rend_a[d] / conjunta[d], 1e-9) << "dia " << d;
+        EXPECT_NEAR(rotacao[d].rendimento_segunda, rend_b[d] / conjunta[d], 1e-9) << "dia " << d;
+        EXPECT_NEAR(rotacao[d].rendimento_conjunto, (rend_a[d] + rend_b[d]) / conjunta[d], 1e-9);
+        EXPECT_NEAR(rotacao[d].dias_ate_segunda, dias_b[d] / conjunta[d], 1e-9) << "dia " << d;
+    }
+    EXPECT_GT(pares, 0);
+
+    EXPECT_THROW(viab::rodar_analise_rotacao(dias, primeira, segunda, {3, 1}), std::invalid_argument);
+    auto op = cli::interpretar_argumentos({"d.csv", "s", "--rotacao", "b.json", "--intervalo-rotacao", "5-20"});
+    EXPECT_EQ(op.intervalo_min, 5);
+    EXPECT_EQ(op.intervalo_max, 20);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--intervalo-rotacao", "5-20"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"d.csv", "s", "--rotacao", "b.json", "--modo", "gdd"}),
+                 std::invalid_argument);
+}
+
+// Testes da climatologia móvel por dia do calendário
+TEST(ClimatologiaTest, JanelaMovelIgualARecalculo) {
+    // Resultados sintéticos de 2001 a 2006, um por dia
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<viab::ResultadoData> resultados;
+    for (summary::Data d{2001, 1, 1}; d.ano <= 2006; d = summary::dia_seguinte(d)) {
+        viab::ResultadoData r;
+        r.data_str = summary::formatar_data(d);
+        r.prob_viabilidade = u(rng);
+        r.rendimento_medio = u(rng);
+        r.prob_esbranquiamento = u(rng);
+        r.prob_reducao_moagem = u(rng);
+        r.prob_optimo = u(rng);
+        resultados.push_back(r);
+    }
+    const auto anos = summary::separar_anos(summary::extrair_colunas(resultados));
+    ASSERT_EQ(anos.size(), 6u);
+    EXPECT_FALSE(anos.at(2001).presente[59]);   // 29/02 só em 2004
+    EXPECT_TRUE(anos.at(2004).presente[59]);
+    EXPECT_EQ(summary::dia_calendario({2001, 3, 1}), 60);
+
+    summary::ClimatologiaMovel clima(3);
+    for (const auto& [ano, r] : anos) {
+        clima.incluir_ano(ano, r);
+        ASSERT_LE(clima.anos().size(), 3u);
+        EXPECT_EQ(clima.anos().rbegin()->first, ano);
+        for (int dia = 0; dia < summary::DIAS_CALENDARIO; ++dia) {
+            for (int m = 0; m < summary::NUM_METRICAS; ++m) {
+                summary::Estatistica e;
+                for (const auto& [a, guardado] : clima.anos())
+                    if (guardado.presente[dia]) e.adicionar(guardado.valores[dia][m]);
+                const auto& s = clima.soma(dia, m);
+                ASSERT_EQ(s.n, e.n);
+                EXPECT_NEAR(s.media(), e.media, 1e-12);
+                EXPECT_NEAR(s.variancia(), e.variancia(), 1e-10);
+            }
+        }
+    }
+    EXPECT_EQ(clima.anos().begin()->first, 2004);
+
+    // Ano antigo fora da janela cheia é ignorado; ano parcial completa o guardado
+    clima.incluir_ano(2002, anos.at(2002));
+    EXPECT_EQ(clima.anos().begin()->first, 2004);
+    summary::AnoClimatologia parcial{};
+    parcial.presente[0] = 1;
+    parcial.valores[0].fill(0.5);
+    const double antes = clima.soma(1, 0).media();
+    clima.incluir_ano(2006, parcial);
+    EXPECT_NEAR(clima.soma(0, 0).media(),
+                (anos.at(2004).valores[0][0] + anos.at(2005).valores[0][0] + 0.5) / 3, 1e-12);
+    EXPECT_EQ(clima.soma(1, 0).media(), antes);
+
+    // Histórico gravado e relido reproduz a mesma tabela
+    const std::string caminho = "teste_climatologia.bin";
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    const auto impressao = io::impressao_climatologia(fases, {});
+    io::gravar_climatologia(caminho, clima, impressao);
+    int janela_gravada = 0;
+    auto relida = io::ler_climatologia(caminho, impressao, 0, &janela_gravada);
+    EXPECT_EQ(janela_gravada, 3);
+    EXPECT_EQ(relida.anos_janela(), 3);   // sem tamanho pedido, vale o gravado
+    EXPECT_EQ(summary::gerar_csv_climatologia(relida), summary::gerar_csv_climatologia(clima));
+    EXPECT_EQ(io::ler_climatologia(caminho, impressao, 2).anos().begin()->first, 2005);
+
+    // Outro modo de análise, ou parâmetros que só ele lê, mudam a impressão
+    io::ModoClimatologia gdd;
+    gdd.modo = "gdd";
+    EXPECT_THROW(io::ler_climatologia(caminho, io::impressao_climatologia(fases, gdd)), std::runtime_error);
+    io::ModoClimatologia imputacao;
+    imputacao.imputacoes = 5;
+    EXPECT_NE(io::impressao_climatologia(fases, imputacao), impressao);
+    auto fases_gdd = fases;
+    fases_gdd[0].gddAlvo = 120.0;
+    EXPECT_NE(io::impressao_climatologia(fases_gdd, gdd), io::impressao_climatologia(fases, gdd));
+    EXPECT_EQ(io::impressao_climatologia(fases_gdd, {}), impressao);   // o diário não lê o alvo GDD
+
+    // Fases editadas mudam a impressão: o histórico de outro modelo é recusado
+    fases[0].maxT += 0.5;
+    EXPECT_THROW(io::ler_climatologia(caminho, io::impressao_climatologia(fases, {})), std::runtime_error);
+    std::filesystem::resize_file(caminho, 100);
+    EXPECT_THROW(io::ler_climatologia(caminho, impressao), std::runtime_error);
+    std::remove(caminho.c_str());
+    EXPECT_THROW(summary::ClimatologiaMovel(0), std::invalid_argument);
+}
+
+TEST(PoolTrabalhoTest, CadaIndiceUmaVezAninhadoEExcecao) {
+    viab::PoolTrabalho pool({4, viab::Afinidade::Compacta});
+    EXPECT_EQ(pool.threads(), 4);
+    for (int rodada = 0; rodada < 50; ++rodada) {   // reuso das mesmas threads
+        std::vector<std::atomic<int>> vistos(97);
+        pool.para_cada(vistos.size(), [&](size_t i) {
+            ++vistos[i];
+            pool.para_cada(3, [&](size_t) {});   // aninhado: roda em série, sem travar
+        });
+        for (auto& v : vistos) ASSERT_EQ(v, 1);
+    }
+    EXPECT_THROW(pool.para_cada(10, [](size_t i) {
+        if (i == 7) throw std::runtime_error("falha no corpo");
+    }), std::runtime_error);
+    int depois = 0;
+    pool.para_cada(1, [&](size_t) { ++depois; });
+    EXPECT_EQ(depois, 1);
+    EXPECT_EQ(viab::afinidade_de_texto("espalhada"), viab::Afinidade::Espalhada);
+    EXPECT_THROW(viab::afinidade_de_texto("solta"), std::invalid_argument);
+}
+
+TEST(PoolTrabalhoTest, ResultadosIndependemDoPool) {
+    auto dias = serie_com_bloco_quente();
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    viab::configurar_pool({1, viab::Afinidade::Nenhuma});
+    auto serial = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla);
+    auto generico_serial = viab::rodar_analise(dias, fases);
+    viab::configurar_pool({3, viab::Afinidade::Espalhada});
+    EXPECT_EQ(viab::pool_trabalho().threads(), 3);
+    for (int rodada = 0; rodada < 3; ++rodada) {
+        auto paralelo = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla);
+        auto generico = viab::rodar_analise(dias, fases);
+        for (size_t d = 0; d < dias.size(); ++d) {
+            EXPECT_EQ(paralelo[d].caminhos_viaveis, serial[d].caminhos_viaveis) << "dia " << d;
+            EXPECT_EQ(paralelo[d].rendimento_medio, serial[d].rendimento_medio) << "dia " << d;
+            EXPECT_EQ(generico[d].caminhos_viaveis, generico_serial[d].caminhos_viaveis) << "dia " << d;
+        }
+    }
+    viab::configurar_pool({});
+
+    cli::Opcoes op = cli::interpretar_argumentos({"in.csv", "out", "--threads", "2", "--afinidade=compacta"});
+    EXPECT_EQ(op.threads, 2);
+    EXPECT_EQ(op.afinidade, "compacta");
+    EXPECT_THROW(cli::interpretar_argumentos({"in.csv", "out", "--threads", "0"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"in.csv", "out", "--afinidade", "solta"}), std::invalid_argument);
+    EXPECT_EQ(rg_configurar_threads(2, RG_AFINIDADE_COMPACTA), RG_OK);
+    EXPECT_EQ(rg_configurar_threads(2, 7), RG_ERRO_ARGUMENTO);
+    viab::configurar_pool({});
+}
+
+TEST(VerificacaoTest, ReferenciaExataConcordaEDetectaDesvio) {
+    auto dias = serie_com_bloco_quente();
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto producao = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla);
+
+    viab::ConfiguracaoVerificacao cfg;
+    cfg.dias = 12;
+    cfg.semente = 3;
+    auto verificacao = viab::verificar_resultados(dias, fases, producao, cfg);
+    ASSERT_EQ(verificacao.size(), 12u);
+    int viaveis = 0;
+    for (auto& v : verificacao) {
+        EXPECT_TRUE(v.exata);
+        EXPECT_EQ(v.avaliados, 48);
+        EXPECT_EQ(v.campos.size(), 7u);   // todos os campos, caminhos_viaveis incluído
+        viaveis += producao[v.dia].prob_viabilidade > 0.0;
+    }
+    EXPECT_GE(viaveis, 6);
+    EXPECT_EQ(viab::contar_discordancias(verificacao), 0);
+
+    // Um rendimento errado num dia sorteado é apontado
+    const int d = verificacao[0].dia;
+    producao[d].rendimento_medio += 1e-6;
+    producao[d].caminhos_viaveis += 1;
+    EXPECT_EQ(viab::contar_discordancias(viab::verificar_resultados(dias, fases, producao, cfg)), 2);
+
+    // Durações ponderadas: a DP por término confere com a enumeração ponderada
+    for (auto& f : fases) f.pesos = viab::pesos_triangulares(f, f.durMax);
+    EXPECT_EQ(viab::contar_discordancias(
+        viab::verificar_resultados(dias, fases, viab::rodar_analise(dias, fases), cfg)), 0);
+    EXPECT_THROW(viab::verificar_resultados(dias, fases, {}, cfg), std::invalid_argument);
+}
+
+TEST(VerificacaoTest, DiasIdeaisTemRendimentoUmEAmostragemConcordaEstatisticamente) {
+    // Todos os dias ideais: rendimento 1.0 sem penalidade em qualquer caminho
+    std::vector<viab::Dia> ideais;
+    for (int i = 0; i < 30; ++i) ideais.push_back({"Dia " + std::to_string(i), 1, 25.0, 24.0});
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto ref = viab::referencia_dia(ideais, fases, 0, 1000, 0, 0);
+    EXPECT_NEAR(ref.resultado.prob_viabilidade, 1.0, 1e-12);
+    EXPECT_EQ(ref.resultado.rendimento_medio, 1.0);
+    EXPECT_NEAR(ref.resultado.prob_optimo, 1.0, 1e-12);
+
+    // Referência amostrada contra produção exata: concordância em erros padrão
+    auto dias = serie_com_bloco_quente();
+    auto producao = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla);
+    viab::ConfiguracaoVerificacao cfg;
+    cfg.dias = 10;
+    cfg.semente = 11;
+    cfg.limite_exato = 10;
+    cfg.amostras = 20000;
+    auto verificacao = viab::verificar_resultados(dias, fases, producao, cfg);
+    ASSERT_EQ(verificacao.size(), 10u);
+    for (auto& v : verificacao) {
+        EXPECT_FALSE(v.exata);
+        for (auto& c : v.campos) EXPECT_NE(c.campo, "caminhos_viaveis");
+    }
+    EXPECT_EQ(viab::contar_discordancias(verificacao), 0);
+
+    // Viabilidade deslocada muito além do erro amostral
+    for (auto& v : verificacao)
+        if (producao[v.dia].prob_viabilidade > 0.2) producao[v.dia].prob_viabilidade -= 0.2;
+    EXPECT_GT(viab::contar_discordancias(viab::verificar_resultados(dias, fases, producao, cfg)), 0);
+
+    cli::Opcoes op = cli::interpretar_argumentos({"in.csv", "out", "--verify=5"});
+    EXPECT_EQ(op.verificar, 5);
+    EXPECT_THROW(cli::interpretar_argumentos({"in.csv", "out", "--verify", "2", "--melhores", "3"}),
+                 std::invalid_argument);
+}
+
+TEST(VerificacaoTest, EventoRaroAmostradoComoZeroConcorda) {
+    auto dias = serie_com_bloco_quente();
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+    auto producao = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla);
+    int raro = -1, comum = -1;
+    for (int d = 0; d < static_cast<int>(producao.size()); ++d) {
+        const double p = producao[d].prob_viabilidade;
+        if (p > 0.0 && (raro < 0 || p < producao[raro].prob_viabilidade)) raro = d;
+        if (p >= 0.5) comum = d;
+    }
+    ASSERT_GE(raro, 0);
+    ASSERT_GE(comum, 0);
+
+    // Produção amostrada que não viu o evento raro: |0 - p| cabe em z erros padrão de p
+    viab::ConfiguracaoVerificacao cfg;
+    cfg.dias = static_cast<int>(dias.size());
+    cfg.producao_amostrada = true;
+    cfg.amostras_producao = static_cast<long long>(8.0 / producao[raro].prob_viabilidade);
+    viab::ResultadoData zero;
+    zero.data_str = producao[raro].data_str;
+    zero.total_caminhos = producao[raro].total_caminhos;
+    producao[raro] = zero;
+    auto verificacao = viab::verificar_resultados(dias, fases, producao, cfg);
+    EXPECT_EQ(viab::contar_discordancias(verificacao), 0);
+    for (auto& v : verificacao) {
+        if (v.dia == raro) {
+            EXPECT_GT(v.campos[0].erro_padrao, 0.0);
+        }
+    }
+
+    // Um evento comum ausente na produção continua apontado
+    zero.data_str = producao[comum].data_str;
+    zero.total_caminhos = producao[comum].total_caminhos;
+    producao[comum] = zero;
+    EXPECT_GT(viab::contar_discordancias(viab::verificar_resultados(dias, fases, producao, cfg)), 0);
+}
+
+TEST(GraficosTest, MediaMovelDesbasteEFaixas) {
+    // Três anos de resultados sintéticos e uma linha sem data (ignorada)
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<viab::ResultadoData> resultados;
+    for (summary::Data d{2001, 1, 1}; d.ano <= 2003; d = summary::dia_seguinte(d)) {
+        viab::ResultadoData r;
+        r.data_str = summary::formatar_data(d);
+        r.prob_viabilidade = u(rng);
+        r.rendimento_medio = u(rng);
+        resultados.push_back(r);
+    }
+    const size_t n = resultados.size();
+    resultados.push_back({});
+
+    auto series = summary::gerar_series_grafico(resultados);
+    // 1095 dias: passo 2, no máximo PONTOS_MAX_GRAFICO pontos
+    ASSERT_EQ(series.evolucao.size(), (n + 1) / 2);
+    EXPECT_LE(series.evolucao.size(), static_cast<size_t>(summary::PONTOS_MAX_GRAFICO));
+    for (size_t j = 0; j < series.evolucao.size(); ++j) {
+        const int i = static_cast<int>(2 * j);
+        // Mesma janela de rolling(30, center=True, min_periods=1)
+        const int a = std::max(0, i - 15), b = std::min(static_cast<int>(n), i + 15);
+        double soma = 0.0;
+        for (int k = a; k < b; ++k) soma += resultados[k].prob_viabilidade;
+        const auto& p = series.evolucao[j];
+        EXPECT_EQ(summary::formatar_data(p.data), resultados[i].data_str);
+        EXPECT_NEAR(p.media[0], soma / (b - a), 1e-9);
+        EXPECT_LT(p.inferior[0], p.media[0]);
+        EXPECT_GT(p.superior[0], p.media[0]);
+    }
+    // Barras mensais: três anos de janeiro
+    EXPECT_EQ(series.mensal[0][0].n, 93);
+    EXPECT_EQ(series.mensal[1][1].n, 84);
+
+    // Dispersão entre realizações alarga a faixa
+    std::vector<viab::ResultadoEnsemble> ensemble(resultados.size());
+    for (auto& e : ensemble) e.desvio[0] = 0.3;
+    auto com_ensemble = summary::gerar_series_grafico(resultados, ensemble);
+    EXPECT_NEAR(com_ensemble.evolucao[100].media[0], series.evolucao[100].media[0], 1e-12);
+    EXPECT_LT(com_ensemble.evolucao[100].inferior[0], series.evolucao[100].inferior[0]);
+    EXPECT_EQ(com_ensemble.evolucao[100].inferior[1], series.evolucao[100].inferior[1]);
+    ensemble.pop_back();
+    EXPECT_THROW(summary::gerar_series_grafico(resultados, ensemble), std::invalid_argument);
+
+    const std::string mensal = summary::gerar_csv_grafico_mensal(series);
+    EXPECT_EQ(mensal.rfind("Mês,dias,probabilidade_viabilidade_media,", 0), 0u);
+    EXPECT_EQ(std::count(mensal.begin(), mensal.end(), '\n'), 13);
+    const std::string evolucao = summary::gerar_csv_grafico_evolucao(series);
+    EXPECT_EQ(static_cast<size_t>(std::count(evolucao.begin(), evolucao.end(), '\n')), series.evolucao.size() + 1);
+
+    EXPECT_TRUE(cli::interpretar_argumentos({"in.csv", "out", "--sem-detalhado"}).sem_detalhado);
+}
+
+TEST(CalibracaoTest, GradeDeCoeficientesIgualAReenumeracao) {
+    // Série sem rendimento zero nos coeficientes padrão
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> dist_max(26.0, 33.0);
+    std::uniform_real_distribution<double> dist_min(20.0, 25.0);
+    std::vector<viab::Dia> dias;
+    for (int i = 0; i < 60; ++i) dias.push_back({"Dia " + std::to_string(i), 1, dist_max(rng), dist_min(rng)});
+    auto fases = viab::fases_do_catalogo<CatalogoTeste>();
+
+    viab::EstatisticasPenalidade est;
+    auto resultados = viab::rodar_analise_estatisticas(dias, fases, est);
+    auto tabelas = viab::rodar_analise_tabelas(dias, fases, viab::Precisao::Dupla);
+    ASSERT_EQ(resultados.size(), tabelas.size());
+    ASSERT_EQ(est.dias.size(), dias.size());
+    int com_viavel = 0;
+    for (size_t d = 0; d < dias.size(); ++d) {
+        EXPECT_EQ(resultados[d].data_str, tabelas[d].data_str);
+        EXPECT_EQ(resultados[d].caminhos_viaveis, tabelas[d].caminhos_viaveis);
+        EXPECT_EQ(resultados[d].prob_optimo, tabelas[d].prob_optimo);
+        EXPECT_NEAR(resultados[d].rendimento_medio, tabelas[d].rendimento_medio, 1e-12);
+        // Coeficientes padrão: o histograma reproduz o rendimento
+        EXPECT_NEAR(viab::rendimento_calibrado(est, est.dias[d], viab::AnalysisConfig::PENAL_DIURNA,
+                                               viab::AnalysisConfig::PENAL_NOTURNA),
+                    tabelas[d].rendimento_medio, 1e-9);
+        com_viavel += est.dias[d].viaveis > 0;
+    }
+    ASSERT_GT(com_viavel, 0);
+
+    // Reenumeração direta com outros coeficientes: Ed = pd / PENAL_DIURNA, En = pn / PENAL_NOTURNA
+    auto rendimento_direto = [&](int d, double a, double b) {
+        std::vector<int> comb(fases.size());
+        double soma = 0.0;
+        long long viaveis = 0;
+        for (long long idx = 0; idx < 48; ++idx) {
+            viab::gerar_combinacao_por_indice(comb, fases, idx);
+            double pd, pn;
+            bool esb, red, ideal;
+            if (!viab::avaliar_sequencia(dias, d, fases, comb, viab::AnalysisConfig(), pd, pn, esb, red, ideal))
+                continue;
+            ++viaveis;
+            soma += std::max(0.0, 1.0 - (a * pd / viab::AnalysisConfig::PENAL_DIURNA +
+                                         b * pn / viab::AnalysisConfig::PENAL_NOTURNA));
+        }
+        return viaveis ? soma / viaveis : 0.0;
+    };
+    auto grade = viab::calibrar_penalidades(est, {0.03, 0.5}, {0.05, 0.1, 0.4});
+    ASSERT_EQ(grade.size(), 6u);
+    EXPECT_EQ(grade[0].penal_diurna, 0.03);
+    EXPECT_EQ(grade[2].penal_noturna, 0.4);
+    EXPECT_EQ(grade[0].celulas_aproximadas, 0);
+    EXPECT_GT(grade[5].celulas_aproximadas, 0);
+    for (const auto& g : grade) {
+        double media = 0.0;
+        for (size_t d = 0; d < dias.size(); ++d)
+            if (est.dias[d].viaveis > 0) media += rendimento_direto(static_cast<int>(d), g.penal_diurna, g.penal_noturna);
+        media /= com_viavel;
+        // Exato sem células aproximadas; senão, média da célula no lugar dos caminhos
+        EXPECT_NEAR(g.rendimento_medio, media, g.celulas_aproximadas ? 0.02 : 1e-9);
+    }
+    EXPECT_THROW(viab::calibrar_penalidades(est, {-0.1}, {0.1}), std::invalid_argument);
+
+    // Ida e volta pelo arquivo
+    const auto caminho = (std::filesystem::temp_directory_path() / "rg_estatisticas_teste.bin").string();
+    model::io::gravar_estatisticas(caminho, est);
+    const auto lida = model::io::ler_estatisticas(caminho);
+    std::remove(caminho.c_str());
+    ASSERT_EQ(lida.dias.size(), est.dias.size());
+    EXPECT_EQ(lida.max_excesso_noite, est.max_excesso_noite);
+    const auto de_novo = viab::calibrar_penalidades(lida, {0.03, 0.5}, {0.05, 0.1, 0.4});
+    for (size_t k = 0; k < grade.size(); ++k) EXPECT_EQ(de_novo[k].rendimento_medio, grade[k].rendimento_medio);
+
+    cli::Opcoes op = cli::interpretar_argumentos({"calibrar", "out", "est.bin", "--penal-diurna", "0.02:0.1:0.02",
+                                                  "--penal-noturna=0.1,0.2"});
+    EXPECT_TRUE(op.calibrar);
+    EXPECT_EQ(op.estatisticas, "est.bin");
+    EXPECT_EQ(op.penal_diurna.size(), 5u);
+    EXPECT_EQ(op.penal_noturna.size(), 2u);
+    EXPECT_THROW(cli::interpretar_argumentos({"in.csv", "out", "--penal-diurna", "0.1"}), std::invalid_argument);
+    EXPECT_THROW(cli::interpretar_argumentos({"in.csv", "out", "--estatisticas", "e.bin", "--modo", "gdd"}),
+                 std::invalid_argument);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -4,25 +4,29 @@ import matplotlib.pyplot as plt
 import sys
 import os
 
-def gerar_relatorios(resumo_path, detalhe_path, output_dir):
+def gerar_relatorios(processados_dir, output_dir):
     """
-    Lê os arquivos CSV gerados pelo C++ e cria gráficos.
+    Lê as séries de gráfico pré-agregadas pelo C++ (grafico_mensal.csv e
+    grafico_evolucao.csv, poucos kilobytes) e cria os gráficos.
+    O analise_detalhada.csv não é lido.
     """
     print("Iniciando pós-processamento e geração de relatórios...")
     # Criar pasta de relatórios
     os.makedirs(output_dir, exist_ok=True)
     print(f"Diretório de relatórios '{output_dir}' assegurado.")
 
+    mensal_path = os.path.join(processados_dir, 'grafico_mensal.csv')
+    evolucao_path = os.path.join(processados_dir, 'grafico_evolucao.csv')
+
     # --- Leitura dos Arquivos ---
     try:
-        # Ler resumo mensal (gerado pelo C++)
-        resumo = pd.read_csv(resumo_path, decimal='.') # C++ usa '.' como decimal
-        print(f"Arquivo de resumo lido: {resumo_path}")
-        # Ler análise detalhada (opcional para alguns gráficos, mas bom ter)
-        detalhe = pd.read_csv(detalhe_path, decimal='.') # C++ usa '.' como decimal
-        detalhe['Data'] = pd.to_datetime(detalhe['Data'], format='%d/%m/%Y')
-        detalhe['Mês'] = detalhe['Data'].dt.month
-        print(f"Arquivo detalhado lido: {detalhe_path}")
+        # Médias e faixas de 95% por mês de plantio (gerado pelo C++)
+        mensal = pd.read_csv(mensal_path, decimal='.') # C++ usa '.' como decimal
+        print(f"Arquivo mensal lido: {mensal_path}")
+        # Média móvel de 30 dias já desbastada, com faixa de 95%
+        evolucao = pd.read_csv(evolucao_path, decimal='.')
+        evolucao['Data'] = pd.to_datetime(evolucao['Data'], format='%d/%m/%Y')
+        print(f"Arquivo de evolução lido: {evolucao_path}")
 
     except FileNotFoundError as e:
         print(f"Erro: Arquivo de entrada não encontrado: {e.filename}")
@@ -31,19 +35,35 @@ def gerar_relatorios(resumo_path, detalhe_path, output_dir):
         print(f"Erro ao ler os arquivos CSV de resultados: {e}")
         sys.exit(1)
 
-    # Validar colunas esperadas no resumo
-    expected_resumo_cols = [
-        'Mês', 'probabilidade_viabilidade_media', 'rendimento_medio',
-        'prob_esbranquiamento_media', 'prob_reducao_moagem_media'
-    ]
-    missing_resumo_cols = [col for col in expected_resumo_cols if col not in resumo.columns]
-    if missing_resumo_cols:
-        print(f"Erro: Colunas faltando no arquivo de resumo '{resumo_path}': {missing_resumo_cols}")
-        print(f"Colunas encontradas: {resumo.columns.tolist()}")
+    gerar_graficos(mensal, evolucao, output_dir)
+
+
+def gerar_graficos(mensal, evolucao, output_dir):
+    """
+    Cria os gráficos a partir das séries já agregadas (DataFrames com as colunas
+    de grafico_mensal.csv e grafico_evolucao.csv, 'Data' como datetime), lidas
+    dos CSVs ou devolvidas em memória por helpers.riceguard.analisar.
+    """
+    os.makedirs(output_dir, exist_ok=True)
+
+    # Validar colunas esperadas
+    metricas_mensais = ['probabilidade_viabilidade', 'rendimento_medio',
+                        'prob_esbranquiamento', 'prob_reducao_moagem']
+    expected_mensal_cols = ['Mês'] + [f'{m}_{s}' for m in metricas_mensais
+                                      for s in ('media', 'inferior', 'superior')]
+    missing_mensal_cols = [col for col in expected_mensal_cols if col not in mensal.columns]
+    if missing_mensal_cols:
+        print(f"Erro: Colunas faltando nas séries mensais: {missing_mensal_cols}")
+        print(f"Colunas encontradas: {mensal.columns.tolist()}")
         sys.exit(1)
 
-    # Ordenar resumo por mês para os gráficos ficarem corretos
-    resumo = resumo.sort_values(by='Mês').reset_index(drop=True)
+    # Ordenar por mês para os gráficos ficarem corretos
+    mensal = mensal.sort_values(by='Mês').reset_index(drop=True)
+
+    def barras_erro(metrica):
+        """Distâncias da média às bordas da faixa, no formato de yerr."""
+        media = mensal[f'{metrica}_media']
+        return [media - mensal[f'{metrica}_inferior'], mensal[f'{metrica}_superior'] - media]
 
     # --- Geração de Gráficos ---
     print("Gerando gráficos...")
@@ -52,11 +72,12 @@ def gerar_relatorios(resumo_path, detalhe_path, output_dir):
     try:
         # Gráfico de Viabilidade Média
         plt.figure(figsize=(10, 6))
-        plt.bar(resumo['Mês'], resumo['probabilidade_viabilidade_media'], color='skyblue')
+        plt.bar(mensal['Mês'], mensal['probabilidade_viabilidade_media'], color='skyblue',
+                yerr=barras_erro('probabilidade_viabilidade'), capsize=4)
         plt.title('Probabilidade Média de Viabilidade por Mês de Plantio')
         plt.xlabel('Mês de Plantio')
-        plt.ylabel('Probabilidade Média')
-        plt.xticks(resumo['Mês']) # Garante que todos os meses presentes sejam mostrados
+        plt.ylabel('Probabilidade Média (faixa de 95%)')
+        plt.xticks(mensal['Mês']) # Garante que todos os meses presentes sejam mostrados
         plt.ylim(0, 1) # Probabilidade vai de 0 a 1
         plt.tight_layout()
         plot_path = os.path.join(output_dir, 'viabilidade_mensal.png')
@@ -66,11 +87,12 @@ def gerar_relatorios(resumo_path, detalhe_path, output_dir):
 
         # Gráfico de Rendimento Médio
         plt.figure(figsize=(10, 6))
-        plt.bar(resumo['Mês'], resumo['rendimento_medio'], color='lightcoral')
+        plt.bar(mensal['Mês'], mensal['rendimento_medio_media'], color='lightcoral',
+                yerr=barras_erro('rendimento_medio'), capsize=4)
         plt.title('Rendimento Médio Esperado por Mês de Plantio')
         plt.xlabel('Mês de Plantio')
         plt.ylabel('Fator de Rendimento Médio (0-1)')
-        plt.xticks(resumo['Mês'])
+        plt.xticks(mensal['Mês'])
         plt.ylim(0, 1) # Rendimento relativo vai de 0 a 1
         plt.tight_layout()
         plot_path = os.path.join(output_dir, 'rendimento_mensal.png')
@@ -80,14 +102,17 @@ def gerar_relatorios(resumo_path, detalhe_path, output_dir):
 
         # Gráfico de Riscos Médios
         plt.figure(figsize=(10, 6))
-        plt.plot(resumo['Mês'], resumo['prob_esbranquiamento_media'],
-                 marker='o', linestyle='-', color='darkorange', label='Esbranquiamento (Tmax > 30°C)')
-        plt.plot(resumo['Mês'], resumo['prob_reducao_moagem_media'],
-                 marker='s', linestyle='--', color='darkviolet', label='Redução Moagem (Tmin > 27°C)')
+        riscos = [('prob_esbranquiamento', 'o', '-', 'darkorange', 'Esbranquiamento (Tmax > 30°C)'),
+                  ('prob_reducao_moagem', 's', '--', 'darkviolet', 'Redução Moagem (Tmin > 27°C)')]
+        for metrica, marker, linestyle, color, label in riscos:
+            plt.plot(mensal['Mês'], mensal[f'{metrica}_media'],
+                     marker=marker, linestyle=linestyle, color=color, label=label)
+            plt.fill_between(mensal['Mês'], mensal[f'{metrica}_inferior'], mensal[f'{metrica}_superior'],
+                             color=color, alpha=0.15)
         plt.title('Probabilidade Média de Riscos de Qualidade por Mês de Plantio')
         plt.xlabel('Mês de Plantio')
         plt.ylabel('Probabilidade Média')
-        plt.xticks(resumo['Mês'])
+        plt.xticks(mensal['Mês'])
         plt.ylim(0, 1) # Probabilidade vai de 0 a 1
         plt.legend(title="Risco Associado")
         plt.grid(True, which='both', linestyle='--', linewidth=0.5)
@@ -97,15 +122,16 @@ def gerar_relatorios(resumo_path, detalhe_path, output_dir):
         plt.close()
         print(f"Gráfico salvo: {plot_path}")
 
-        # (Opcional) Gráfico da evolução diária da viabilidade (usando 'detalhe')
+        # Gráfico da evolução diária da viabilidade (média móvel calculada no C++)
         plt.figure(figsize=(14, 7))
-        plt.plot(detalhe['Data'], detalhe['probabilidade_viabilidade'],
-                 label='Prob. Viabilidade Diária', color='green', alpha=0.7)
-        # Adicionar média móvel para suavizar
-        detalhe['viab_media_movel_30d'] = detalhe['probabilidade_viabilidade'].rolling(window=30, center=True, min_periods=1).mean()
-        plt.plot(detalhe['Data'], detalhe['viab_media_movel_30d'],
+        plt.fill_between(evolucao['Data'], evolucao['probabilidade_viabilidade_inferior'],
+                         evolucao['probabilidade_viabilidade_superior'],
+                         color='green', alpha=0.2, label='Faixa de 95%')
+        plt.plot(evolucao['Data'], evolucao['probabilidade_viabilidade_media_movel'],
                  label='Média Móvel 30d', color='darkgreen', linewidth=2)
-        plt.title('Probabilidade de Viabilidade Diária e Média Móvel (30 dias)')
+        plt.plot(evolucao['Data'], evolucao['rendimento_medio_media_movel'],
+                 label='Rendimento (Média Móvel 30d)', color='firebrick', linestyle='--')
+        plt.title('Probabilidade de Viabilidade Diária: Média Móvel (30 dias)')
         plt.xlabel('Data de Plantio')
         plt.ylabel('Probabilidade')
         plt.ylim(0, 1)
@@ -132,23 +158,18 @@ if __name__ == '__main__':
     script_dir = os.path.dirname(__file__)
     project_root = os.path.dirname(script_dir)
 
-    default_resumo = os.path.join(project_root, 'processados', 'resumo_mensal.csv')
-    default_detalhe = os.path.join(project_root, 'processados', 'analise_detalhada.csv')
+    default_processados = os.path.join(project_root, 'processados')
     default_output_dir = os.path.join(project_root, 'relatorios')
 
-    resumo_file = sys.argv[1] if len(sys.argv) > 1 else default_resumo
-    detalhe_file = sys.argv[2] if len(sys.argv) > 2 else default_detalhe
-    output_directory = sys.argv[3] if len(sys.argv) > 3 else default_output_dir
+    processados_dir = sys.argv[1] if len(sys.argv) > 1 else default_processados
+    output_directory = sys.argv[2] if len(sys.argv) > 2 else default_output_dir
     # --- Fim Configuração ---
 
-    if not os.path.exists(resumo_file):
-         print(f"Erro: Arquivo de resumo '{resumo_file}' não encontrado.")
-         print("Uso: python helpers/posprocessamento.py [resumo.csv] [detalhe.csv] [diretorio_relatorios]")
-         sys.exit(1)
-    if not os.path.exists(detalhe_file):
-        print(f"Erro: Arquivo detalhado '{detalhe_file}' não encontrado.")
-        print("Uso: python helpers/posprocessamento.py [resumo.csv] [detalhe.csv] [diretorio_relatorios]")
-        sys.exit(1)
+    for nome in ('grafico_mensal.csv', 'grafico_evolucao.csv'):
+        if not os.path.exists(os.path.join(processados_dir, nome)):
+            print(f"Erro: Arquivo '{nome}' não encontrado em '{processados_dir}'.")
+            print("Uso: python helpers/posprocessamento.py [pasta_processados] [diretorio_relatorios]")
+            sys.exit(1)
 
-    gerar_relatorios(resumo_file, detalhe_file, output_directory)
+    gerar_relatorios(processados_dir, output_directory)
     print("Pós-processamento concluído.")
\ No newline at end of file
@@ -85,21 +85,34 @@ def preprocessar_dados(input_csv, output_csv, estrategia, fases_json=None):
     elif estrategia == 'ideal':
         fases = carregar_fases(fases_json)
         df['temperatura'] = imputar_ideal(df[temp_col], fases)
+    elif estrategia == 'lacunas':
+        # Sem imputação: o executável `analise --imputacoes N` preenche as lacunas
+        df['temperatura'] = df[temp_col]
     else:
         sys.exit(f"Estratégia inválida: {estrategia}")
 
-    df.dropna(subset=['temperatura'], inplace=True)
-    print("Imputação concluída, NaNs restantes removidos.")
+    if estrategia != 'lacunas':
+        df.dropna(subset=['temperatura'], inplace=True)
+        print("Imputação concluída, NaNs restantes removidos.")
 
     # Agregação diária
     df['date_only'] = df['datetime'].dt.date
-    diario = df.groupby('date_only')['temperatura'].agg(Tmax='max', Tmin='min').reset_index()
-    diario.dropna(inplace=True)
-    print(f"Agregados {len(diario)} dias válidos.")
+    diario = df.groupby('date_only')['temperatura'].agg(Tmax='max', Tmin='min', Leituras='count').reset_index()
+    colunas = ['Data', 'Tmax', 'Tmin']
+    if estrategia == 'lacunas':
+        # Dias sem nenhuma leitura ficam com Tmax/Tmin vazios; Ausentes = leituras horárias faltantes
+        calendario = pd.date_range(diario['date_only'].min(), diario['date_only'].max(), freq='D').date
+        diario = diario.set_index('date_only').reindex(calendario).rename_axis('date_only').reset_index()
+        diario['Ausentes'] = (24 - diario['Leituras'].fillna(0)).clip(lower=0).astype(int)
+        colunas.append('Ausentes')
+        print(f"Agregados {len(diario)} dias, {int((diario['Ausentes'] > 0).sum())} com lacuna.")
+    else:
+        diario.dropna(inplace=True)
+        print(f"Agregados {len(diario)} dias válidos.")
 
     # Salvamento
     diario['Data'] = pd.to_datetime(diario['date_only']).dt.strftime('%d/%m/%Y')
-    diario[['Data', 'Tmax', 'Tmin']].to_csv(
+    diario[colunas].to_csv(
         output_csv, index=False, sep=';', decimal='.', float_format='%.1f'
     )
     print(f"Dados salvos em {output_csv} usando '{estrategia}'")
@@ -111,7 +124,7 @@ if __name__ == '__main__':
     parser.add_argument('input_csv', nargs='?', help='Arquivo CSV horário')
     parser.add_argument('output_csv', nargs='?', help='Arquivo CSV diário de saída')
     parser.add_argument('-e', '--estrategia',
-                        choices=['interpolacao', 'vizinho', 'randomica', 'randômica', 'ideal'],
+                        choices=['interpolacao', 'vizinho', 'randomica', 'randômica', 'ideal', 'lacunas'],
                         help='Estratégia de imputação')
     parser.add_argument('-f', '--fases', default=DEFAULT_FASES_JSON,
                         help='JSON de fases (para randômica/ideal)')
@@ -120,8 +133,8 @@ if __name__ == '__main__':
     # Se não passou args, entra no modo interativo (fluxo manual)
     if not args.input_csv or not args.output_csv or not args.estrategia:
         print("=== Preprocessamento Interativo ===")
-        sel = input("Escolha 1) interpolacao 2) vizinho 3) randomica 4) ideal: ")
-        opts = {'1':'interpolacao','2':'vizinho','3':'randomica','4':'ideal'}
+        sel = input("Escolha 1) interpolacao 2) vizinho 3) randomica 4) ideal 5) lacunas: ")
+        opts = {'1':'interpolacao','2':'vizinho','3':'randomica','4':'ideal','5':'lacunas'}
         est = opts.get(sel)
         if not est:
             sys.exit("Seleção inválida.")
@@ -0,0 +1,191 @@
+# helpers/riceguard.py
+"""
+Acesso em processo à libriceguard (ABI C) via ctypes, sem cópia das séries.
+
+Exemplo:
+    from helpers.riceguard import analisar
+    res = analisar(df['Tmax'].to_numpy(), df['Tmin'].to_numpy(), fases)
+    res, mensal, evolucao = analisar(tmax, tmin, fases, datas=datas)   # + séries dos gráficos
+"""
+import ctypes
+import os
+
+import numpy as np
+import pandas as pd
+
+RG_ABI_VERSAO = 2
+
+_PASTA_BUILD = os.path.join(os.path.dirname(__file__), '..', 'FastCodigo', 'build')
+
+
+class RgFase(ctypes.Structure):
+    _fields_ = [
+        ('nome', ctypes.c_char_p),
+        ('min_t', ctypes.c_double),
+        ('max_t', ctypes.c_double),
+        ('opt_min_t', ctypes.c_double),
+        ('opt_max_t', ctypes.c_double),
+        ('dur_min', ctypes.c_int32),
+        ('dur_max', ctypes.c_int32),
+    ]
+
+
+_P_DOUBLE = ctypes.POINTER(ctypes.c_double)
+_P_INT64 = ctypes.POINTER(ctypes.c_int64)
+
+COLUNAS = [
+    ('prob_viabilidade', np.float64, _P_DOUBLE),
+    ('rendimento_medio', np.float64, _P_DOUBLE),
+    ('prob_esbranquiamento', np.float64, _P_DOUBLE),
+    ('prob_reducao_moagem', np.float64, _P_DOUBLE),
+    ('prob_optimo', np.float64, _P_DOUBLE),
+    ('total_caminhos', np.int64, _P_INT64),
+    ('caminhos_viaveis', np.int64, _P_INT64),
+]
+
+
+class RgResultados(ctypes.Structure):
+    _fields_ = [(nome, tipo) for nome, _, tipo in COLUNAS]
+
+
+# Métricas das séries de gráfico, na ordem de COLUNAS (e dos grafico_*.csv)
+METRICAS = [nome for nome, _, _ in COLUNAS[:5]]
+RG_PONTOS_MAX_GRAFICO = 730
+
+
+class RgMesGrafico(ctypes.Structure):
+    _fields_ = [
+        ('dias', ctypes.c_int32),
+        ('media', ctypes.c_double * 5),
+        ('inferior', ctypes.c_double * 5),
+        ('superior', ctypes.c_double * 5),
+    ]
+
+
+class RgPontoEvolucao(ctypes.Structure):
+    _fields_ = [
+        ('data', ctypes.c_int32),
+        ('media', ctypes.c_double * 2),
+        ('inferior', ctypes.c_double * 2),
+        ('superior', ctypes.c_double * 2),
+    ]
+
+
+class RgGraficos(ctypes.Structure):
+    _fields_ = [
+        ('mensal', RgMesGrafico * 12),
+        ('evolucao', RgPontoEvolucao * RG_PONTOS_MAX_GRAFICO),
+        ('num_pontos', ctypes.c_int32),
+    ]
+
+
+def carregar_biblioteca(caminho=None):
+    """Carrega a libriceguard e confere a versão da ABI."""
+    caminho = caminho or os.environ.get('RICEGUARD_LIB') or os.path.join(_PASTA_BUILD, 'libriceguard.so')
+    lib = ctypes.CDLL(caminho)
+    lib.rg_versao_abi.restype = ctypes.c_int32
+    lib.rg_ultimo_erro.restype = ctypes.c_char_p
+    lib.rg_analisar.restype = ctypes.c_int32
+    lib.rg_analisar.argtypes = [
+        _P_DOUBLE, _P_DOUBLE, ctypes.c_int64, ctypes.POINTER(RgFase), ctypes.c_int32, ctypes.c_uint64,
+        ctypes.POINTER(RgResultados), ctypes.POINTER(ctypes.c_int32), ctypes.POINTER(RgGraficos),
+    ]
+    lib.rg_configurar_threads.restype = ctypes.c_int32
+    lib.rg_configurar_threads.argtypes = [ctypes.c_int32, ctypes.c_int32]
+    if lib.rg_versao_abi() != RG_ABI_VERSAO:
+        raise RuntimeError(f"Versão de ABI incompatível: {lib.rg_versao_abi()} (esperada {RG_ABI_VERSAO})")
+    return lib
+
+
+_lib = None
+
+AFINIDADES = {'nenhuma': 0, 'compacta': 1, 'espalhada': 2}
+
+
+def configurar_threads(threads=0, afinidade='nenhuma', lib=None):
+    """Recria as threads de trabalho persistentes (threads <= 0 = padrão do OpenMP)."""
+    global _lib
+    if lib is None:
+        _lib = _lib or carregar_biblioteca()
+        lib = _lib
+    if afinidade not in AFINIDADES:
+        raise ValueError(f"Afinidade inválida: {afinidade} (use {', '.join(AFINIDADES)})")
+    codigo = lib.rg_configurar_threads(threads, AFINIDADES[afinidade])
+    if codigo != 0:
+        raise RuntimeError(f"rg_configurar_threads falhou ({codigo}): {lib.rg_ultimo_erro().decode('utf-8')}")
+
+
+def analisar(tmax, tmin, fases, datas=None, semente=0, lib=None):
+    """
+    Executa a análise para cada dia inicial.
+
+    tmax, tmin : arrays float64 contíguos (usados sem cópia quando já estão nesse formato)
+    fases      : lista de dicts com as chaves do JSON de fases
+    datas      : array int32 AAAAMMDD opcional, validado como dias consecutivos
+    Retorna um dict de arrays numpy com as colunas de resultado. Com `datas`,
+    retorna (resultados, mensal, evolucao), os dois últimos como DataFrames com
+    as colunas de grafico_mensal.csv e grafico_evolucao.csv.
+    """
+    global _lib
+    if lib is None:
+        _lib = _lib or carregar_biblioteca()
+        lib = _lib
+
+    tmax = np.ascontiguousarray(tmax, dtype=np.float64)
+    tmin = np.ascontiguousarray(tmin, dtype=np.float64)
+    if tmax.shape != tmin.shape or tmax.ndim != 1:
+        raise ValueError("tmax e tmin devem ser vetores do mesmo tamanho")
+    n = tmax.shape[0]
+
+    p_datas, graficos = None, None
+    if datas is not None:
+        datas = np.ascontiguousarray(datas, dtype=np.int32)
+        if datas.shape != tmax.shape:
+            raise ValueError("datas deve ter o tamanho de tmax")
+        p_datas = datas.ctypes.data_as(ctypes.POINTER(ctypes.c_int32))
+        graficos = RgGraficos()
+
+    nomes = [f['nome'].encode('utf-8') for f in fases]
+    vetor_fases = (RgFase * len(fases))(*[
+        RgFase(nome, f['minT'], f['maxT'], f['optMinT'], f['optMaxT'], f['durMin'], f['durMax'])
+        for nome, f in zip(nomes, fases)
+    ])
+
+    saida = {nome: np.zeros(n, dtype=dtype) for nome, dtype, _ in COLUNAS}
+    resultados = RgResultados(*[saida[nome].ctypes.data_as(tipo) for nome, _, tipo in COLUNAS])
+
+    codigo = lib.rg_analisar(
+        tmax.ctypes.data_as(_P_DOUBLE), tmin.ctypes.data_as(_P_DOUBLE), n,
+        vetor_fases, len(fases), semente, ctypes.byref(resultados),
+        p_datas, ctypes.byref(graficos) if graficos is not None else None)
+    if codigo != 0:
+        raise RuntimeError(f"rg_analisar falhou ({codigo}): {lib.rg_ultimo_erro().decode('utf-8')}")
+    if graficos is None:
+        return saida
+    return saida, _tabela_mensal(graficos), _tabela_evolucao(graficos)
+
+
+def _tabela_mensal(graficos):
+    """Meses com dias avaliados, nas colunas de grafico_mensal.csv."""
+    linhas = []
+    for mes, m in enumerate(graficos.mensal, start=1):
+        if m.dias == 0:
+            continue
+        linha = {'Mês': mes, 'dias': m.dias}
+        for k, metrica in enumerate(METRICAS):
+            linha[f'{metrica}_media'] = m.media[k]
+            linha[f'{metrica}_inferior'] = m.inferior[k]
+            linha[f'{metrica}_superior'] = m.superior[k]
+        linhas.append(linha)
+    return pd.DataFrame(linhas)
+
+
+def _tabela_evolucao(graficos):
+    """Média móvel desbastada, nas colunas de grafico_evolucao.csv (Data já como datetime)."""
+    pontos = graficos.evolucao[:graficos.num_pontos]
+    tabela = {'Data': pd.to_datetime([str(p.data) for p in pontos], format='%Y%m%d')}
+    for k, metrica in enumerate(METRICAS[:2]):
+        tabela[f'{metrica}_media_movel'] = [p.media[k] for p in pontos]
+        tabela[f'{metrica}_inferior'] = [p.inferior[k] for p in pontos]
+        tabela[f'{metrica}_superior'] = [p.superior[k] for p in pontos]
+    return pd.DataFrame(tabela)
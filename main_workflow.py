@@ -2,8 +2,14 @@ import subprocess
 import os
 import sys
 import time
+import json
 import platform
 
+import pandas as pd
+
+# Realizações de imputação do ensemble (estratégia "lacunas")
+REALIZACOES_ENSEMBLE = 20
+
 # Função para executar e validar comandos
 def run_command(command, step_name):
     print(f"\n--- Iniciando Etapa: {step_name} ---")
@@ -21,6 +27,29 @@ def run_command(command, step_name):
         print(f"Erro na etapa '{step_name}': {e}")
         return False
 
+# Análise e gráficos em processo, pela libriceguard (sem CSVs intermediários do C++)
+def run_in_process(preprocessed_csv, fases_json, lib_path, reports_dir):
+    from helpers import riceguard
+    from helpers.posprocessamento import gerar_graficos
+
+    print("\n--- Iniciando Etapa: Análise Principal (libriceguard) ---")
+    start_time = time.time()
+    try:
+        dados = pd.read_csv(preprocessed_csv, sep=';', decimal='.')
+        datas = pd.to_datetime(dados['Data'], format='%d/%m/%Y')
+        with open(fases_json, 'r', encoding='utf-8') as f:
+            fases = json.load(f)['fases']
+        lib = riceguard.carregar_biblioteca(lib_path)
+        _, mensal, evolucao = riceguard.analisar(
+            dados['Tmax'].to_numpy(), dados['Tmin'].to_numpy(), fases,
+            datas=(datas.dt.year * 10000 + datas.dt.month * 100 + datas.dt.day).to_numpy(), lib=lib)
+        print(f"--- Etapa 'Análise Principal (libriceguard)' concluída em {time.time() - start_time:.2f}s ---")
+        gerar_graficos(mensal, evolucao, reports_dir)
+        return True
+    except Exception as e:
+        print(f"Erro na análise em processo: {e}")
+        return False
+
 # Prompt interativo para escolha de estratégia
 def escolher_estrategia():
     print("Escolha a estratégia de imputação para o pré-processamento:")
@@ -28,8 +57,9 @@ def escolher_estrategia():
     print(" 2) vizinho")
     print(" 3) randomica")
     print(" 4) ideal")
-    escolha = input("Digite (1-4): ")
-    mapping = {'1': 'interpolacao', '2': 'vizinho', '3': 'randomica', '4': 'ideal'}
+    print(" 5) ensemble (lacunas preenchidas no C++ em várias realizações)")
+    escolha = input("Digite (1-5): ")
+    mapping = {'1': 'interpolacao', '2': 'vizinho', '3': 'randomica', '4': 'ideal', '5': 'lacunas'}
     estrategia = mapping.get(escolha)
     if not estrategia:
         print("Opção inválida. Encerrando.")
@@ -47,24 +77,30 @@ if __name__ == "__main__":
     core_logic_dir = os.path.join(project_root, 'FastCodigo', 'build')
     executable_name = 'analise.exe' if platform.system() == 'Windows' else 'analise'
     cpp_executable = os.path.join(core_logic_dir, executable_name)
+    library_name = 'riceguard.dll' if platform.system() == 'Windows' else 'libriceguard.so'
+    cpp_library = os.environ.get('RICEGUARD_LIB') or os.path.join(core_logic_dir, library_name)
+    fases_json = os.path.join(project_root, 'FastCodigo', 'src', 'config', 'fases_cultivo_arroz.json')
 
     processed_dir = os.path.join(project_root, 'processados')
-    resumo_csv_cpp = os.path.join(processed_dir, 'resumo_mensal.csv')
-    detalhe_csv_cpp = os.path.join(processed_dir, 'analise_detalhada.csv')
 
     postprocess_script = os.path.join(project_root, 'helpers', 'posprocessamento.py')
     reports_dir = os.path.join(project_root, 'relatorios')
 
-    # Verificações iniciais
-    for path, desc in [(input_csv_original, 'dados original'), (preprocess_script, 'script de pré-processamento'),
-                       (cpp_executable, 'executável C++'), (postprocess_script, 'script de pós-processamento')]:
+    # Etapa 1: Pré-processamento interativo
+    estrategia = escolher_estrategia()
+
+    # Verificações iniciais: o ensemble usa o executável; as demais estratégias, a biblioteca
+    requisitos = [(input_csv_original, 'dados original'), (preprocess_script, 'script de pré-processamento')]
+    if estrategia == 'lacunas':
+        requisitos += [(cpp_executable, 'executável C++'), (postprocess_script, 'script de pós-processamento')]
+    else:
+        requisitos += [(cpp_library, 'biblioteca libriceguard'), (fases_json, 'JSON de fases')]
+    for path, desc in requisitos:
         if not os.path.exists(path):
             print(f"Erro crítico: {desc} não encontrado em {path}")
             sys.exit(1)
 
-    # Etapa 1: Pré-processamento interativo
     os.makedirs(preprocessed_dir, exist_ok=True)
-    estrategia = escolher_estrategia()
     command_preprocess = [sys.executable, preprocess_script,
                           input_csv_original, preprocessed_csv,
                           '--estrategia', estrategia, '--fases',
@@ -72,20 +108,23 @@ if __name__ == "__main__":
     if not run_command(command_preprocess, "Pré-processamento (Python)"):
         sys.exit(1)
 
-    # Etapa 2: Análise Principal (C++)
-    os.makedirs(processed_dir, exist_ok=True)
-    command_cpp = [cpp_executable, preprocessed_csv, processed_dir]
-    if not run_command(command_cpp, "Análise Principal (C++)"):
-        sys.exit(1)
+    # Etapas 2 e 3: análise e gráficos
+    if estrategia == 'lacunas':
+        # Ensemble de imputação: só no executável (--imputacoes), com CSVs em processados/
+        os.makedirs(processed_dir, exist_ok=True)
+        command_cpp = [cpp_executable, preprocessed_csv, processed_dir, '--imputacoes', str(REALIZACOES_ENSEMBLE)]
+        if not run_command(command_cpp, "Análise Principal (C++)"):
+            sys.exit(1)
 
-    # Etapa 3: Pós-processamento (Gráficos)
-    os.makedirs(reports_dir, exist_ok=True)
-    command_post = [sys.executable, postprocess_script,
-                    resumo_csv_cpp, detalhe_csv_cpp, reports_dir]
-    if not run_command(command_post, "Pós-processamento e Relatórios"):
+        os.makedirs(reports_dir, exist_ok=True)
+        command_post = [sys.executable, postprocess_script, processed_dir, reports_dir]
+        if not run_command(command_post, "Pós-processamento e Relatórios"):
+            sys.exit(1)
+    elif not run_in_process(preprocessed_csv, fases_json, cpp_library, reports_dir):
         sys.exit(1)
 
     print("\nWorkflow completo executado com sucesso!")
     print(f"Dados pré-processados: {preprocessed_dir}")
-    print(f"Resultados C++: {processed_dir}")
+    if estrategia == 'lacunas':
+        print(f"Resultados C++: {processed_dir}")
     print(f"Relatórios: {reports_dir}")